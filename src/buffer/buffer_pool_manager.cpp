@@ -155,6 +155,7 @@ bool BufferPoolManager::DeletePageImpl(page_id_t page_id) {
   // 1.   If P does not exist, return true.
   // 2.   If P exists, but has a non-zero pin-count, return false. Someone is using the page.
   // 3.   Otherwise, P can be deleted. Remove P from the page table, reset its metadata and return it to the free list.
+  std::lock_guard<std::mutex> lock(latch_);
 
   auto page_iter = page_table_.find(page_id);
 
@@ -180,7 +181,7 @@ bool BufferPoolManager::DeletePageImpl(page_id_t page_id) {
 
   disk_manager_->DeallocatePage(page_id);
 
-  free_list_.emplace_back(static_cast<int>(page_iter->second));
+  free_list_.emplace_back(frame_id);
 
   return true;
 }
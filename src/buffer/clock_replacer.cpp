@@ -25,34 +25,29 @@ ClockReplacer::ClockReplacer(size_t num_pages) : max_pages_(num_pages) {
 ClockReplacer::~ClockReplacer() = default;
 
 bool ClockReplacer::Victim(frame_id_t *frame_id) { 
+    std::lock_guard<std::mutex> lock(mutex_);
     if (clock_.empty()) {
-        frame_id = nullptr;
         return false;
     }
 
-    size_t start_pos = hand_idx_;
+    if (hand_idx_ >= clock_.size()) {
+        hand_idx_ = 0;
+    }
+
+    // sweep until we find an unreferenced frame, clearing reference bits on the way; this terminates
+    // after at most one full revolution
     while (true) {
         if (clock_[hand_idx_].second == false) {
             *frame_id = clock_[hand_idx_].first;
             clock_.erase(clock_.begin() + hand_idx_);
+            if (hand_idx_ == clock_.size()) {
+                hand_idx_ = 0;
+            }
             return true;
-        } else {
-            clock_[hand_idx_].second = false;
         }
-        
+        clock_[hand_idx_].second = false;
         hand_idx_ = (hand_idx_ + 1) % clock_.size();
-        
-
-        // if we go back to where we started
-        if (hand_idx_ == start_pos) {
-            *frame_id = clock_[hand_idx_].first;
-            clock_.erase(clock_.begin() + hand_idx_);
-            return true;
-        }
     }
-
-    return false; 
-
 }
 
 void ClockReplacer::Pin(frame_id_t frame_id) {
@@ -60,10 +55,15 @@ void ClockReplacer::Pin(frame_id_t frame_id) {
     auto found_frame = FindFrame(frame_id);
     
     if (found_frame != clock_.end() ) {
-        // edge case: clock hand points to last element in array, must move back 1
-        if (clock_[hand_idx_].first == frame_id && hand_idx_ == clock_.size() - 1)
-            hand_idx_ -= 1;
+        // keep the clock hand on the same frame it pointed at before the erase
+        size_t found_idx = static_cast<size_t>(found_frame - clock_.begin());
         clock_.erase(found_frame);
+        if (found_idx < hand_idx_) {
+            --hand_idx_;
+        }
+        if (hand_idx_ >= clock_.size()) {
+            hand_idx_ = 0;
+        }
     }
 }
 
@@ -72,8 +72,10 @@ void ClockReplacer::Unpin(frame_id_t frame_id) {
     auto found_frame = FindFrame(frame_id);
     // ignore unpins when max size reached
     // if frame DNE add to clock, otherwise, just set ref
-    if (found_frame == clock_.end() && clock_.size() < max_pages_) {
-      clock_.emplace_back(frame_id, true);
+    if (found_frame == clock_.end()) {
+      if (clock_.size() < max_pages_) {
+        clock_.emplace_back(frame_id, true);
+      }
     } else {
       found_frame->second = true;
     }
@@ -0,0 +1,327 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// extendible_hash_table.cpp
+//
+// Identification: src/container/hash/extendible_hash_table.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/exception.h"
+#include "common/logger.h"
+#include "common/rid.h"
+#include "container/hash/extendible_hash_table.h"
+
+namespace bustub {
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+EXTENDIBLE_HASH_TABLE_TYPE::ExtendibleHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
+                                                const KeyComparator &comparator, HashFunction<KeyType> hash_fn)
+    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {
+  // allocate the directory page, new pages are zeroed so the global depth starts at 0
+  Page *page = buffer_pool_manager_->NewPage(&directory_page_id_);
+  BUSTUB_ASSERT(page != nullptr, "Couldn't create a directory page for the hash table.");
+  auto dir_page = reinterpret_cast<HashTableDirectoryPage *>(page->GetData());
+  dir_page->SetPageId(directory_page_id_);
+
+  // allocate the single bucket that every key maps to at global depth 0
+  page_id_t bucket_page_id = INVALID_PAGE_ID;
+  [[maybe_unused]] Page *bucket_page = buffer_pool_manager_->NewPage(&bucket_page_id);
+  BUSTUB_ASSERT(bucket_page != nullptr, "Couldn't create a bucket page for the hash table.");
+  dir_page->SetBucketPageId(0, bucket_page_id);
+  dir_page->SetLocalDepth(0, 0);
+
+  buffer_pool_manager_->UnpinPage(bucket_page_id, true);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, true);
+}
+
+/*****************************************************************************
+ * HELPERS
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+uint32_t EXTENDIBLE_HASH_TABLE_TYPE::Hash(const KeyType &key) {
+  return static_cast<uint32_t>(hash_fn_.GetHash(key));
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+uint32_t EXTENDIBLE_HASH_TABLE_TYPE::KeyToDirectoryIndex(const KeyType &key, HashTableDirectoryPage *dir_page) {
+  return Hash(key) & dir_page->GetGlobalDepthMask();
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+page_id_t EXTENDIBLE_HASH_TABLE_TYPE::KeyToPageId(const KeyType &key, HashTableDirectoryPage *dir_page) {
+  return dir_page->GetBucketPageId(KeyToDirectoryIndex(key, dir_page));
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+HashTableDirectoryPage *EXTENDIBLE_HASH_TABLE_TYPE::FetchDirectoryPage() {
+  return reinterpret_cast<HashTableDirectoryPage *>(buffer_pool_manager_->FetchPage(directory_page_id_)->GetData());
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+Page *EXTENDIBLE_HASH_TABLE_TYPE::FetchBucketPage(page_id_t bucket_page_id) {
+  return buffer_pool_manager_->FetchPage(bucket_page_id);
+}
+
+/*****************************************************************************
+ * SEARCH
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool EXTENDIBLE_HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key,
+                                          std::vector<ValueType> *result) {
+  // the directory only changes under the table write latch, so it can be read without a page latch
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  page_id_t bucket_page_id = KeyToPageId(key, dir_page);
+
+  Page *page = FetchBucketPage(bucket_page_id);
+  page->RLatch();
+  auto bucket = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData());
+  bool found = bucket->GetValue(key, comparator_, result);
+  page->RUnlatch();
+
+  buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  table_latch_.RUnlock();
+  return found;
+}
+
+/*****************************************************************************
+ * INSERTION
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool EXTENDIBLE_HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  page_id_t bucket_page_id = KeyToPageId(key, dir_page);
+
+  Page *page = FetchBucketPage(bucket_page_id);
+  page->WLatch();
+  auto bucket = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData());
+
+  // fast path: the bucket has room, no structural change needed
+  if (!bucket->IsFull()) {
+    bool inserted = bucket->Insert(key, value, comparator_);
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(bucket_page_id, inserted);
+    buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+    table_latch_.RUnlock();
+    return inserted;
+  }
+
+  // slow path: release everything and split under the table write latch
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  table_latch_.RUnlock();
+  return SplitInsert(transaction, key, value);
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool EXTENDIBLE_HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  table_latch_.WLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  bool dir_dirty = false;
+  bool inserted = false;
+
+  // the bucket may have changed since we dropped the read latch, so recheck before every split
+  while (true) {
+    uint32_t bucket_idx = KeyToDirectoryIndex(key, dir_page);
+    page_id_t bucket_page_id = dir_page->GetBucketPageId(bucket_idx);
+    Page *page = FetchBucketPage(bucket_page_id);
+    page->WLatch();
+    auto bucket = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData());
+
+    if (!bucket->IsFull()) {
+      inserted = bucket->Insert(key, value, comparator_);
+      page->WUnlatch();
+      buffer_pool_manager_->UnpinPage(bucket_page_id, inserted);
+      break;
+    }
+
+    // duplicate values for the same key are not allowed, don't split for them
+    std::vector<ValueType> values;
+    bucket->GetValue(key, comparator_, &values);
+    if (std::find(values.begin(), values.end(), value) != values.end()) {
+      page->WUnlatch();
+      buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+      break;
+    }
+
+    // grow the directory if the bucket is already referenced by a single slot
+    uint32_t local_depth = dir_page->GetLocalDepth(bucket_idx);
+    if (local_depth == dir_page->GetGlobalDepth()) {
+      if (dir_page->Size() == HashTableDirectoryPage::MaxSize()) {
+        LOG_WARN("Extendible hash table directory is full, cannot split bucket %d.", bucket_page_id);
+        page->WUnlatch();
+        buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+        break;
+      }
+      dir_page->IncrGlobalDepth();
+      dir_dirty = true;
+    }
+
+    // allocate the split image
+    page_id_t image_page_id = INVALID_PAGE_ID;
+    Page *image_page = buffer_pool_manager_->NewPage(&image_page_id);
+    if (image_page == nullptr) {
+      page->WUnlatch();
+      buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+      break;
+    }
+    image_page->WLatch();
+    auto image = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(image_page->GetData());
+
+    // every slot that pointed at the old bucket gets one more bit of depth, the ones with that bit set move over
+    uint32_t split_bit = 1U << local_depth;
+    for (uint32_t i = 0; i < dir_page->Size(); ++i) {
+      if (dir_page->GetBucketPageId(i) == bucket_page_id) {
+        dir_page->SetLocalDepth(i, local_depth + 1);
+        if ((i & split_bit) != 0) {
+          dir_page->SetBucketPageId(i, image_page_id);
+        }
+      }
+    }
+    dir_dirty = true;
+
+    // redistribute the entries, rebuilding the old bucket so it is free of tombstones
+    std::vector<MappingType> entries;
+    entries.reserve(BUCKET_ARRAY_SIZE);
+    for (uint32_t i = 0; i < BUCKET_ARRAY_SIZE && bucket->IsOccupied(i); ++i) {
+      if (bucket->IsReadable(i)) {
+        entries.emplace_back(bucket->KeyAt(i), bucket->ValueAt(i));
+      }
+    }
+    bucket->Reset();
+    for (const auto &entry : entries) {
+      if ((Hash(entry.first) & split_bit) != 0) {
+        image->Insert(entry.first, entry.second, comparator_);
+      } else {
+        bucket->Insert(entry.first, entry.second, comparator_);
+      }
+    }
+
+    image_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(image_page_id, true);
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(bucket_page_id, true);
+  }
+
+  buffer_pool_manager_->UnpinPage(directory_page_id_, dir_dirty);
+  table_latch_.WUnlock();
+  return inserted;
+}
+
+/*****************************************************************************
+ * REMOVE
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool EXTENDIBLE_HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  page_id_t bucket_page_id = KeyToPageId(key, dir_page);
+
+  Page *page = FetchBucketPage(bucket_page_id);
+  page->WLatch();
+  auto bucket = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData());
+  bool removed = bucket->Remove(key, value, comparator_);
+  bool empty = bucket->IsEmpty();
+  page->WUnlatch();
+
+  buffer_pool_manager_->UnpinPage(bucket_page_id, removed);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  table_latch_.RUnlock();
+
+  if (removed && empty) {
+    Merge(transaction, key);
+  }
+  return removed;
+}
+
+/*****************************************************************************
+ * MERGE
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void EXTENDIBLE_HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key) {
+  table_latch_.WLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  bool dir_dirty = false;
+
+  uint32_t bucket_idx = KeyToDirectoryIndex(key, dir_page);
+  page_id_t bucket_page_id = dir_page->GetBucketPageId(bucket_idx);
+  uint32_t local_depth = dir_page->GetLocalDepth(bucket_idx);
+  uint32_t image_idx = dir_page->GetSplitImageIndex(bucket_idx);
+
+  // only merge with a split image of the same depth, and only if the bucket is still empty
+  if (local_depth > 0 && dir_page->GetLocalDepth(image_idx) == local_depth) {
+    Page *page = FetchBucketPage(bucket_page_id);
+    page->RLatch();
+    bool empty = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData())->IsEmpty();
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+
+    if (empty) {
+      page_id_t image_page_id = dir_page->GetBucketPageId(image_idx);
+      for (uint32_t i = 0; i < dir_page->Size(); ++i) {
+        page_id_t page_id = dir_page->GetBucketPageId(i);
+        if (page_id == bucket_page_id || page_id == image_page_id) {
+          dir_page->SetBucketPageId(i, image_page_id);
+          dir_page->SetLocalDepth(i, local_depth - 1);
+        }
+      }
+      buffer_pool_manager_->DeletePage(bucket_page_id);
+
+      while (dir_page->CanShrink()) {
+        dir_page->DecrGlobalDepth();
+      }
+      dir_dirty = true;
+    }
+  }
+
+  buffer_pool_manager_->UnpinPage(directory_page_id_, dir_dirty);
+  table_latch_.WUnlock();
+}
+
+/*****************************************************************************
+ * GETGLOBALDEPTH
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+uint32_t EXTENDIBLE_HASH_TABLE_TYPE::GetGlobalDepth() {
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  uint32_t global_depth = dir_page->GetGlobalDepth();
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  table_latch_.RUnlock();
+  return global_depth;
+}
+
+/*****************************************************************************
+ * VERIFY INTEGRITY
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void EXTENDIBLE_HASH_TABLE_TYPE::VerifyIntegrity() {
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  dir_page->VerifyIntegrity();
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  table_latch_.RUnlock();
+}
+
+template class ExtendibleHashTable<int, int, IntComparator>;
+
+template class ExtendibleHashTable<GenericKey<4>, RID, GenericComparator<4>>;
+template class ExtendibleHashTable<GenericKey<8>, RID, GenericComparator<8>>;
+template class ExtendibleHashTable<GenericKey<16>, RID, GenericComparator<16>>;
+template class ExtendibleHashTable<GenericKey<32>, RID, GenericComparator<32>>;
+template class ExtendibleHashTable<GenericKey<64>, RID, GenericComparator<64>>;
+
+}  // namespace bustub
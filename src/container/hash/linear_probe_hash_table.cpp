@@ -10,7 +10,12 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -19,194 +24,418 @@
 #include "common/logger.h"
 #include "common/rid.h"
 #include "container/hash/linear_probe_hash_table.h"
+#include "storage/index/covering_value.h"
 
 namespace bustub {
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 HASH_TABLE_TYPE::LinearProbeHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
                                       const KeyComparator &comparator, size_t num_buckets,
-                                      HashFunction<KeyType> hash_fn)
-    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {
-
-      // allocate new page in buffer pool manager & acquire write latch (assume allocation always succeeds)
-      Page* page = buffer_pool_manager_->NewPage(&header_page_id_);
-      page->WLatch();
-
-      // set hash table header page metadata
-      HashTableHeaderPage* header_page = reinterpret_cast<HashTableHeaderPage*>(page->GetData());
-      header_page->SetSize(num_buckets);
-      header_page->SetPageId(header_page_id_);
-
-      // allocate new page from buffer pool manager for num_buckets, add to hash table header page 
-      for (size_t bucket = 0; bucket < num_buckets; ++bucket) {   
-        page_id_t block_page_id = INVALID_PAGE_ID;
-        buffer_pool_manager_->NewPage(&block_page_id);
-        
-        // retry if allocation failed
-        if (block_page_id == INVALID_PAGE_ID) {
-          --bucket;
-          continue;
-        }
+                                      HashFunction<KeyType> hash_fn, bool use_bloom_filter)
+    : buffer_pool_manager_(buffer_pool_manager),
+      comparator_(comparator),
+      use_bloom_filter_(use_bloom_filter),
+      hash_fn_(std::move(hash_fn)) {
+  directory_ = NewTable(num_buckets);
+}
 
-        header_page->AddBlockPageId(block_page_id);
-        buffer_pool_manager_->UnpinPage(block_page_id, false);
-      }
+template <typename KeyType, typename ValueType, typename KeyComparator>
+std::unique_ptr<typename HASH_TABLE_TYPE::Directory> HASH_TABLE_TYPE::NewTable(size_t num_blocks) {
+  page_id_t header_page_id = INVALID_PAGE_ID;
+  Page *page = buffer_pool_manager_->NewPage(&header_page_id);
+  BUSTUB_ASSERT(page != nullptr, "Couldn't create a header page for the hash table.");
+
+  // set hash table header page metadata
+  auto *hash_header_page = reinterpret_cast<HashTableHeaderPage *>(page->GetData());
+  hash_header_page->SetSize(num_blocks);
+  hash_header_page->SetPageId(header_page_id);
+
+  // allocate the block pages, nobody can see them yet so they need no latches. they are unpinned dirty so that an
+  // evicted block is written out rather than read back from past the end of the file
+  std::vector<page_id_t> block_page_ids;
+  for (size_t block = 0; block < num_blocks; ++block) {
+    page_id_t block_page_id = INVALID_PAGE_ID;
+    buffer_pool_manager_->NewPage(&block_page_id);
+    BUSTUB_ASSERT(block_page_id != INVALID_PAGE_ID, "Couldn't create a block page for the hash table.");
+    hash_header_page->AddBlockPageId(block_page_id);
+    block_page_ids.push_back(block_page_id);
+    buffer_pool_manager_->UnpinPage(block_page_id, true);
+  }
+  std::vector<page_id_t> filter_page_ids = NewFilter(num_blocks, hash_header_page);
 
-      // unlatch hash table header page  and unpin it in buffer pool manager
-      page->WUnlatch();
-      buffer_pool_manager_->UnpinPage(header_page_id_, true);
-    }
+  buffer_pool_manager_->UnpinPage(header_page_id, true);
+  return std::make_unique<Directory>(header_page_id, std::move(block_page_ids), std::move(filter_page_ids));
+}
+
+/*****************************************************************************
+ * BLOOM FILTER
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+std::vector<page_id_t> HASH_TABLE_TYPE::NewFilter(size_t num_blocks, HashTableHeaderPage *hash_header_page) {
+  std::vector<page_id_t> filter_page_ids;
+  hash_header_page->SetFilterPageId(INVALID_PAGE_ID);
+  if (!use_bloom_filter_) {
+    return filter_page_ids;
+  }
+
+  size_t bits_per_page = BloomFilterPage::NUM_BLOCKS * BloomFilterPage::BLOCK_SIZE * 8;
+  size_t num_pages = (BLOCK_ARRAY_SIZE * num_blocks * BLOOM_FILTER_BITS_PER_SLOT + bits_per_page - 1) / bits_per_page;
+  // allocated back to front, so every page can link to the one after it
+  filter_page_ids.resize(num_pages);
+  page_id_t next_page_id = INVALID_PAGE_ID;
+  for (size_t i = num_pages; i-- > 0;) {
+    Page *page = buffer_pool_manager_->NewPage(&filter_page_ids[i]);
+    BUSTUB_ASSERT(page != nullptr, "Couldn't create a Bloom filter page for the hash table.");
+    reinterpret_cast<BloomFilterPage *>(page->GetData())->SetNextPageId(next_page_id);
+    next_page_id = filter_page_ids[i];
+    buffer_pool_manager_->UnpinPage(filter_page_ids[i], true);
+  }
+  hash_header_page->SetFilterPageId(next_page_id);
+  return filter_page_ids;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+std::pair<size_t, size_t> HASH_TABLE_TYPE::FilterBlock(const Directory &directory, uint64_t hash) const {
+  // multiply and shift maps the high half of the hash onto the blocks without a division
+  uint64_t num_filter_blocks = directory.filter_page_ids_.size() * BloomFilterPage::NUM_BLOCKS;
+  size_t filter_block = ((hash >> 32) * num_filter_blocks) >> 32;
+  return {filter_block / BloomFilterPage::NUM_BLOCKS, filter_block % BloomFilterPage::NUM_BLOCKS};
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::FilterInsert(const Directory &directory, uint64_t hash) {
+  if (directory.filter_page_ids_.empty()) {
+    return;
+  }
+  auto block = FilterBlock(directory, hash);
+  directory.FilterPage(block.first)->Insert(block.second, static_cast<uint32_t>(hash));
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool HASH_TABLE_TYPE::FilterMayContain(const Directory &directory, uint64_t hash) {
+  if (directory.filter_page_ids_.empty()) {
+    return true;
+  }
+  auto block = FilterBlock(directory, hash);
+  bool may_contain = directory.FilterPage(block.first)->MayContain(block.second, static_cast<uint32_t>(hash));
+  if (!may_contain) {
+    ++num_filter_negatives_;
+  }
+  return may_contain;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::WriteFilter(const Directory &directory) {
+  for (size_t i = 0; i < directory.filter_page_ids_.size(); ++i) {
+    Page *page = buffer_pool_manager_->FetchPage(directory.filter_page_ids_[i]);
+    std::memcpy(page->GetData(), directory.FilterPage(i), PAGE_SIZE);
+    buffer_pool_manager_->UnpinPage(directory.filter_page_ids_[i], true);
+  }
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::WriteCounts(const Directory &directory) {
+  Page *header_page = buffer_pool_manager_->FetchPage(directory.header_page_id_);
+  reinterpret_cast<HashTableHeaderPage *>(header_page->GetData())
+      ->SetCounts(directory.num_pairs_, directory.num_tombstones_);
+  buffer_pool_manager_->UnpinPage(directory.header_page_id_, true);
+}
 
 /*****************************************************************************
  * SEARCH
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) {
-  // Rlock table_latch
   table_latch_.RLock();
-  
-  // Rlatch header page for this hash table
-  Page* header_page = buffer_pool_manager_->FetchPage(header_page_id_);
-  header_page->RLatch();
-  HashTableHeaderPage* hash_header_page = 
-    reinterpret_cast<HashTableHeaderPage*>(header_page->GetData());
-  
-  // compute hash idx, block idx and bucket idx 
-  size_t hash_idx = hash_fn_.GetHash(key) % (BLOCK_ARRAY_SIZE * hash_header_page->NumBlocks());
-  size_t block_idx = hash_idx / BLOCK_ARRAY_SIZE;
-  size_t bucket_idx = hash_idx % BLOCK_ARRAY_SIZE;
-
-  // get the block page, acquire read latch 
-  Page* block_page = buffer_pool_manager_->FetchPage(hash_header_page->GetBlockPageId(block_idx));
-  block_page->RLatch();
-  auto hash_block_page = reinterpret_cast<HashTableBlockPage<KeyType, ValueType, KeyComparator> *>(block_page->GetData());
-  
-  // keep looking until blocks are no longer occupied
-  while (hash_block_page->IsOccupied(bucket_idx)) {
-    // found page
-    if (hash_block_page->IsReadable(bucket_idx) && comparator_(hash_block_page->KeyAt(bucket_idx), key) == 0) {
-      result->push_back(hash_block_page->ValueAt(bucket_idx));
+  bool migrated_last = MigrateBlocks(MIGRATE_BLOCKS_PER_OP);
+
+  // a pair that is not migrated yet is still in the old table. the old table is searched first: a pair migrated in
+  // between the two lookups is then seen twice rather than not at all
+  size_t old_size = result->size();
+  bool found = false;
+  if (old_directory_ != nullptr) {
+    found = GetValueIn(*old_directory_, key, result);
+  }
+  size_t new_size = result->size();
+  found = GetValueIn(*directory_, key, result) || found;
+  if (new_size != old_size) {
+    for (size_t i = result->size(); i-- > new_size;) {
+      if (std::find(result->begin() + old_size, result->begin() + new_size, (*result)[i]) !=
+          result->begin() + new_size) {
+        result->erase(result->begin() + i);
+      }
     }
+  }
+  table_latch_.RUnlock();
 
-    // increment bucket_idx
-    ++bucket_idx;
-
-    // searched entire hash table
-    if (block_idx * BLOCK_ARRAY_SIZE + bucket_idx == hash_idx) 
-      break;
-
-    // reached end of block, go to new block
-    if (bucket_idx == BLOCK_ARRAY_SIZE) {
-      bucket_idx = 0;
-      block_page->RUnlatch();
+  if (migrated_last) {
+    table_latch_.WLock();
+    FinishResize();
+    table_latch_.WUnlock();
+  }
+  return found;
+}
 
-      buffer_pool_manager_->UnpinPage(hash_header_page->GetBlockPageId(block_idx), false);
-      block_idx = (block_idx + 1) % hash_header_page->NumBlocks();
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool HASH_TABLE_TYPE::GetValueIn(const Directory &directory, const KeyType &key, std::vector<ValueType> *result) {
+  uint64_t hash = hash_fn_.GetHash(key);
+  if (!FilterMayContain(directory, hash)) {
+    return false;
+  }
 
-      block_page = buffer_pool_manager_->FetchPage(hash_header_page->GetBlockPageId(block_idx));
+  size_t num_blocks = directory.NumBlocks();
+  size_t num_slots = directory.NumSlots();
+  size_t hash_idx = hash % num_slots;
+
+  bool found = false;
+  Page *block_page = nullptr;
+  HashTableBlockPage<KeyType, ValueType, KeyComparator> *hash_block_page = nullptr;
+  size_t block_idx = num_blocks;
+  // probe until the first never occupied slot, or until every slot was seen
+  for (size_t probe = 0; probe < num_slots; ++probe) {
+    size_t slot = (hash_idx + probe) % num_slots;
+    if (slot / BLOCK_ARRAY_SIZE != block_idx) {
+      if (block_page != nullptr) {
+        block_page->RUnlatch();
+        buffer_pool_manager_->UnpinPage(block_page->GetPageId(), false);
+      }
+      block_idx = slot / BLOCK_ARRAY_SIZE;
+      block_page = buffer_pool_manager_->FetchPage(directory.block_page_ids_[block_idx]);
       block_page->RLatch();
-      hash_block_page = reinterpret_cast<HashTableBlockPage<KeyType, ValueType, KeyComparator> *>(block_page->GetData());
+      hash_block_page =
+          reinterpret_cast<HashTableBlockPage<KeyType, ValueType, KeyComparator> *>(block_page->GetData());
+    }
+    size_t bucket_idx = slot % BLOCK_ARRAY_SIZE;
+    if (!hash_block_page->IsOccupied(bucket_idx)) {
+      break;
+    }
+    if (hash_block_page->IsReadable(bucket_idx) && comparator_(hash_block_page->KeyAt(bucket_idx), key) == 0) {
+      result->push_back(hash_block_page->ValueAt(bucket_idx));
+      found = true;
     }
   }
 
-  // unlatch and unpin pages used
   block_page->RUnlatch();
-  buffer_pool_manager_->UnpinPage(hash_header_page->GetBlockPageId(block_idx), false);
-  header_page->RUnlatch();
-  buffer_pool_manager_->UnpinPage(header_page_id_, false);
+  buffer_pool_manager_->UnpinPage(block_page->GetPageId(), false);
+  return found;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::GetValues(Transaction *transaction, const std::vector<KeyType> &keys,
+                                std::vector<std::vector<ValueType>> *results) {
+  results->assign(keys.size(), std::vector<ValueType>());
+  table_latch_.RLock();
+  bool migrated_last = MigrateBlocks(MIGRATE_BLOCKS_PER_OP);
+
+  if (old_directory_ != nullptr) {
+    // same order as GetValue: the whole batch in the old table first, then in the new one
+    GetValuesIn(*old_directory_, keys, results);
+    std::vector<std::vector<ValueType>> new_results(keys.size());
+    GetValuesIn(*directory_, keys, &new_results);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      auto &result = (*results)[i];
+      size_t old_size = result.size();
+      for (const auto &value : new_results[i]) {
+        if (std::find(result.begin(), result.begin() + old_size, value) == result.begin() + old_size) {
+          result.push_back(value);
+        }
+      }
+    }
+  } else {
+    GetValuesIn(*directory_, keys, results);
+  }
   table_latch_.RUnlock();
 
-  // return true of false based on result
-  return result->empty() ? false : true;
+  if (migrated_last) {
+    table_latch_.WLock();
+    FinishResize();
+    table_latch_.WUnlock();
+  }
 }
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::GetValuesIn(const Directory &directory, const std::vector<KeyType> &keys,
+                                  std::vector<std::vector<ValueType>> *results) {
+  size_t num_slots = directory.NumSlots();
+
+  // the probe of a key, waiting for the block page of its next slot
+  struct Probe {
+    size_t key_idx_;
+    size_t slot_;
+    size_t num_probed_;
+  };
+  std::map<size_t, std::vector<Probe>> probes_by_block;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    uint64_t hash = hash_fn_.GetHash(keys[i]);
+    if (FilterMayContain(directory, hash)) {
+      size_t slot = hash % num_slots;
+      probes_by_block[slot / BLOCK_ARRAY_SIZE].push_back({i, slot, 0});
+    }
+  }
+
+  // blocks are visited in order, a probe running off the end of a block waits for the next one
+  while (!probes_by_block.empty()) {
+    size_t block_idx = probes_by_block.begin()->first;
+    std::vector<Probe> probes = std::move(probes_by_block.begin()->second);
+    probes_by_block.erase(probes_by_block.begin());
+
+    page_id_t block_page_id = directory.block_page_ids_[block_idx];
+    Page *block_page = buffer_pool_manager_->FetchPage(block_page_id);
+    block_page->RLatch();
+    auto *hash_block_page =
+        reinterpret_cast<HashTableBlockPage<KeyType, ValueType, KeyComparator> *>(block_page->GetData());
+
+    // start loading every slot of the group before walking any chain, so their cache misses overlap
+    for (const auto &probe : probes) {
+      hash_block_page->Prefetch(probe.slot_ % BLOCK_ARRAY_SIZE);
+    }
+    for (auto &probe : probes) {
+      bool done = false;
+      while (probe.num_probed_ < num_slots && probe.slot_ / BLOCK_ARRAY_SIZE == block_idx) {
+        size_t bucket_idx = probe.slot_ % BLOCK_ARRAY_SIZE;
+        if (!hash_block_page->IsOccupied(bucket_idx)) {
+          done = true;
+          break;
+        }
+        if (hash_block_page->IsReadable(bucket_idx) &&
+            comparator_(hash_block_page->KeyAt(bucket_idx), keys[probe.key_idx_]) == 0) {
+          (*results)[probe.key_idx_].push_back(hash_block_page->ValueAt(bucket_idx));
+        }
+        probe.slot_ = (probe.slot_ + 1) % num_slots;
+        ++probe.num_probed_;
+      }
+      if (!done && probe.num_probed_ < num_slots) {
+        probes_by_block[probe.slot_ / BLOCK_ARRAY_SIZE].push_back(probe);
+      }
+    }
+
+    block_page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(block_page_id, false);
+  }
+}
+
 /*****************************************************************************
  * INSERTION
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) {
-  // Rlock table_latch
-  table_latch_.RLock();
-
-  // Rlatch header page for this hash table
-  Page* header_page = buffer_pool_manager_->FetchPage(header_page_id_);
-  header_page->RLatch();
-  HashTableHeaderPage* hash_header_page = 
-    reinterpret_cast<HashTableHeaderPage*>(header_page->GetData());
-
-  // compute hash idx, block idx and bucket idx 
-  size_t hash_idx = hash_fn_.GetHash(key) % (BLOCK_ARRAY_SIZE * hash_header_page->NumBlocks());
-  size_t block_idx = hash_idx / BLOCK_ARRAY_SIZE;
-  size_t bucket_idx = hash_idx % BLOCK_ARRAY_SIZE;
-
-  // get the block page, acquire write latch 
-  Page* block_page = buffer_pool_manager_->FetchPage(hash_header_page->GetBlockPageId(block_idx));
-  block_page->WLatch();
-  auto hash_block_page = reinterpret_cast<HashTableBlockPage<KeyType, ValueType, KeyComparator> *>(block_page->GetData());
-  
-  // keep trying to insert <key, val> into block
-  while (hash_block_page->Insert(bucket_idx, key, value) == false) {
-    // duplicate values for same key are not allowed, insertion failed
-    if (comparator_(hash_block_page->KeyAt(bucket_idx), key) == 0 && hash_block_page->ValueAt(bucket_idx) == value) {
-      block_page->WUnlatch();
-      buffer_pool_manager_->UnpinPage(hash_header_page->GetBlockPageId(block_idx), true);
-      header_page->RUnlatch();
-      buffer_pool_manager_->UnpinPage(header_page_id_, false);
+  while (true) {
+    table_latch_.RLock();
+    bool migrated_last = MigrateBlocks(MIGRATE_BLOCKS_PER_OP);
+
+    // the pair may still sit in the old table, new pairs only go to the new one
+    InsertResult result = InsertResult::DUPLICATE;
+    if (old_directory_ != nullptr) {
+      std::vector<ValueType> old_values;
+      GetValueIn(*old_directory_, key, &old_values);
+      if (std::find(old_values.begin(), old_values.end(), value) == old_values.end()) {
+        result = InsertInto(directory_.get(), key, value);
+      }
+    } else {
+      result = InsertInto(directory_.get(), key, value);
+    }
+    page_id_t header_page_id = directory_->header_page_id_;
+    // grow ahead of time, long before the table is full and probes get long
+    bool overloaded = result == InsertResult::INSERTED && old_directory_ == nullptr && IsOverloaded(*directory_) &&
+                      ResizeTarget(*directory_) != 0;
+    table_latch_.RUnlock();
+
+    if (migrated_last) {
+      table_latch_.WLock();
+      FinishResize();
+      table_latch_.WUnlock();
+    }
+    if (overloaded) {
+      Grow(header_page_id);
+    }
+    if (result != InsertResult::FULL) {
+      return result == InsertResult::INSERTED;
+    }
+    if (!Grow(header_page_id)) {
       return false;
     }
+  }
+}
 
-    ++bucket_idx;
-
-    // resize table when loop detected
-    if (block_idx * BLOCK_ARRAY_SIZE + bucket_idx == hash_idx) {
-      // release latches 
-      block_page->WUnlatch();
-      buffer_pool_manager_->UnpinPage(hash_header_page->GetBlockPageId(block_idx), true);
-      header_page->RUnlatch();
-      buffer_pool_manager_->UnpinPage(header_page_id_, false);
-
-      // resize
-      Resize(hash_header_page->NumBlocks() * BLOCK_ARRAY_SIZE);
-
-      // reacquire latches
-      header_page = buffer_pool_manager_->FetchPage(header_page_id_);
-      header_page->RLatch();
-      hash_header_page = reinterpret_cast<HashTableHeaderPage*> (header_page->GetData());
-
-      // recompute idx
-      hash_idx = hash_fn_.GetHash(key) % (BLOCK_ARRAY_SIZE * hash_header_page->NumBlocks());
-      block_idx = hash_idx / BLOCK_ARRAY_SIZE;
-      bucket_idx = hash_idx % BLOCK_ARRAY_SIZE;
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool HASH_TABLE_TYPE::IsOverloaded(const Directory &directory) {
+  // tombstones lengthen probes as much as pairs do
+  int64_t num_occupied = directory.num_pairs_ + directory.num_tombstones_;
+  return static_cast<double>(num_occupied) > MAX_LOAD_FACTOR * static_cast<double>(directory.NumSlots());
+}
 
-      block_page = buffer_pool_manager_->FetchPage(hash_header_page->GetBlockPageId(block_idx));
+template <typename KeyType, typename ValueType, typename KeyComparator>
+typename HASH_TABLE_TYPE::InsertResult HASH_TABLE_TYPE::InsertInto(Directory *directory, const KeyType &key,
+                                                                    const ValueType &value) {
+  size_t num_blocks = directory->NumBlocks();
+  size_t num_slots = directory->NumSlots();
+  uint64_t hash = hash_fn_.GetHash(key);
+  size_t hash_idx = hash % num_slots;
+  // the key goes into the filter before the pair becomes readable, so no lookup that could see the pair misses it.
+  // a pair that turns out to be a duplicate only costs a false positive
+  FilterInsert(*directory, hash);
+
+  InsertResult result = InsertResult::FULL;
+  // the first tombstone of the chain, reused once the rest of the chain is known to hold no duplicate
+  size_t tombstone = num_slots;
+  Page *block_page = nullptr;
+  HashTableBlockPage<KeyType, ValueType, KeyComparator> *hash_block_page = nullptr;
+  size_t block_idx = num_blocks;
+  for (size_t probe = 0; probe < num_slots; ++probe) {
+    size_t slot = (hash_idx + probe) % num_slots;
+    if (slot / BLOCK_ARRAY_SIZE != block_idx) {
+      if (block_page != nullptr) {
+        block_page->WUnlatch();
+        buffer_pool_manager_->UnpinPage(block_page->GetPageId(), false);
+      }
+      block_idx = slot / BLOCK_ARRAY_SIZE;
+      block_page = buffer_pool_manager_->FetchPage(directory->block_page_ids_[block_idx]);
       block_page->WLatch();
-      hash_block_page = 
-        reinterpret_cast<HashTableBlockPage<KeyType, ValueType, KeyComparator> *>(block_page->GetData());
-      continue;
+      hash_block_page =
+          reinterpret_cast<HashTableBlockPage<KeyType, ValueType, KeyComparator> *>(block_page->GetData());
     }
-
-    // done scanning current block, reset bucket_idx, block_idx and block_page
-    if (bucket_idx == BLOCK_ARRAY_SIZE) {
-      bucket_idx = 0;
-      
-      buffer_pool_manager_->UnpinPage(hash_header_page->GetBlockPageId(block_idx++), false);
-      if (block_idx == hash_header_page->NumBlocks()) 
-        block_idx = 0;
-
-      block_page->WUnlatch();
-      block_page = buffer_pool_manager_->FetchPage(hash_header_page->GetBlockPageId(block_idx));
-      hash_block_page = 
-        reinterpret_cast<HashTableBlockPage<KeyType, ValueType, KeyComparator> *>(block_page->GetData());
+    size_t bucket_idx = slot % BLOCK_ARRAY_SIZE;
+    if (!hash_block_page->IsOccupied(bucket_idx)) {
+      // end of the chain
+      if (tombstone == num_slots) {
+        hash_block_page->Insert(bucket_idx, key, value);
+        directory->UpdateCounts(1, 0);
+        result = InsertResult::INSERTED;
+      }
+      break;
+    }
+    if (hash_block_page->IsReadable(bucket_idx)) {
+      // duplicate values for the same key are not allowed
+      if (comparator_(hash_block_page->KeyAt(bucket_idx), key) == 0 && hash_block_page->ValueAt(bucket_idx) == value) {
+        result = InsertResult::DUPLICATE;
+        break;
+      }
+    } else if (tombstone == num_slots) {
+      tombstone = slot;
     }
   }
-
-  // release latches, locks and unpin 
   block_page->WUnlatch();
-  buffer_pool_manager_->UnpinPage(hash_header_page->GetBlockPageId(block_idx), true);
-  header_page->RUnlatch();
-  buffer_pool_manager_->UnpinPage(header_page_id_, false);
-  table_latch_.RUnlock();
+  buffer_pool_manager_->UnpinPage(block_page->GetPageId(), result == InsertResult::INSERTED);
+
+  bool retry = false;
+  if (result == InsertResult::FULL && tombstone != num_slots) {
+    page_id_t block_page_id = directory->block_page_ids_[tombstone / BLOCK_ARRAY_SIZE];
+    block_page = buffer_pool_manager_->FetchPage(block_page_id);
+    block_page->WLatch();
+    hash_block_page = reinterpret_cast<HashTableBlockPage<KeyType, ValueType, KeyComparator> *>(block_page->GetData());
+    // another insert may have taken the tombstone in the meantime, or a compaction cleared it
+    if (hash_block_page->IsOccupied(tombstone % BLOCK_ARRAY_SIZE) &&
+        hash_block_page->Insert(tombstone % BLOCK_ARRAY_SIZE, key, value)) {
+      directory->UpdateCounts(1, -1);
+      result = InsertResult::INSERTED;
+    } else {
+      retry = true;
+    }
+    block_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(block_page_id, result == InsertResult::INSERTED);
+  }
 
-  return true;
+  return retry ? InsertInto(directory, key, value) : result;
 }
 
 /*****************************************************************************
@@ -214,74 +443,252 @@ bool HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) {
-  // Rlock table_latch
   table_latch_.RLock();
+  bool migrated_last = MigrateBlocks(MIGRATE_BLOCKS_PER_OP);
+
+  // same order as lookups: a pair missing from the old table has been migrated to the new one
+  bool removed = false;
+  if (old_directory_ != nullptr) {
+    removed = RemoveFrom(old_directory_.get(), key, value);
+  }
+  if (!removed) {
+    removed = RemoveFrom(directory_.get(), key, value);
+  }
+  table_latch_.RUnlock();
+
+  if (migrated_last) {
+    table_latch_.WLock();
+    FinishResize();
+    table_latch_.WUnlock();
+  }
+  return removed;
+}
 
-  // Rlatch header page for this hash table
-  Page* header_page = buffer_pool_manager_->FetchPage(header_page_id_);
-  header_page->RLatch();
-  HashTableHeaderPage* hash_header_page = 
-  reinterpret_cast<HashTableHeaderPage*>(header_page->GetData());
-
-  // compute hash idx, block idx and bucket idx 
-  size_t hash_idx = hash_fn_.GetHash(key) % (BLOCK_ARRAY_SIZE * hash_header_page->NumBlocks());
-  size_t block_idx = hash_idx / BLOCK_ARRAY_SIZE;
-  size_t bucket_idx = hash_idx % BLOCK_ARRAY_SIZE;
-
-  // get the block page, acquire write latch 
-  Page* block_page = buffer_pool_manager_->FetchPage(hash_header_page->GetBlockPageId(block_idx));
-  block_page->WLatch();
-  auto hash_block_page = reinterpret_cast<HashTableBlockPage<KeyType, ValueType, KeyComparator> *>(block_page->GetData());
-
-  // keep looking until blocks are no longer occupied
-  while (hash_block_page->IsOccupied(bucket_idx)) {
-    // found page 
-    if (comparator_(hash_block_page->KeyAt(bucket_idx), key) == 0 && hash_block_page->ValueAt(bucket_idx) == value) {
-      // block not readable -> this is an error, can't remove
-      if (hash_block_page->IsReadable(bucket_idx) == false) {
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool HASH_TABLE_TYPE::RemoveFrom(Directory *directory, const KeyType &key, const ValueType &value) {
+  uint64_t hash = hash_fn_.GetHash(key);
+  if (!FilterMayContain(*directory, hash)) {
+    return false;
+  }
+
+  size_t num_blocks = directory->NumBlocks();
+  size_t num_slots = directory->NumSlots();
+  size_t hash_idx = hash % num_slots;
+
+  bool removed = false;
+  Page *block_page = nullptr;
+  HashTableBlockPage<KeyType, ValueType, KeyComparator> *hash_block_page = nullptr;
+  size_t block_idx = num_blocks;
+  for (size_t probe = 0; probe < num_slots; ++probe) {
+    size_t slot = (hash_idx + probe) % num_slots;
+    if (slot / BLOCK_ARRAY_SIZE != block_idx) {
+      if (block_page != nullptr) {
         block_page->WUnlatch();
-        buffer_pool_manager_->UnpinPage(hash_header_page->GetBlockPageId(block_idx), true);
-        header_page->RUnlatch();
-        buffer_pool_manager_->UnpinPage(header_page_id_, false);
-        return false;
+        buffer_pool_manager_->UnpinPage(block_page->GetPageId(), false);
       }
-      // can remove
+      block_idx = slot / BLOCK_ARRAY_SIZE;
+      block_page = buffer_pool_manager_->FetchPage(directory->block_page_ids_[block_idx]);
+      block_page->WLatch();
+      hash_block_page =
+          reinterpret_cast<HashTableBlockPage<KeyType, ValueType, KeyComparator> *>(block_page->GetData());
+    }
+    size_t bucket_idx = slot % BLOCK_ARRAY_SIZE;
+    if (!hash_block_page->IsOccupied(bucket_idx)) {
+      break;
+    }
+    if (hash_block_page->IsReadable(bucket_idx) && comparator_(hash_block_page->KeyAt(bucket_idx), key) == 0 &&
+        hash_block_page->ValueAt(bucket_idx) == value) {
+      // leave a tombstone so the probe chains running through this slot stay intact
       hash_block_page->Remove(bucket_idx);
-      block_page->WUnlatch();
-      buffer_pool_manager_->UnpinPage(hash_header_page->GetBlockPageId(block_idx), true);
-      header_page->RUnlatch();
-      buffer_pool_manager_->UnpinPage(header_page_id_, false);
-      return true;
+      directory->UpdateCounts(-1, 1);
+      removed = true;
+      if (static_cast<double>(hash_block_page->NumOccupied() - hash_block_page->NumReadable()) >=
+          COMPACT_TOMBSTONE_RATIO * BLOCK_ARRAY_SIZE) {
+        CompactBlock(directory, block_idx, hash_block_page);
+      }
+      break;
     }
+  }
 
-    // increment bucket
-    ++bucket_idx;
+  block_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(block_page->GetPageId(), removed);
+  return removed;
+}
 
-    // searched entire table
-    if (block_idx * BLOCK_ARRAY_SIZE + bucket_idx == hash_idx) 
-      break;
+/*****************************************************************************
+ * COMPACTION
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::CompactBlock(Directory *directory, size_t block_idx,
+                                   HashTableBlockPage<KeyType, ValueType, KeyComparator> *hash_block_page) {
+  size_t num_blocks = directory->NumBlocks();
+  size_t num_slots = directory->NumSlots();
+  size_t first_slot = block_idx * BLOCK_ARRAY_SIZE;
+
+  // move pairs back into the earliest tombstone of the block that lies on their probe chain. every slot between the
+  // home slot and the pair is occupied, and moves keep it that way
+  std::set<size_t> tombstones;
+  for (size_t bucket_idx = 0; bucket_idx < BLOCK_ARRAY_SIZE; ++bucket_idx) {
+    if (!hash_block_page->IsReadable(bucket_idx)) {
+      if (hash_block_page->IsOccupied(bucket_idx)) {
+        tombstones.insert(bucket_idx);
+      }
+      continue;
+    }
+    if (tombstones.empty()) {
+      continue;
+    }
+    KeyType key = hash_block_page->KeyAt(bucket_idx);
+    size_t home = hash_fn_.GetHash(key) % num_slots;
+    size_t distance = (first_slot + bucket_idx + num_slots - home) % num_slots;
+    auto tombstone = tombstones.lower_bound(bucket_idx - std::min(distance, bucket_idx));
+    if (tombstone == tombstones.end()) {
+      continue;
+    }
+    ValueType value = hash_block_page->ValueAt(bucket_idx);
+    hash_block_page->Remove(bucket_idx);
+    hash_block_page->Insert(*tombstone, key, value);
+    tombstones.erase(tombstone);
+    tombstones.insert(bucket_idx);
+  }
 
-    // reached end of block, go to new block
-    if (bucket_idx == BLOCK_ARRAY_SIZE) {
-      bucket_idx = 0;
-      block_page->WUnlatch();
+  // a tombstone followed by a never occupied slot is the end of every chain through it, so no probe has to pass it
+  // any more. the last slot is only cleared in a single block table: an insert may have left this block for the next
+  // one, counting on the chain through the last slot, without holding any latch we could wait for
+  bool next_free = num_blocks == 1 && !hash_block_page->IsOccupied(0);
+  size_t cleared = 0;
+  for (size_t bucket_idx = BLOCK_ARRAY_SIZE; bucket_idx-- > 0;) {
+    bool free_after = bucket_idx + 1 == BLOCK_ARRAY_SIZE ? next_free : !hash_block_page->IsOccupied(bucket_idx + 1);
+    if (free_after && hash_block_page->IsOccupied(bucket_idx) && !hash_block_page->IsReadable(bucket_idx)) {
+      hash_block_page->Clear(bucket_idx);
+      ++cleared;
+    }
+  }
 
-      buffer_pool_manager_->UnpinPage(hash_header_page->GetBlockPageId(block_idx), false);
-      block_idx = (block_idx + 1) % hash_header_page->NumBlocks();
+  directory->UpdateCounts(0, -static_cast<int32_t>(cleared));
+  ++num_compactions_;
+  num_tombstones_cleared_ += cleared;
+}
 
-      block_page = buffer_pool_manager_->FetchPage(hash_header_page->GetBlockPageId(block_idx));
-      block_page->WLatch();
-      hash_block_page = reinterpret_cast<HashTableBlockPage<KeyType, ValueType, KeyComparator> *>(block_page->GetData());
+template <typename KeyType, typename ValueType, typename KeyComparator>
+double HASH_TABLE_TYPE::GetTombstoneRatio() {
+  table_latch_.RLock();
+  double ratio = static_cast<double>(directory_->num_tombstones_) / static_cast<double>(directory_->NumSlots());
+  table_latch_.RUnlock();
+  return ratio;
+}
+
+/*****************************************************************************
+ * BULK LOAD
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+size_t HASH_TABLE_TYPE::BulkLoad(Transaction *transaction, const std::vector<std::pair<KeyType, ValueType>> &entries) {
+  table_latch_.WLock();
+  bool settled = CompleteResize();
+
+  page_id_t header_page_id = directory_->header_page_id_;
+  Page *header_page = buffer_pool_manager_->FetchPage(header_page_id);
+  header_page->WLatch();
+  auto *hash_header_page = reinterpret_cast<HashTableHeaderPage *>(header_page->GetData());
+
+  // grow to a load factor of at most one half (as far as the header page can address) by adding blocks in place.
+  // pairs already in the table would hash to other slots then, so a table that is not empty falls back to inserting
+  // one pair at a time instead of being migrated the way Resize does. so does a table whose old table could not be
+  // migrated completely
+  size_t num_blocks = (2 * entries.size() + BLOCK_ARRAY_SIZE - 1) / BLOCK_ARRAY_SIZE;
+  num_blocks = std::max(hash_header_page->NumBlocks(), std::min(num_blocks, HashTableHeaderPage::MaxNumBlocks()));
+  bool grown = num_blocks > hash_header_page->NumBlocks();
+  if (!settled || (grown && directory_->num_pairs_ > 0)) {
+    header_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(header_page_id, false);
+    table_latch_.WUnlock();
+    for (const auto &entry : entries) {
+      Insert(transaction, entry.first, entry.second);
     }
+    return entries.size();
+  }
+  if (grown) {
+    std::vector<page_id_t> block_page_ids(directory_->block_page_ids_);
+    while (block_page_ids.size() < num_blocks) {
+      page_id_t block_page_id = INVALID_PAGE_ID;
+      buffer_pool_manager_->NewPage(&block_page_id);
+      BUSTUB_ASSERT(block_page_id != INVALID_PAGE_ID, "Couldn't create a block page to bulk load into.");
+      hash_header_page->AddBlockPageId(block_page_id);
+      block_page_ids.push_back(block_page_id);
+      buffer_pool_manager_->UnpinPage(block_page_id, false);
+    }
+    hash_header_page->SetSize(num_blocks);
+    // the table holds no pairs, so its filter is simply replaced by one sized for the new number of blocks
+    for (page_id_t filter_page_id : directory_->filter_page_ids_) {
+      buffer_pool_manager_->DeletePage(filter_page_id);
+    }
+    std::vector<page_id_t> filter_page_ids = NewFilter(num_blocks, hash_header_page);
+    // the table latch is held in write mode, so nobody is using the directory being replaced
+    auto directory =
+        std::make_unique<Directory>(header_page_id, std::move(block_page_ids), std::move(filter_page_ids));
+    directory->num_pairs_ = directory_->num_pairs_.load();
+    directory->num_tombstones_ = directory_->num_tombstones_.load();
+    directory_ = std::move(directory);
   }
 
-  // unlatch and unpin pages used
-  block_page->WUnlatch();
-  buffer_pool_manager_->UnpinPage(hash_header_page->GetBlockPageId(block_idx), true);
-  header_page->RUnlatch();
-  buffer_pool_manager_->UnpinPage(header_page_id_, false);
+  // sort by home slot: the slot a pair lands in is then never before the slot of the pair placed just before it
+  size_t num_slots = BLOCK_ARRAY_SIZE * num_blocks;
+  std::vector<std::pair<size_t, size_t>> homes;
+  homes.reserve(entries.size());
+  for (size_t i = 0; i < entries.size(); ++i) {
+    homes.emplace_back(hash_fn_.GetHash(entries[i].first) % num_slots, i);
+  }
+  std::sort(homes.begin(), homes.end());
+
+  std::vector<size_t> wrapped;
+  Page *block_page = nullptr;
+  HashTableBlockPage<KeyType, ValueType, KeyComparator> *hash_block_page = nullptr;
+  size_t block_idx = num_blocks;
+  size_t next_slot = 0;
+  for (const auto &home : homes) {
+    const auto &entry = entries[home.second];
+    size_t slot = std::max(home.first, next_slot);
+    while (slot < num_slots) {
+      if (slot / BLOCK_ARRAY_SIZE != block_idx) {
+        if (block_page != nullptr) {
+          block_page->WUnlatch();
+          buffer_pool_manager_->UnpinPage(block_page->GetPageId(), true);
+        }
+        block_idx = slot / BLOCK_ARRAY_SIZE;
+        block_page = buffer_pool_manager_->FetchPage(directory_->block_page_ids_[block_idx]);
+        block_page->WLatch();
+        hash_block_page =
+            reinterpret_cast<HashTableBlockPage<KeyType, ValueType, KeyComparator> *>(block_page->GetData());
+      }
+      bool tombstone = hash_block_page->IsOccupied(slot % BLOCK_ARRAY_SIZE);
+      if (hash_block_page->Insert(slot % BLOCK_ARRAY_SIZE, entry.first, entry.second)) {
+        FilterInsert(*directory_, hash_fn_.GetHash(entry.first));
+        directory_->UpdateCounts(1, tombstone ? -1 : 0);
+        break;
+      }
+      ++slot;
+    }
+    if (slot == num_slots) {
+      wrapped.push_back(home.second);
+    }
+    next_slot = slot + 1;
+  }
+  if (block_page != nullptr) {
+    block_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(block_page->GetPageId(), true);
+  }
+
+  hash_header_page->SetCounts(directory_->num_pairs_, directory_->num_tombstones_);
+  header_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(header_page_id, true);
+  WriteFilter(*directory_);
+  table_latch_.WUnlock();
 
-  return false;
+  // the few pairs that probed past the last slot wrap around to the front of the table
+  for (size_t i : wrapped) {
+    Insert(transaction, entries[i].first, entries[i].second);
+  }
+  return entries.size();
 }
 
 /*****************************************************************************
@@ -289,69 +696,192 @@ bool HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 void HASH_TABLE_TYPE::Resize(size_t initial_size) {
-  // write lock on table latch
   table_latch_.WLock();
+  if (CompleteResize() && StartResize((2 * initial_size + BLOCK_ARRAY_SIZE - 1) / BLOCK_ARRAY_SIZE)) {
+    MigrateBlocks(old_directory_->NumBlocks());
+    FinishResize();
+  }
+  table_latch_.WUnlock();
+}
 
-  // allocate new header, acquire latch, update metadata
-  page_id_t old_header_page_id = header_page_id_;
-  auto new_page_header = buffer_pool_manager_->NewPage(&header_page_id_); 
-  new_page_header->WLatch();
-  auto new_hash_page_header = reinterpret_cast<HashTableHeaderPage*>(new_page_header->GetData());
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool HASH_TABLE_TYPE::IsResizing() {
+  table_latch_.RLock();
+  bool resizing = old_directory_ != nullptr;
+  table_latch_.RUnlock();
+  return resizing;
+}
 
-  size_t new_buckets = (2 * initial_size) / BLOCK_ARRAY_SIZE;
-  new_hash_page_header->SetSize(new_buckets);
-  new_hash_page_header->SetPageId(header_page_id_);
+template <typename KeyType, typename ValueType, typename KeyComparator>
+size_t HASH_TABLE_TYPE::ResizeTarget(const Directory &directory) const {
+  size_t num_blocks = directory.NumBlocks();
+  auto num_slots = static_cast<double>(directory.NumSlots());
+  // double the table if pairs fill it, as far as the header page can address
+  if (2 * static_cast<double>(directory.num_pairs_) > MAX_LOAD_FACTOR * num_slots) {
+    size_t doubled = std::min(2 * num_blocks, HashTableHeaderPage::MaxNumBlocks());
+    if (doubled > num_blocks) {
+      return doubled;
+    }
+  }
+  // a rebuild at the same size only drops the tombstones, which is only worth it if there are enough of them
+  if (static_cast<double>(directory.num_tombstones_) > REBUILD_TOMBSTONE_RATIO * num_slots) {
+    return num_blocks;
+  }
+  return 0;
+}
 
-  // allocate new blocks for new header
-  for (size_t bucket = 0; bucket < new_buckets; ++bucket) {   
-    page_id_t block_page_id = INVALID_PAGE_ID;
-    buffer_pool_manager_->NewPage(&block_page_id);
-    
-    // retry if allocation failed
-    if (block_page_id == INVALID_PAGE_ID) {
-      --bucket;
-      continue;
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool HASH_TABLE_TYPE::Grow(page_id_t full_header_page_id) {
+  table_latch_.WLock();
+  // the new table of a running resize filled up before the old one was migrated, finish that first
+  if (!CompleteResize()) {
+    table_latch_.WUnlock();
+    return false;
+  }
+  if (directory_->header_page_id_ != full_header_page_id) {
+    // another thread grew the table already
+    table_latch_.WUnlock();
+    return true;
+  }
+  size_t num_blocks = ResizeTarget(*directory_);
+  if (num_blocks == 0) {
+    // the table is as large as it gets, and dropping its few tombstones would not make room
+    table_latch_.WUnlock();
+    return false;
+  }
+  StartResize(num_blocks);
+  table_latch_.WUnlock();
+  return true;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool HASH_TABLE_TYPE::StartResize(size_t num_blocks) {
+  BUSTUB_ASSERT(old_directory_ == nullptr, "A resize is already running.");
+  // rebuilding at the same size is fine, it drops the tombstones
+  num_blocks = std::min(num_blocks, HashTableHeaderPage::MaxNumBlocks());
+  if (num_blocks < directory_->NumBlocks()) {
+    return false;
+  }
+
+  next_migrate_block_ = 0;
+  migrated_blocks_ = 0;
+  migration_stalled_ = false;
+  old_directory_ = std::move(directory_);
+  directory_ = NewTable(num_blocks);
+  return true;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool HASH_TABLE_TYPE::MigrateBlocks(size_t max_blocks) {
+  if (old_directory_ == nullptr) {
+    return false;
+  }
+
+  size_t old_num_blocks = old_directory_->NumBlocks();
+  bool migrated_last = false;
+  for (size_t i = 0; i < max_blocks; ++i) {
+    size_t block_idx = next_migrate_block_.fetch_add(1);
+    if (block_idx >= old_num_blocks) {
+      break;
     }
 
-    new_hash_page_header->AddBlockPageId(block_page_id);
-    buffer_pool_manager_->UnpinPage(block_page_id, false);
+    // the old block stays write latched while its pairs move, so nobody sees a pair in neither table
+    page_id_t block_page_id = old_directory_->block_page_ids_[block_idx];
+    Page *page = buffer_pool_manager_->FetchPage(block_page_id);
+    page->WLatch();
+    auto page_block = reinterpret_cast<HashTableBlockPage<KeyType, ValueType, KeyComparator> *>(page->GetData());
+    for (size_t bucket_idx = 0; bucket_idx < BLOCK_ARRAY_SIZE; ++bucket_idx) {
+      if (!page_block->IsReadable(bucket_idx)) {
+        continue;
+      }
+      if (InsertInto(directory_.get(), page_block->KeyAt(bucket_idx), page_block->ValueAt(bucket_idx)) ==
+          InsertResult::FULL) {
+        // concurrent inserts filled the new table, the rest of the block stays where it is until FinishResize grows
+        migration_stalled_ = true;
+        break;
+      }
+      page_block->Remove(bucket_idx);
+      old_directory_->UpdateCounts(-1, 1);
+    }
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(block_page_id, true);
+
+    if (migrated_blocks_.fetch_add(1) + 1 == old_num_blocks) {
+      migrated_last = true;
+    }
+  }
+  return migrated_last;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::FinishResize() {
+  if (old_directory_ == nullptr || migrated_blocks_ < old_directory_->NumBlocks()) {
+    return;
+  }
+
+  if (migration_stalled_) {
+    // pairs were left behind in the old table, move the pairs of both tables into a larger one instead. that one holds
+    // at least as many slots as both together. a new table that is as large as it gets keeps the old one around,
+    // lookups and removes keep consulting both until CompleteResize manages to migrate the rest
+    size_t num_blocks = std::min(2 * directory_->NumBlocks(), HashTableHeaderPage::MaxNumBlocks());
+    if (num_blocks == directory_->NumBlocks()) {
+      return;
+    }
+    std::unique_ptr<Directory> directory = NewTable(num_blocks);
+    MoveAll(old_directory_.get(), directory.get());
+    MoveAll(directory_.get(), directory.get());
+    DropTable(*directory_);
+    directory_ = std::move(directory);
+    migration_stalled_ = false;
+  }
+
+  DropTable(*old_directory_);
+  old_directory_.reset();
+  WriteCounts(*directory_);
+  WriteFilter(*directory_);
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool HASH_TABLE_TYPE::CompleteResize() {
+  if (old_directory_ == nullptr) {
+    return true;
+  }
+  if (migration_stalled_ && static_cast<size_t>(directory_->num_pairs_) < directory_->NumSlots()) {
+    // removes made room in the new table since the migration stalled, walk the old table once more
+    next_migrate_block_ = 0;
+    migrated_blocks_ = 0;
+    migration_stalled_ = false;
   }
+  MigrateBlocks(old_directory_->NumBlocks());
+  FinishResize();
+  return old_directory_ == nullptr;
+}
 
-  // insert <key, value> pairs into new blocks, delete olds ones
-  // get old header
-  Page* old_header_page = buffer_pool_manager_->FetchPage(old_header_page_id);
-  old_header_page->RLatch();
-  HashTableHeaderPage* old_hash_header_page = 
-    reinterpret_cast<HashTableHeaderPage*>(old_header_page->GetData());
-  
-  // iterate through each bucket of each block
-  for (size_t block = 0; block < old_hash_header_page->NumBlocks(); ++block) {
-    page_id_t block_page_id = old_hash_header_page->GetBlockPageId(block);
-    Page* page = buffer_pool_manager_->FetchPage(block_page_id);
-    page->RLatch();
-    auto page_block = reinterpret_cast
-      <HashTableBlockPage<KeyType, ValueType, KeyComparator> *>(page->GetData());
-    
-    for (size_t bucket_idx = 0; bucket_idx < BLOCK_ARRAY_SIZE; ++bucket_idx ) {
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::MoveAll(Directory *from, Directory *to) {
+  for (page_id_t block_page_id : from->block_page_ids_) {
+    Page *page = buffer_pool_manager_->FetchPage(block_page_id);
+    auto page_block = reinterpret_cast<HashTableBlockPage<KeyType, ValueType, KeyComparator> *>(page->GetData());
+    for (size_t bucket_idx = 0; bucket_idx < BLOCK_ARRAY_SIZE; ++bucket_idx) {
       if (page_block->IsReadable(bucket_idx)) {
-        KeyType key = page_block->KeyAt(bucket_idx);
-        ValueType val = page_block->ValueAt(bucket_idx);
-        Insert(nullptr, key, val);
+        [[maybe_unused]] InsertResult result =
+            InsertInto(to, page_block->KeyAt(bucket_idx), page_block->ValueAt(bucket_idx));
+        BUSTUB_ASSERT(result != InsertResult::FULL, "The target table has more slots than both tables have pairs.");
       }
     }
+    buffer_pool_manager_->UnpinPage(block_page_id, false);
+  }
+}
 
-    page->RUnlatch();
-    buffer_pool_manager_->UnpinPage(block_page_id, false); 
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::DropTable(const Directory &directory) {
+  for (page_id_t block_page_id : directory.block_page_ids_) {
     buffer_pool_manager_->DeletePage(block_page_id);
   }
-
-
-  // let go of old header
-  old_header_page->RUnlatch();
-  buffer_pool_manager_->UnpinPage(old_header_page_id, false);
-  buffer_pool_manager_->DeletePage(old_header_page_id);
-  
-  table_latch_.WUnlock();
+  for (page_id_t filter_page_id : directory.filter_page_ids_) {
+    buffer_pool_manager_->DeletePage(filter_page_id);
+  }
+  buffer_pool_manager_->DeletePage(directory.header_page_id_);
 }
 
 /*****************************************************************************
@@ -359,7 +889,13 @@ void HASH_TABLE_TYPE::Resize(size_t initial_size) {
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 size_t HASH_TABLE_TYPE::GetSize() {
-  return 0;
+  table_latch_.RLock();
+  size_t size = directory_->num_pairs_;
+  if (old_directory_ != nullptr) {
+    size += old_directory_->num_pairs_;
+  }
+  table_latch_.RUnlock();
+  return size;
 }
 
 template class LinearProbeHashTable<int, int, IntComparator>;
@@ -370,4 +906,15 @@ template class LinearProbeHashTable<GenericKey<16>, RID, GenericComparator<16>>;
 template class LinearProbeHashTable<GenericKey<32>, RID, GenericComparator<32>>;
 template class LinearProbeHashTable<GenericKey<64>, RID, GenericComparator<64>>;
 
+template class LinearProbeHashTable<GenericKey<4>, CoveringValue<16>, GenericComparator<4>>;
+template class LinearProbeHashTable<GenericKey<8>, CoveringValue<16>, GenericComparator<8>>;
+template class LinearProbeHashTable<GenericKey<16>, CoveringValue<16>, GenericComparator<16>>;
+template class LinearProbeHashTable<GenericKey<32>, CoveringValue<16>, GenericComparator<32>>;
+template class LinearProbeHashTable<GenericKey<64>, CoveringValue<16>, GenericComparator<64>>;
+template class LinearProbeHashTable<GenericKey<4>, CoveringValue<32>, GenericComparator<4>>;
+template class LinearProbeHashTable<GenericKey<8>, CoveringValue<32>, GenericComparator<8>>;
+template class LinearProbeHashTable<GenericKey<16>, CoveringValue<32>, GenericComparator<16>>;
+template class LinearProbeHashTable<GenericKey<32>, CoveringValue<32>, GenericComparator<32>>;
+template class LinearProbeHashTable<GenericKey<64>, CoveringValue<32>, GenericComparator<64>>;
+
 }  // namespace bustub
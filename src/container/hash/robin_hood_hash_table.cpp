@@ -0,0 +1,313 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// robin_hood_hash_table.cpp
+//
+// Identification: src/container/hash/robin_hood_hash_table.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/exception.h"
+#include "common/logger.h"
+#include "common/rid.h"
+#include "container/hash/robin_hood_hash_table.h"
+
+namespace bustub {
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+ROBIN_HOOD_HASH_TABLE_TYPE::RobinHoodHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
+                                               const KeyComparator &comparator, size_t num_buckets,
+                                               HashFunction<KeyType> hash_fn)
+    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {
+  header_page_id_ = NewTable(std::max<size_t>(num_buckets, 1));
+}
+
+/*****************************************************************************
+ * HELPERS
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+page_id_t ROBIN_HOOD_HASH_TABLE_TYPE::NewTable(size_t num_blocks) {
+  page_id_t header_page_id = INVALID_PAGE_ID;
+  Page *page = buffer_pool_manager_->NewPage(&header_page_id);
+  BUSTUB_ASSERT(page != nullptr, "Couldn't create a header page for the hash table.");
+  auto *header_page = reinterpret_cast<HashTableHeaderPage *>(page->GetData());
+  header_page->SetSize(num_blocks);
+  header_page->SetPageId(header_page_id);
+
+  for (size_t block = 0; block < num_blocks; ++block) {
+    page_id_t block_page_id = INVALID_PAGE_ID;
+    buffer_pool_manager_->NewPage(&block_page_id);
+    BUSTUB_ASSERT(block_page_id != INVALID_PAGE_ID, "Couldn't create a block page for the hash table.");
+    header_page->AddBlockPageId(block_page_id);
+    buffer_pool_manager_->UnpinPage(block_page_id, true);
+  }
+
+  buffer_pool_manager_->UnpinPage(header_page_id, true);
+  return header_page_id;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+size_t ROBIN_HOOD_HASH_TABLE_TYPE::Displacement(size_t slot, const KeyType &key, size_t num_slots) {
+  return (slot + num_slots - hash_fn_.GetHash(key) % num_slots) % num_slots;
+}
+
+/*****************************************************************************
+ * SEARCH
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool ROBIN_HOOD_HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key,
+                                          std::vector<ValueType> *result) {
+  table_latch_.RLock();
+  Page *page = buffer_pool_manager_->FetchPage(header_page_id_);
+  auto *header_page = reinterpret_cast<HashTableHeaderPage *>(page->GetData());
+  size_t num_slots = BLOCK_ARRAY_SIZE * header_page->NumBlocks();
+  size_t home = hash_fn_.GetHash(key) % num_slots;
+
+  bool found = false;
+  {
+    BlockCursor cursor(buffer_pool_manager_, header_page);
+    for (size_t distance = 0; distance < num_slots; ++distance) {
+      size_t slot = (home + distance) % num_slots;
+      BlockPage *block = cursor.At(slot);
+      size_t bucket_idx = slot % BLOCK_ARRAY_SIZE;
+      if (!block->IsReadable(bucket_idx)) {
+        break;
+      }
+      KeyType slot_key = block->KeyAt(bucket_idx);
+      if (comparator_(slot_key, key) == 0) {
+        result->push_back(block->ValueAt(bucket_idx));
+        found = true;
+      } else if (Displacement(slot, slot_key, num_slots) < distance) {
+        // an insert of the key would have taken this slot
+        break;
+      }
+    }
+  }
+
+  buffer_pool_manager_->UnpinPage(header_page_id_, false);
+  table_latch_.RUnlock();
+  return found;
+}
+
+/*****************************************************************************
+ * INSERTION
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool ROBIN_HOOD_HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  table_latch_.WLock();
+  Page *page = buffer_pool_manager_->FetchPage(header_page_id_);
+  size_t num_slots = BLOCK_ARRAY_SIZE * reinterpret_cast<HashTableHeaderPage *>(page->GetData())->NumBlocks();
+  buffer_pool_manager_->UnpinPage(header_page_id_, false);
+
+  if (static_cast<double>(num_pairs_ + 1) > MAX_LOAD_FACTOR * static_cast<double>(num_slots) && !Grow() &&
+      num_pairs_ == num_slots) {
+    LOG_WARN("The hash table is full.");
+    table_latch_.WUnlock();
+    return false;
+  }
+
+  page = buffer_pool_manager_->FetchPage(header_page_id_);
+  bool inserted = InsertInto(reinterpret_cast<HashTableHeaderPage *>(page->GetData()), key, value);
+  buffer_pool_manager_->UnpinPage(header_page_id_, false);
+  if (inserted) {
+    ++num_pairs_;
+  }
+  table_latch_.WUnlock();
+  return inserted;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool ROBIN_HOOD_HASH_TABLE_TYPE::InsertInto(HashTableHeaderPage *header_page, const KeyType &key,
+                                            const ValueType &value) {
+  size_t num_slots = BLOCK_ARRAY_SIZE * header_page->NumBlocks();
+  size_t slot = hash_fn_.GetHash(key) % num_slots;
+
+  BlockCursor cursor(buffer_pool_manager_, header_page);
+  KeyType carried_key = key;
+  ValueType carried_value = value;
+  size_t distance = 0;
+  // until the first pair is displaced the carried pair is the new one, and a duplicate can only show up before that
+  bool displaced = false;
+  while (true) {
+    BlockPage *block = cursor.At(slot);
+    size_t bucket_idx = slot % BLOCK_ARRAY_SIZE;
+    if (!block->IsReadable(bucket_idx)) {
+      block->Insert(bucket_idx, carried_key, carried_value);
+      cursor.MarkDirty();
+      return true;
+    }
+
+    KeyType slot_key = block->KeyAt(bucket_idx);
+    ValueType slot_value = block->ValueAt(bucket_idx);
+    if (!displaced && comparator_(slot_key, key) == 0 && slot_value == value) {
+      // duplicate values for the same key are not allowed
+      return false;
+    }
+    size_t slot_distance = Displacement(slot, slot_key, num_slots);
+    if (slot_distance < distance) {
+      // take from the rich: the pair closer to its home slot moves on
+      block->Remove(bucket_idx);
+      block->Insert(bucket_idx, carried_key, carried_value);
+      cursor.MarkDirty();
+      carried_key = slot_key;
+      carried_value = slot_value;
+      distance = slot_distance;
+      displaced = true;
+    }
+    slot = (slot + 1) % num_slots;
+    ++distance;
+  }
+}
+
+/*****************************************************************************
+ * REMOVE
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool ROBIN_HOOD_HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  table_latch_.WLock();
+  Page *page = buffer_pool_manager_->FetchPage(header_page_id_);
+  auto *header_page = reinterpret_cast<HashTableHeaderPage *>(page->GetData());
+  size_t num_slots = BLOCK_ARRAY_SIZE * header_page->NumBlocks();
+  size_t home = hash_fn_.GetHash(key) % num_slots;
+
+  bool removed = false;
+  {
+    BlockCursor cursor(buffer_pool_manager_, header_page);
+    size_t slot = num_slots;
+    for (size_t distance = 0; distance < num_slots; ++distance) {
+      size_t probe_slot = (home + distance) % num_slots;
+      BlockPage *block = cursor.At(probe_slot);
+      size_t bucket_idx = probe_slot % BLOCK_ARRAY_SIZE;
+      if (!block->IsReadable(bucket_idx)) {
+        break;
+      }
+      KeyType slot_key = block->KeyAt(bucket_idx);
+      if (comparator_(slot_key, key) == 0) {
+        if (block->ValueAt(bucket_idx) == value) {
+          slot = probe_slot;
+          break;
+        }
+      } else if (Displacement(probe_slot, slot_key, num_slots) < distance) {
+        break;
+      }
+    }
+
+    if (slot != num_slots) {
+      // shift the rest of the chain back by one, up to the first free slot or pair that is in its home slot
+      BlockCursor next_cursor(buffer_pool_manager_, header_page);
+      while (true) {
+        BlockPage *block = cursor.At(slot);
+        size_t next_slot = (slot + 1) % num_slots;
+        BlockPage *next_block = next_cursor.At(next_slot);
+        size_t next_bucket_idx = next_slot % BLOCK_ARRAY_SIZE;
+        block->Remove(slot % BLOCK_ARRAY_SIZE);
+        cursor.MarkDirty();
+        if (!next_block->IsReadable(next_bucket_idx) ||
+            Displacement(next_slot, next_block->KeyAt(next_bucket_idx), num_slots) == 0) {
+          break;
+        }
+        block->Insert(slot % BLOCK_ARRAY_SIZE, next_block->KeyAt(next_bucket_idx),
+                      next_block->ValueAt(next_bucket_idx));
+        slot = next_slot;
+      }
+      removed = true;
+      --num_pairs_;
+    }
+  }
+
+  buffer_pool_manager_->UnpinPage(header_page_id_, false);
+  table_latch_.WUnlock();
+  return removed;
+}
+
+/*****************************************************************************
+ * GROW
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+bool ROBIN_HOOD_HASH_TABLE_TYPE::Grow() {
+  Page *old_page = buffer_pool_manager_->FetchPage(header_page_id_);
+  auto *old_header_page = reinterpret_cast<HashTableHeaderPage *>(old_page->GetData());
+  size_t old_num_blocks = old_header_page->NumBlocks();
+  size_t num_blocks = std::min(2 * old_num_blocks, HashTableHeaderPage::MaxNumBlocks());
+  if (num_blocks <= old_num_blocks) {
+    buffer_pool_manager_->UnpinPage(header_page_id_, false);
+    return false;
+  }
+
+  page_id_t header_page_id = NewTable(num_blocks);
+  Page *page = buffer_pool_manager_->FetchPage(header_page_id);
+  auto *header_page = reinterpret_cast<HashTableHeaderPage *>(page->GetData());
+  for (size_t block_idx = 0; block_idx < old_num_blocks; ++block_idx) {
+    page_id_t block_page_id = old_header_page->GetBlockPageId(block_idx);
+    auto *block = reinterpret_cast<BlockPage *>(buffer_pool_manager_->FetchPage(block_page_id)->GetData());
+    for (size_t bucket_idx = 0; bucket_idx < BLOCK_ARRAY_SIZE; ++bucket_idx) {
+      if (block->IsReadable(bucket_idx)) {
+        InsertInto(header_page, block->KeyAt(bucket_idx), block->ValueAt(bucket_idx));
+      }
+    }
+    buffer_pool_manager_->UnpinPage(block_page_id, false);
+    buffer_pool_manager_->DeletePage(block_page_id);
+  }
+  buffer_pool_manager_->UnpinPage(header_page_id, false);
+
+  buffer_pool_manager_->UnpinPage(header_page_id_, false);
+  buffer_pool_manager_->DeletePage(header_page_id_);
+  header_page_id_ = header_page_id;
+  return true;
+}
+
+/*****************************************************************************
+ * GETSIZE
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+size_t ROBIN_HOOD_HASH_TABLE_TYPE::GetSize() {
+  table_latch_.RLock();
+  size_t num_pairs = num_pairs_;
+  table_latch_.RUnlock();
+  return num_pairs;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+std::vector<size_t> ROBIN_HOOD_HASH_TABLE_TYPE::GetProbeLengthHistogram() {
+  table_latch_.RLock();
+  Page *page = buffer_pool_manager_->FetchPage(header_page_id_);
+  auto *header_page = reinterpret_cast<HashTableHeaderPage *>(page->GetData());
+  size_t num_slots = BLOCK_ARRAY_SIZE * header_page->NumBlocks();
+
+  std::vector<size_t> histogram;
+  {
+    BlockCursor cursor(buffer_pool_manager_, header_page);
+    for (size_t slot = 0; slot < num_slots; ++slot) {
+      BlockPage *block = cursor.At(slot);
+      if (block->IsReadable(slot % BLOCK_ARRAY_SIZE)) {
+        size_t distance = Displacement(slot, block->KeyAt(slot % BLOCK_ARRAY_SIZE), num_slots);
+        if (distance >= histogram.size()) {
+          histogram.resize(distance + 1, 0);
+        }
+        ++histogram[distance];
+      }
+    }
+  }
+
+  buffer_pool_manager_->UnpinPage(header_page_id_, false);
+  table_latch_.RUnlock();
+  return histogram;
+}
+
+template class RobinHoodHashTable<int, int, IntComparator>;
+
+template class RobinHoodHashTable<GenericKey<4>, RID, GenericComparator<4>>;
+template class RobinHoodHashTable<GenericKey<8>, RID, GenericComparator<8>>;
+template class RobinHoodHashTable<GenericKey<16>, RID, GenericComparator<16>>;
+template class RobinHoodHashTable<GenericKey<32>, RID, GenericComparator<32>>;
+template class RobinHoodHashTable<GenericKey<64>, RID, GenericComparator<64>>;
+
+}  // namespace bustub
@@ -0,0 +1,66 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// exchange.cpp
+//
+// Identification: src/execution/exchange.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/exchange.h"
+
+#include <utility>
+
+namespace bustub {
+
+Exchange::Exchange(size_t num_producers, size_t capacity)
+    : capacity_(capacity), num_running_producers_(num_producers) {}
+
+bool Exchange::Push(std::vector<Tuple> &&batch) {
+  {
+    std::unique_lock lock(latch_);
+    not_full_.wait(lock, [this] { return is_closed_ || batches_.size() < capacity_; });
+    if (is_closed_) {
+      return false;
+    }
+    batches_.push_back(std::move(batch));
+  }
+  not_empty_.notify_one();
+  return true;
+}
+
+void Exchange::ProducerDone() {
+  {
+    std::scoped_lock lock(latch_);
+    num_running_producers_--;
+  }
+  not_empty_.notify_all();
+}
+
+bool Exchange::Pop(std::vector<Tuple> *batch) {
+  {
+    std::unique_lock lock(latch_);
+    not_empty_.wait(lock, [this] { return !batches_.empty() || num_running_producers_ == 0; });
+    if (batches_.empty()) {
+      return false;
+    }
+    *batch = std::move(batches_.front());
+    batches_.pop_front();
+  }
+  not_full_.notify_one();
+  return true;
+}
+
+void Exchange::Close() {
+  {
+    std::scoped_lock lock(latch_);
+    is_closed_ = true;
+    batches_.clear();
+  }
+  not_full_.notify_all();
+}
+
+}  // namespace bustub
@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// index_scan_executor.cpp
+//
+// Identification: src/execution/index_scan_executor.cpp
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+#include "execution/executors/index_scan_executor.h"
+
+#include <vector>
+
+namespace bustub {
+
+IndexScanExecutor::IndexScanExecutor(ExecutorContext *exec_ctx, const IndexScanPlanNode *plan)
+    : AbstractExecutor(exec_ctx), plan_(plan) {}
+
+void IndexScanExecutor::Init() {
+  SimpleCatalog *catalog = exec_ctx_->GetCatalog();
+  IndexInfo *index_info = catalog->GetIndex(plan_->GetIndexOid());
+  Index *index = index_info->index_.get();
+  Tuple key(plan_->GetKeyValues(), &index_info->key_schema_);
+  matches_.clear();
+  next_match_ = 0;
+
+  if (plan_->IsIndexOnly()) {
+    BUSTUB_ASSERT(index->IsCovering(), "An index-only scan needs a covering index.");
+    // the key columns are known from the plan, the included columns come from the index entries
+    scan_schema_ = index->GetMetadata()->GetCoveringSchema();
+    const Schema *included_schema = index->GetIncludedSchema();
+    std::vector<Tuple> included;
+    index->ScanKeyIncluded(key, &included, exec_ctx_->GetTransaction());
+    for (const auto &entry : included) {
+      std::vector<Value> values(plan_->GetKeyValues());
+      for (uint32_t i = 0; i < included_schema->GetColumnCount(); i++) {
+        values.push_back(entry.GetValue(included_schema, i));
+      }
+      matches_.emplace_back(values, scan_schema_);
+    }
+    return;
+  }
+
+  TableMetadata *table_metadata = catalog->GetTable(index_info->table_name_);
+  scan_schema_ = &table_metadata->schema_;
+  std::vector<RID> rids;
+  index->ScanKey(key, &rids, exec_ctx_->GetTransaction());
+  for (const RID &rid : rids) {
+    Tuple tuple;
+    if (table_metadata->table_->GetTuple(rid, &tuple, exec_ctx_->GetTransaction())) {
+      matches_.push_back(tuple);
+    }
+  }
+}
+
+bool IndexScanExecutor::Next(Tuple *tuple) {
+  const Schema *output_schema = GetOutputSchema();
+  while (next_match_ < matches_.size()) {
+    const Tuple &match = matches_[next_match_++];
+    if (plan_->GetPredicate() != nullptr && !plan_->GetPredicate()->Evaluate(&match, scan_schema_).GetAs<bool>()) {
+      continue;
+    }
+    std::vector<Value> values;
+    values.reserve(output_schema->GetColumnCount());
+    for (const auto &column : output_schema->GetColumns()) {
+      values.push_back(column.GetExpr()->Evaluate(&match, scan_schema_));
+    }
+    *tuple = Tuple(values, output_schema);
+    return true;
+  }
+  return false;
+}
+
+}  // namespace bustub
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 #include <memory>
+#include <vector>
 
 #include "execution/executors/insert_executor.h"
 
@@ -25,6 +26,7 @@ const Schema *InsertExecutor::GetOutputSchema() { return plan_->OutputSchema();
 
 void InsertExecutor::Init() {
   table_metadata_ = exec_ctx_->GetCatalog()->GetTable(plan_->TableOid());
+  indexes_ = exec_ctx_->GetCatalog()->GetTableIndexes(table_metadata_->name_);
   // not-raw inserts take values to be inserted from child executor
   if (plan_->IsRawInsert() == false) {
     child_executor_ = ExecutorFactory::CreateExecutor(GetExecutorContext(), plan_->GetChildPlan());
@@ -33,25 +35,62 @@ void InsertExecutor::Init() {
 }
 
 bool InsertExecutor::Next([[maybe_unused]] Tuple *tuple) { 
-  // either raw or not-raw
+  // either raw or not-raw, the tuples are gathered first, large batches are then appended to the table in one go
+  std::vector<Tuple> tuples;
   if (plan_->IsRawInsert() == true) {
     size_t size = plan_->RawValues().size();
+    tuples.reserve(size);
     for (size_t i = 0; i < size; ++i) {
-      Tuple tup(plan_->RawValuesAt(i), &table_metadata_->schema_);
-      RID rid;
-      if (table_metadata_->table_->InsertTuple(tup, &rid, exec_ctx_->GetTransaction()) == false ) 
-        return false;
+      tuples.emplace_back(plan_->RawValuesAt(i), &table_metadata_->schema_);
     }
   } else {
+    // drain the child before inserting, so that it never sees the tuples we insert; the child's tuples are only
+    // valid until its next call of Next, so they are copied
     Tuple tup;
-    RID rid;
     while (child_executor_->Next(&tup)) {
-      if (table_metadata_->table_->InsertTuple(tup, &rid, exec_ctx_->GetTransaction()) == false ) 
+      tuples.push_back(tup);
+    }
+  }
+
+  Transaction *txn = exec_ctx_->GetTransaction();
+  bool pax = table_metadata_->format_ == TableFormat::PAX;
+  if (tuples.size() < BULK_INSERT_MIN_TUPLES) {
+    // small inserts go through InsertTuple, which fills the space freed on earlier pages first
+    for (const auto &tup : tuples) {
+      RID rid;
+      bool inserted = pax ? table_metadata_->pax_table_->InsertTuple(tup, &rid, txn)
+                          : table_metadata_->table_->InsertTuple(tup, &rid, txn);
+      if (inserted == false) 
         return false;
+      InsertIntoIndexes(tup, rid);
     }
+    return true;
+  }
+
+  std::vector<RID> rids;
+  bool inserted = pax ? table_metadata_->pax_table_->BulkInsert(tuples, &rids, txn)
+                      : table_metadata_->table_->BulkInsert(tuples, &rids, txn);
+  if (inserted == false) 
+    return false;
+  for (size_t i = 0; i < tuples.size(); ++i) {
+    InsertIntoIndexes(tuples[i], rids[i]);
   }
 
   return true;   
 }
 
+void InsertExecutor::InsertIntoIndexes(const Tuple &tuple, RID rid) {
+  const Schema &schema = table_metadata_->schema_;
+  for (IndexInfo *index_info : indexes_) {
+    Index *index = index_info->index_.get();
+    Tuple key = tuple.KeyFromTuple(schema, *index->GetKeySchema(), index->GetKeyAttrs());
+    if (index->IsCovering()) {
+      Tuple included = tuple.KeyFromTuple(schema, *index->GetIncludedSchema(), index->GetIncludedAttrs());
+      index->InsertEntry(key, included, rid, exec_ctx_->GetTransaction());
+    } else {
+      index->InsertEntry(key, rid, exec_ctx_->GetTransaction());
+    }
+  }
+}
+
 }  // namespace bustub
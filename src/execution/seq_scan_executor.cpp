@@ -11,25 +11,225 @@
 //===----------------------------------------------------------------------===//
 #include "execution/executors/seq_scan_executor.h"
 
+#include <utility>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+
 namespace bustub {
 
+namespace {
+
+/** The number of morsels per worker of a parallel scan, more morsels balance the load better. */
+constexpr size_t MORSELS_PER_WORKER = 4;
+/** The number of batches per worker the exchange of a parallel scan holds. */
+constexpr size_t BATCHES_PER_WORKER = 2;
+
+/** @return the comparison with its operands swapped, i.e. constant < column becomes column > constant */
+ComparisonType Flip(ComparisonType comp_type) {
+  switch (comp_type) {
+    case ComparisonType::LessThan:
+      return ComparisonType::GreaterThan;
+    case ComparisonType::LessThanOrEqual:
+      return ComparisonType::GreaterThanOrEqual;
+    case ComparisonType::GreaterThan:
+      return ComparisonType::LessThan;
+    case ComparisonType::GreaterThanOrEqual:
+      return ComparisonType::LessThanOrEqual;
+    default:
+      return comp_type;
+  }
+}
+
+/** @return false if no value within the summary can satisfy (value comp_type constant) */
+bool MayMatch(const ColumnSummary &summary, ComparisonType comp_type, const Value &constant) {
+  // nulls compare to neither true nor false, so leave the pages that hold any to the predicate
+  if (summary.null_count_ > 0 || !summary.has_values_) {
+    return true;
+  }
+  auto maybe = [](CmpBool cmp) { return cmp != CmpBool::CmpFalse; };
+  const Value &min = summary.min_;
+  const Value &max = summary.max_;
+  switch (comp_type) {
+    case ComparisonType::Equal:
+      return maybe(min.CompareLessThanEquals(constant)) && maybe(max.CompareGreaterThanEquals(constant));
+    case ComparisonType::NotEqual:
+      return maybe(min.CompareNotEquals(constant)) || maybe(max.CompareNotEquals(constant));
+    case ComparisonType::LessThan:
+      return maybe(min.CompareLessThan(constant));
+    case ComparisonType::LessThanOrEqual:
+      return maybe(min.CompareLessThanEquals(constant));
+    case ComparisonType::GreaterThan:
+      return maybe(max.CompareGreaterThan(constant));
+    case ComparisonType::GreaterThanOrEqual:
+      return maybe(max.CompareGreaterThanEquals(constant));
+    default:
+      return true;
+  }
+}
+
+}  // namespace
+
 SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan) : 
-    AbstractExecutor(exec_ctx), plan_(plan) {}
+    AbstractExecutor(exec_ctx), plan_(plan), arena_(exec_ctx->CreateArena()) {}
 
 void SeqScanExecutor::Init() {
+  StopWorkers();
   table_metadata_ = exec_ctx_->GetCatalog()->GetTable(plan_->GetTableOid());
-  table_iter_ = std::make_unique<TableIterator>(table_metadata_->table_->Begin(exec_ctx_->GetTransaction()));
+  if (table_metadata_->format_ == TableFormat::PAX) {
+    pax_iter_ = std::make_unique<PaxScanIterator>(table_metadata_->pax_table_.get());
+  } else {
+    std::vector<page_id_t> page_ids;
+    iter_.reset();
+    pages_skipped_ = 0;
+    bool is_pruned = PrunePages(&page_ids);
+    if (plan_->GetNumWorkers() > 1 && !enable_logging) {
+      StartWorkers(is_pruned ? page_ids : table_metadata_->table_->GetPageIds());
+    } else if (is_pruned) {
+      iter_ = std::make_unique<TableBatchIterator>(table_metadata_->table_.get(), std::move(page_ids),
+                                                   exec_ctx_->GetTransaction());
+    } else {
+      iter_ = std::make_unique<TableBatchIterator>(table_metadata_->table_.get(), exec_ctx_->GetTransaction());
+    }
+  }
+  batch_.clear();
+  cursor_ = 0;
 }
 
-bool SeqScanExecutor::Next(Tuple *tuple) { 
-  auto end_iter = table_metadata_->table_->End();
-  while (*table_iter_ != end_iter) {
-    *tuple = **table_iter_;
-    ++(*table_iter_);
-    if (!plan_->GetPredicate() || plan_->GetPredicate()->Evaluate(tuple, &table_metadata_->schema_).GetAs<bool>()) 
-      return true;
+bool SeqScanExecutor::Next(Tuple *tuple) {
+  while (cursor_ == batch_.size()) {
+    batch_.clear();
+    cursor_ = 0;
+    if (!NextPage()) {
+      return false;
+    }
+  }
+  *tuple = std::move(batch_[cursor_++]);
+  return true;
+}
+
+bool SeqScanExecutor::PrunePages(std::vector<page_id_t> *page_ids) {
+  ZoneMap *zone_map = table_metadata_->table_->GetZoneMap();
+  const auto *comparison = dynamic_cast<const ComparisonExpression *>(plan_->GetPredicate());
+  if (zone_map == nullptr || comparison == nullptr) {
+    return false;
+  }
+  // column op constant, or constant op column
+  ComparisonType comp_type = comparison->GetComparisonType();
+  const auto *column = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(0));
+  const auto *constant = dynamic_cast<const ConstantValueExpression *>(comparison->GetChildAt(1));
+  if (column == nullptr || constant == nullptr) {
+    column = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(1));
+    constant = dynamic_cast<const ConstantValueExpression *>(comparison->GetChildAt(0));
+    comp_type = Flip(comp_type);
+  }
+  if (column == nullptr || constant == nullptr || !zone_map->IsSummarized(column->GetColIdx())) {
+    return false;
+  }
+
+  for (page_id_t page_id : zone_map->GetPageIds()) {
+    ColumnSummary summary;
+    if (zone_map->GetNumTuples(page_id) == 0 ||
+        (zone_map->GetSummary(page_id, column->GetColIdx(), &summary) &&
+         !MayMatch(summary, comp_type, constant->GetValue()))) {
+      pages_skipped_++;
+      continue;
+    }
+    page_ids->push_back(page_id);
+  }
+  return true;
+}
+
+ScanStats SeqScanExecutor::GetStats() const {
+  ScanStats stats;
+  if (iter_ != nullptr) {
+    stats.pages_read_ = iter_->GetNumPagesRead();
+  } else if (workers_ != nullptr) {
+    stats.pages_read_ = pages_read_;
+  }
+  stats.pages_skipped_ = pages_skipped_;
+  return stats;
+}
+
+bool SeqScanExecutor::NextPage() {
+  const AbstractExpression *predicate = plan_->GetPredicate();
+  const Schema *schema = &table_metadata_->schema_;
+  if (pax_iter_ != nullptr) {
+    if (!pax_iter_->NextPage()) {
+      return false;
+    }
+    pax_tuples_.clear();
+    pax_iter_->GetTuples(&pax_tuples_);
+    pax_iter_->ReleasePage();
+    for (auto &pax_tuple : pax_tuples_) {
+      if (!predicate || predicate->Evaluate(&pax_tuple, schema).GetAs<bool>()) {
+        batch_.push_back(std::move(pax_tuple));
+      }
+    }
+    return true;
+  }
+
+  if (exchange_ != nullptr) {
+    return exchange_->Pop(&batch_);
+  }
+  if (!iter_->NextBatch(&views_)) {
+    return false;
+  }
+  // the parent is done with the tuples of the previous page, which were returned by earlier calls of Next
+  arena_->Reset();
+  Filter(views_, &batch_, arena_);
+  // the matches are copied, so the page need not stay latched while the parent consumes them
+  iter_->ReleasePage();
+  return true;
+}
+
+void SeqScanExecutor::Filter(const std::vector<TupleView> &views, std::vector<Tuple> *matches,
+                             AbstractPool *pool) const {
+  const AbstractExpression *predicate = plan_->GetPredicate();
+  const Schema *schema = &table_metadata_->schema_;
+  for (const auto &view : views) {
+    if (!predicate || predicate->Evaluate(&view.AsTuple(), schema).GetAs<bool>()) {
+      matches->push_back(pool == nullptr ? view.ToTuple() : view.ToTuple(pool));
+    }
+  }
+}
+
+void SeqScanExecutor::StartWorkers(const std::vector<page_id_t> &page_ids) {
+  size_t num_workers = plan_->GetNumWorkers();
+  auto morsels = TableHeap::SplitPages(page_ids, num_workers * MORSELS_PER_WORKER);
+  pages_read_ = 0;
+  exchange_ = std::make_unique<Exchange>(morsels.size(), num_workers * BATCHES_PER_WORKER);
+  workers_ = std::make_unique<WorkerPool>(num_workers);
+  for (auto &morsel : morsels) {
+    workers_->Submit([this, morsel = std::move(morsel)] { ScanMorsel(morsel); });
+  }
+}
+
+void SeqScanExecutor::ScanMorsel(const std::vector<page_id_t> &page_ids) {
+  TableBatchIterator iter(table_metadata_->table_.get(), page_ids, exec_ctx_->GetTransaction());
+  std::vector<TupleView> views;
+  bool is_open = true;
+  while (is_open && iter.NextBatch(&views)) {
+    std::vector<Tuple> matches;
+    // workers run concurrently and the arena is not thread safe, so their matches get memory of their own
+    Filter(views, &matches, nullptr);
+    iter.ReleasePage();
+    // stop early once the consumer closed the exchange
+    is_open = matches.empty() || exchange_->Push(std::move(matches));
+  }
+  iter.ReleasePage();
+  pages_read_ += iter.GetNumPagesRead();
+  exchange_->ProducerDone();
+}
+
+void SeqScanExecutor::StopWorkers() {
+  if (exchange_ != nullptr) {
+    // wake the workers waiting for room, so they see the exchange is closed and finish
+    exchange_->Close();
   }
-  return false;  
+  workers_.reset();
+  exchange_.reset();
 }
 
 }  // namespace bustub
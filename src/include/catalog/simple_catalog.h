@@ -2,12 +2,17 @@
 
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "buffer/buffer_pool_manager.h"
 #include "catalog/schema.h"
+#include "container/hash/hash_function.h"
 #include "storage/index/index.h"
+#include "storage/index/linear_probe_hash_table_index.h"
+#include "storage/table/pax_table_heap.h"
 #include "storage/table/table_heap.h"
 
 namespace bustub {
@@ -17,22 +22,61 @@ namespace bustub {
  */
 using table_oid_t = uint32_t;
 using column_oid_t = uint32_t;
+using index_oid_t = uint32_t;
 
 /**
- * Metadata about a table.
+ * The storage format of a table.
+ */
+enum class TableFormat {
+  /** Slotted pages of whole tuples, see TablePage. */
+  ROW,
+  /** Pages of column minipages, see PaxPage. */
+  PAX
+};
+
+/**
+ * Metadata about a table. Depending on its format, either table_ or pax_table_ holds the tuples.
  */
 struct TableMetadata {
   TableMetadata(Schema schema, std::string name, std::unique_ptr<TableHeap> &&table, table_oid_t oid)
       : schema_(std::move(schema)), name_(std::move(name)), table_(std::move(table)), oid_(oid) {}
+  TableMetadata(Schema schema, std::string name, std::unique_ptr<PaxTableHeap> &&pax_table, table_oid_t oid)
+      : schema_(std::move(schema)),
+        name_(std::move(name)),
+        format_(TableFormat::PAX),
+        pax_table_(std::move(pax_table)),
+        oid_(oid) {}
   Schema schema_;
   std::string name_;
+  TableFormat format_{TableFormat::ROW};
   std::unique_ptr<TableHeap> table_;
+  std::unique_ptr<PaxTableHeap> pax_table_;
   table_oid_t oid_;
 };
 
+/**
+ * Metadata about an index.
+ */
+struct IndexInfo {
+  IndexInfo(Schema key_schema, std::string name, std::unique_ptr<Index> &&index, index_oid_t index_oid,
+            std::string table_name, size_t key_size)
+      : key_schema_(std::move(key_schema)),
+        name_(std::move(name)),
+        index_(std::move(index)),
+        index_oid_(index_oid),
+        table_name_(std::move(table_name)),
+        key_size_(key_size) {}
+  Schema key_schema_;
+  std::string name_;
+  std::unique_ptr<Index> index_;
+  index_oid_t index_oid_;
+  std::string table_name_;
+  const size_t key_size_;
+};
+
 /**
  * SimpleCatalog is a non-persistent catalog that is designed for the executor to use.
- * It handles table creation and table lookup.
+ * It handles table and index creation and lookup.
  */
 class SimpleCatalog {
  public:
@@ -46,20 +90,30 @@ class SimpleCatalog {
       : bpm_{bpm}, lock_manager_{lock_manager}, log_manager_{log_manager} {}
 
   /**
-   * Create a new table and return its metadata.
+   * Create a new table and return its metadata. Tables in the row format keep a zone map for scans to skip pages.
    * @param txn the transaction in which the table is being created
    * @param table_name the name of the new table
    * @param schema the schema of the new table
+   * @param format the storage format of the new table
    * @return a pointer to the metadata of the new table
    */
-  TableMetadata *CreateTable(Transaction *txn, const std::string &table_name, const Schema &schema) {
+  TableMetadata *CreateTable(Transaction *txn, const std::string &table_name, const Schema &schema,
+                             TableFormat format = TableFormat::ROW) {
     BUSTUB_ASSERT(names_.count(table_name) == 0, "Table names should be unique!");
     table_oid_t current_id = next_table_oid_++;
     names_.insert({table_name, current_id});
 
-    TableHeap* table_heap = new TableHeap(bpm_, lock_manager_, log_manager_, txn);
-    TableMetadata* table_metadata = new TableMetadata(schema, table_name,
-                            static_cast<std::unique_ptr<TableHeap>>(table_heap), current_id);
+    TableMetadata *table_metadata;
+    if (format == TableFormat::PAX) {
+      table_metadata = new TableMetadata(schema, table_name, std::make_unique<PaxTableHeap>(bpm_, schema, txn),
+                                         current_id);
+    } else {
+      TableHeap* table_heap = new TableHeap(bpm_, lock_manager_, log_manager_, txn);
+      table_heap->CreateZoneMap(schema);
+      table_heap->EnableOverflow(schema);
+      table_metadata = new TableMetadata(schema, table_name,
+                              static_cast<std::unique_ptr<TableHeap>>(table_heap), current_id);
+    }
     tables_.insert({current_id, static_cast<std::unique_ptr<TableMetadata>>(table_metadata)});
     
     return table_metadata;
@@ -84,7 +138,100 @@ class SimpleCatalog {
     return (table->second).get();
   }
 
+  /**
+   * Create a new hash index on a table, load it with the tuples already in the table and return its metadata.
+   * @param txn the transaction in which the index is being created
+   * @param index_name the name of the new index
+   * @param table_name the name of the indexed table
+   * @param schema the schema of the indexed table
+   * @param key_attrs the columns of the table that make up the key
+   * @param key_size the size of the key type
+   * @param included_attrs the columns of the table the index stores next to the key, which makes it a covering
+   * index when ValueType is a CoveringValue
+   * @return a pointer to the metadata of the new index, nullptr if key_size is not the size of KeyType, or the key or
+   * the included columns do not fit into KeyType and ValueType
+   */
+  template <class KeyType, class ValueType, class KeyComparator>
+  IndexInfo *CreateIndex(Transaction *txn, const std::string &index_name, const std::string &table_name,
+                         const Schema &schema, const std::vector<uint32_t> &key_attrs, size_t key_size,
+                         const std::vector<uint32_t> &included_attrs = {}) {
+    BUSTUB_ASSERT(index_names_[table_name].count(index_name) == 0, "Index names should be unique per table!");
+    BUSTUB_ASSERT((included_attrs.empty() == std::is_same_v<ValueType, RID>),
+                  "Only an index with covering values stores included columns!");
+    BUSTUB_ASSERT(GetTable(table_name)->format_ == TableFormat::ROW, "Only tables in the row format can be indexed!");
+    auto *metadata = new IndexMetadata(index_name, table_name, &schema, key_attrs, included_attrs);
+    if (!FitsIndexTypes<KeyType, ValueType>(*metadata, key_size)) {
+      delete metadata;
+      return nullptr;
+    }
+    index_oid_t current_id = next_index_oid_++;
+    index_names_[table_name].insert({index_name, current_id});
+
+    auto index = std::make_unique<LinearProbeHashTableIndex<KeyType, ValueType, KeyComparator>>(
+        metadata, bpm_, INDEX_NUM_BUCKETS, HashFunction<KeyType>());
+    index->BulkLoad(GetTable(table_name)->table_.get(), schema, txn);
+
+    Schema key_schema = *metadata->GetKeySchema();
+    auto *index_info = new IndexInfo(key_schema, index_name, std::move(index), current_id, table_name, key_size);
+    indexes_.insert({current_id, std::unique_ptr<IndexInfo>(index_info)});
+    return index_info;
+  }
+
+  /** @return index metadata by index name and table name */
+  IndexInfo *GetIndex(const std::string &index_name, const std::string &table_name) {
+    auto table_indexes = index_names_.find(table_name);
+    if (table_indexes == index_names_.end()) {
+      throw std::out_of_range("Table has no indexes!");
+    }
+    auto index_id = table_indexes->second.find(index_name);
+    if (index_id == table_indexes->second.end()) {
+      throw std::out_of_range("Index name does not exist!");
+    }
+    return GetIndex(index_id->second);
+  }
+
+  /** @return index metadata by index oid */
+  IndexInfo *GetIndex(index_oid_t index_oid) {
+    auto index = indexes_.find(index_oid);
+    if (index == indexes_.end()) {
+      throw std::out_of_range("Index id does not exist!");
+    }
+    return (index->second).get();
+  }
+
+  /** @return all of the indexes on the table with the given name */
+  std::vector<IndexInfo *> GetTableIndexes(const std::string &table_name) {
+    std::vector<IndexInfo *> result;
+    auto table_indexes = index_names_.find(table_name);
+    if (table_indexes != index_names_.end()) {
+      for (const auto &index_name : table_indexes->second) {
+        result.push_back(GetIndex(index_name.second));
+      }
+    }
+    return result;
+  }
+
  private:
+  /**
+   * @return true if the keys of an index are key_size bytes long, which KeyType is as well, and its key and included
+   * columns fit into KeyType and ValueType. Included columns are copied as they are, so they must all be inlined.
+   */
+  template <class KeyType, class ValueType>
+  static bool FitsIndexTypes(const IndexMetadata &metadata, size_t key_size) {
+    const Schema *key_schema = metadata.GetKeySchema();
+    if (key_size != sizeof(KeyType) || (key_schema->IsInlined() && key_schema->GetLength() > key_size)) {
+      return false;
+    }
+    if constexpr (!std::is_same_v<ValueType, RID>) {
+      const Schema *included_schema = metadata.GetIncludedSchema();
+      return included_schema->IsInlined() && included_schema->GetLength() <= ValueType::INCLUDED_SIZE;
+    }
+    return true;
+  }
+
+  /** The number of buckets a new index starts with, it grows as tuples are inserted. */
+  static constexpr size_t INDEX_NUM_BUCKETS = 64;
+
   [[maybe_unused]] BufferPoolManager *bpm_;
   [[maybe_unused]] LockManager *lock_manager_;
   [[maybe_unused]] LogManager *log_manager_;
@@ -95,5 +242,12 @@ class SimpleCatalog {
   std::unordered_map<std::string, table_oid_t> names_;
   /** The next table identifier to be used. */
   std::atomic<table_oid_t> next_table_oid_{0};
+
+  /** indexes_: index identifiers -> index metadata. Note that indexes_ owns all index metadata. */
+  std::unordered_map<index_oid_t, std::unique_ptr<IndexInfo>> indexes_;
+  /** index_names_: table name -> index names -> index identifiers */
+  std::unordered_map<std::string, std::unordered_map<std::string, index_oid_t>> index_names_;
+  /** The next index identifier to be used. */
+  std::atomic<index_oid_t> next_index_oid_{0};
 };
 }  // namespace bustub
@@ -45,6 +45,8 @@ enum class ExceptionType {
   INCOMPATIBLE_TYPE = 8,
   /** Method not implemented. */
   NOT_IMPLEMENTED = 11,
+  /** A key that is already in a unique index. */
+  DUPLICATE_KEY = 12,
 };
 
 class Exception : public std::runtime_error {
@@ -81,6 +83,8 @@ class Exception : public std::runtime_error {
         return "Incompatible type";
       case ExceptionType::NOT_IMPLEMENTED:
         return "Not implemented";
+      case ExceptionType::DUPLICATE_KEY:
+        return "Duplicate key";
       default:
         return "Unknown";
     }
@@ -0,0 +1,63 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// worker_pool.h
+//
+// Identification: src/include/common/worker_pool.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <functional>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/macros.h"
+
+namespace bustub {
+
+/**
+ * WorkerPool runs tasks on a fixed number of threads. Tasks are started in the order they were submitted, each on the
+ * first worker that becomes idle.
+ */
+class WorkerPool {
+ public:
+  /**
+   * Starts the workers.
+   * @param num_workers the number of threads
+   */
+  explicit WorkerPool(size_t num_workers);
+
+  /** Waits for the running tasks to finish and stops the workers. Tasks that have not started yet are dropped. */
+  ~WorkerPool();
+
+  DISALLOW_COPY_AND_MOVE(WorkerPool);
+
+  /**
+   * Queues a task.
+   * @param task the task to run on a worker
+   */
+  void Submit(std::function<void()> task);
+
+  /** @return the number of threads */
+  size_t GetNumWorkers() const { return workers_.size(); }
+
+ private:
+  /** Runs tasks until the pool stops. */
+  void Work();
+
+  std::mutex latch_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  bool is_stopped_{false};
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace bustub
@@ -39,7 +39,7 @@ enum class TransactionState { GROWING, SHRINKING, COMMITTED, ABORTED };
 /**
  * Type of write operation.
  */
-enum class WType { INSERT = 0, DELETE, UPDATE };
+enum class WType { INSERT = 0, DELETE, UPDATE, UPDATECOLUMN };
 
 class TableHeap;
 
@@ -51,12 +51,18 @@ class WriteRecord {
   WriteRecord(RID rid, WType wtype, const Tuple &tuple, TableHeap *table)
       : rid_(rid), wtype_(wtype), tuple_(tuple), table_(table) {}
 
+  WriteRecord(RID rid, uint32_t column_offset, const Value &old_value, TableHeap *table)
+      : rid_(rid), wtype_(WType::UPDATECOLUMN), table_(table), column_offset_(column_offset), old_value_(old_value) {}
+
   RID rid_;
   WType wtype_;
   /** The tuple is only used for the update operation. */
   Tuple tuple_;
   /** The table heap specifies which table this write record is for. */
   TableHeap *table_;
+  /** The offset of the column and its old value are only used for the update column operation. */
+  uint32_t column_offset_{0};
+  Value old_value_;
 };
 
 /**
@@ -0,0 +1,153 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// extendible_hash_table.h
+//
+// Identification: src/include/container/hash/extendible_hash_table.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "concurrency/transaction.h"
+#include "container/hash/hash_function.h"
+#include "container/hash/hash_table.h"
+#include "storage/page/hash_table_bucket_page.h"
+#include "storage/page/hash_table_directory_page.h"
+#include "storage/page/hash_table_page_defs.h"
+
+namespace bustub {
+
+#define EXTENDIBLE_HASH_TABLE_TYPE ExtendibleHashTable<KeyType, ValueType, KeyComparator>
+
+/**
+ * Implementation of extendible hashing that is backed by a buffer pool manager. Non-unique keys are supported.
+ * Supports insert and delete. The table grows one bucket at a time: when a bucket overflows only that bucket is
+ * split (doubling the directory if needed), and buckets that become empty are merged with their split image.
+ */
+template <typename KeyType, typename ValueType, typename KeyComparator>
+class ExtendibleHashTable : public HashTable<KeyType, ValueType, KeyComparator> {
+ public:
+  /**
+   * Creates a new ExtendibleHashTable.
+   *
+   * @param name the name of the hash table
+   * @param buffer_pool_manager buffer pool manager to be used
+   * @param comparator comparator for keys
+   * @param hash_fn the hash function
+   */
+  explicit ExtendibleHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
+                               const KeyComparator &comparator, HashFunction<KeyType> hash_fn);
+
+  /**
+   * Inserts a key-value pair into the hash table.
+   * @param transaction the current transaction
+   * @param key the key to create
+   * @param value the value to be associated with the key
+   * @return true if insert succeeded, false otherwise
+   */
+  bool Insert(Transaction *transaction, const KeyType &key, const ValueType &value) override;
+
+  /**
+   * Deletes the associated value for the given key.
+   * @param transaction the current transaction
+   * @param key the key to delete
+   * @param value the value to delete
+   * @return true if remove succeeded, false otherwise
+   */
+  bool Remove(Transaction *transaction, const KeyType &key, const ValueType &value) override;
+
+  /**
+   * Performs a point query on the hash table.
+   * @param transaction the current transaction
+   * @param key the key to look up
+   * @param[out] result the value(s) associated with a given key
+   * @return the value(s) associated with the given key
+   */
+  bool GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) override;
+
+  /**
+   * @return the global depth of the directory
+   */
+  uint32_t GetGlobalDepth();
+
+  /**
+   * Asserts the directory invariants, see HashTableDirectoryPage::VerifyIntegrity.
+   */
+  void VerifyIntegrity();
+
+ private:
+  /**
+   * Downcasts the 64-bit hash to 32 bits for extendible hashing.
+   *
+   * @param key the key to hash
+   * @return the downcasted 32-bit hash
+   */
+  inline uint32_t Hash(const KeyType &key);
+
+  /**
+   * @param key the key to look up
+   * @param dir_page the directory page
+   * @return the directory index the key hashes to
+   */
+  inline uint32_t KeyToDirectoryIndex(const KeyType &key, HashTableDirectoryPage *dir_page);
+
+  /**
+   * @param key the key to look up
+   * @param dir_page the directory page
+   * @return the page id of the bucket the key hashes to
+   */
+  inline page_id_t KeyToPageId(const KeyType &key, HashTableDirectoryPage *dir_page);
+
+  /**
+   * Fetches the directory page. The caller must unpin it.
+   * @return a pointer to the directory page
+   */
+  HashTableDirectoryPage *FetchDirectoryPage();
+
+  /**
+   * Fetches the bucket page with the given page id. The caller must unpin it.
+   * @param bucket_page_id the page id to fetch
+   * @return the buffer pool page holding the bucket
+   */
+  Page *FetchBucketPage(page_id_t bucket_page_id);
+
+  /**
+   * Inserts under the table write latch, splitting the target bucket until the key fits.
+   *
+   * @param transaction the current transaction
+   * @param key the key to insert
+   * @param value the value to insert
+   * @return true if the insert succeeded
+   */
+  bool SplitInsert(Transaction *transaction, const KeyType &key, const ValueType &value);
+
+  /**
+   * Merges the (empty) bucket the key hashes to into its split image and shrinks the directory when possible.
+   *
+   * @param transaction the current transaction
+   * @param key the key that was removed
+   */
+  void Merge(Transaction *transaction, const KeyType &key);
+
+  // member variables
+  page_id_t directory_page_id_;
+  BufferPoolManager *buffer_pool_manager_;
+  KeyComparator comparator_;
+
+  // Readers include inserts and removes that fit in their bucket, writers are splits and merges
+  ReaderWriterLatch table_latch_;
+
+  // Hash function
+  HashFunction<KeyType> hash_fn_;
+};
+
+}  // namespace bustub
@@ -12,14 +12,18 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <queue>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "buffer/buffer_pool_manager.h"
 #include "concurrency/transaction.h"
 #include "container/hash/hash_function.h"
 #include "container/hash/hash_table.h"
+#include "storage/page/bloom_filter_page.h"
 #include "storage/page/hash_table_block_page.h"
 #include "storage/page/hash_table_header_page.h"
 #include "storage/page/hash_table_page_defs.h"
@@ -31,7 +35,20 @@ namespace bustub {
 /**
  * Implementation of linear probing hash table that is backed by a buffer pool
  * manager. Non-unique keys are supported. Supports insert and delete. The
- * table dynamically grows once full.
+ * table dynamically grows once pairs and tombstones fill MAX_LOAD_FACTOR of it.
+ *
+ * Growing is incremental: a table twice the size is allocated and becomes the target of all inserts, while the old
+ * table is kept around and every following operation migrates MIGRATE_BLOCKS_PER_OP of its blocks. Until the last
+ * block is migrated, lookups and removes consult both tables. Only allocating the new table and dropping the old one
+ * take the table latch in write mode.
+ *
+ * The block directory of a table is cached in memory, so point operations only fetch the block pages they probe and
+ * never the header page.
+ *
+ * A table can keep a blocked Bloom filter of its keys. Inserts add their key to it, and lookups and removes test it
+ * before probing, so most lookups of missing keys fetch no page at all. Like the counts, the filter is used from
+ * memory and written back to pages of its own when a resize finishes and after a bulk load. Removes leave their key
+ * in the filter, every resize builds a fresh one.
  */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 class LinearProbeHashTable : public HashTable<KeyType, ValueType, KeyComparator> {
@@ -43,9 +60,11 @@ class LinearProbeHashTable : public HashTable<KeyType, ValueType, KeyComparator>
    * @param comparator comparator for keys
    * @param num_buckets initial number of buckets contained by this hash table
    * @param hash_fn the hash function
+   * @param use_bloom_filter whether to keep a Bloom filter of the keys
    */
   explicit LinearProbeHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
-                                const KeyComparator &comparator, size_t num_buckets, HashFunction<KeyType> hash_fn);
+                                const KeyComparator &comparator, size_t num_buckets, HashFunction<KeyType> hash_fn,
+                                bool use_bloom_filter = false);
 
   /**
    * Inserts a key-value pair into the hash table.
@@ -75,26 +94,313 @@ class LinearProbeHashTable : public HashTable<KeyType, ValueType, KeyComparator>
   bool GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) override;
 
   /**
-   * Resizes the table to at least twice the initial size provided.
+   * Performs point queries for a batch of keys. The keys are grouped by the block page their probe is at, so each
+   * block page is fetched and latched once per batch rather than once per key, and the home slots of a group are
+   * prefetched before any of their probes run.
+   * @param transaction the current transaction
+   * @param keys the keys to look up
+   * @param[out] results the values associated with keys[i] are stored in results[i]
+   */
+  void GetValues(Transaction *transaction, const std::vector<KeyType> &keys,
+                 std::vector<std::vector<ValueType>> *results);
+
+  /**
+   * Loads many pairs at once. The table is first grown so the pairs fill at most half of it, then the pairs are
+   * placed in the order of their home slot, so each block page is fetched once and written front to back instead of
+   * once per pair. Pairs that would probe past the last slot are inserted normally afterwards, and so is everything if
+   * the table has to grow while it already holds pairs. The pairs are assumed to be distinct.
+   *
+   * @param transaction the current transaction
+   * @param entries the pairs to load
+   * @return the number of pairs loaded
+   */
+  size_t BulkLoad(Transaction *transaction, const std::vector<std::pair<KeyType, ValueType>> &entries);
+
+  /**
+   * Resizes the table to at least twice the initial size provided, migrating every pair before returning.
    * @param initial_size the initial size of the hash table
    */
   void Resize(size_t initial_size);
 
   /**
-   * Gets the size of the hash table
-   * @return current size of the hash table
+   * @return true while pairs are being migrated from the old table into the new one
+   */
+  bool IsResizing();
+
+  /**
+   * @return the fraction of the slots of the table that hold tombstones
+   */
+  double GetTombstoneRatio();
+
+  /**
+   * @return the number of block compactions run so far
+   */
+  size_t GetNumCompactions() const { return num_compactions_; }
+
+  /**
+   * @return the number of tombstones compactions turned back into never occupied slots
+   */
+  size_t GetNumTombstonesCleared() const { return num_tombstones_cleared_; }
+
+  /**
+   * @return the number of lookups and removes the Bloom filter answered without probing the table
+   */
+  size_t GetNumFilterNegatives() const { return num_filter_negatives_; }
+
+  /**
+   * Gets the size of the hash table, from the pair counts kept with the directories.
+   * @return the number of pairs in the hash table
    */
   size_t GetSize();
 
  private:
+  /** Outcome of inserting into a single table. */
+  enum class InsertResult { INSERTED, DUPLICATE, FULL };
+
+  /** The number of old blocks every operation migrates while the table is resizing. */
+  static constexpr size_t MIGRATE_BLOCKS_PER_OP = 1;
+
+  /** An insert starts growing the table once pairs and tombstones take up this fraction of it. */
+  static constexpr double MAX_LOAD_FACTOR = 0.75;
+
+  /** A table that cannot double is only rebuilt at the same size once tombstones take up this fraction of it. */
+  static constexpr double REBUILD_TOMBSTONE_RATIO = MAX_LOAD_FACTOR / 2;
+
+  /** A remove compacts its block once tombstones take up this fraction of it. */
+  static constexpr double COMPACT_TOMBSTONE_RATIO = 0.25;
+
+  /**
+   * The size of the Bloom filter per slot of the table. Growing before MAX_LOAD_FACTOR leaves at least 10.7 bits per
+   * pair, for a false positive rate around 1%.
+   */
+  static constexpr size_t BLOOM_FILTER_BITS_PER_SLOT = 8;
+
+  /**
+   * Immutable in-memory copy of the header page of a table, so point operations find their block pages without
+   * fetching and latching the header page. Growing builds a new table with its own directory, which replaces this one
+   * while the table latch is held in write mode. Every operation holds the table latch in read mode for as long as it
+   * uses a directory, so a replaced directory is only freed once no operation can still see it.
+   *
+   * The pair and tombstone counts and the Bloom filter are the exception to immutability: they are kept up to date
+   * here, and written back to their pages when a resize finishes and after a bulk load.
+   */
+  struct Directory {
+    Directory(page_id_t header_page_id, std::vector<page_id_t> block_page_ids, std::vector<page_id_t> filter_page_ids)
+        : header_page_id_(header_page_id),
+          block_page_ids_(std::move(block_page_ids)),
+          filter_page_ids_(std::move(filter_page_ids)),
+          filter_data_(new char[filter_page_ids_.size() * PAGE_SIZE]()) {
+      for (size_t i = 0; i < filter_page_ids_.size(); ++i) {
+        FilterPage(i)->SetNextPageId(i + 1 < filter_page_ids_.size() ? filter_page_ids_[i + 1] : INVALID_PAGE_ID);
+      }
+    }
+
+    size_t NumBlocks() const { return block_page_ids_.size(); }
+
+    size_t NumSlots() const { return BLOCK_ARRAY_SIZE * block_page_ids_.size(); }
+
+    /** @return the in-memory copy of a page of the Bloom filter */
+    BloomFilterPage *FilterPage(size_t filter_page_idx) const {
+      return reinterpret_cast<BloomFilterPage *>(filter_data_.get() + filter_page_idx * PAGE_SIZE);
+    }
+
+    void UpdateCounts(int32_t pairs_delta, int32_t tombstones_delta) {
+      num_pairs_ += pairs_delta;
+      num_tombstones_ += tombstones_delta;
+    }
+
+    const page_id_t header_page_id_;
+    const std::vector<page_id_t> block_page_ids_;
+    // the pages of the Bloom filter, empty if the table has none, and their contents
+    const std::vector<page_id_t> filter_page_ids_;
+    const std::unique_ptr<char[]> filter_data_;
+    std::atomic<int64_t> num_pairs_{0};
+    std::atomic<int64_t> num_tombstones_{0};
+  };
+
+  /**
+   * Allocates an empty table.
+   * @param num_blocks the number of block pages
+   * @return the directory of the table
+   */
+  std::unique_ptr<Directory> NewTable(size_t num_blocks);
+
+  /**
+   * Allocates an empty Bloom filter sized for a table, unless the table keeps none.
+   * @param num_blocks the number of block pages of the table
+   * @param hash_header_page the header page of the table, which records the first page of the filter
+   * @return the pages of the filter
+   */
+  std::vector<page_id_t> NewFilter(size_t num_blocks, HashTableHeaderPage *hash_header_page);
+
+  /**
+   * Finds the filter page and block a hash maps to. The high half of the hash picks the block, the low half is left
+   * for the bits within it.
+   * @param directory the directory of the table
+   * @param hash the hash of the key
+   * @return the index of the filter page and the block in that page
+   */
+  std::pair<size_t, size_t> FilterBlock(const Directory &directory, uint64_t hash) const;
+
+  /**
+   * Adds a hash to the Bloom filter of a table, if it keeps one.
+   * @param directory the directory of the table
+   * @param hash the hash of the key
+   */
+  void FilterInsert(const Directory &directory, uint64_t hash);
+
+  /**
+   * Tests a hash against the Bloom filter of a table.
+   * @param directory the directory of the table
+   * @param hash the hash of the key
+   * @return false if no pair with a key of this hash was ever inserted, true if one may have been or there is no filter
+   */
+  bool FilterMayContain(const Directory &directory, uint64_t hash);
+
+  /**
+   * Writes the Bloom filter of a table back to its pages. The caller must hold the table latch in write mode.
+   * @param directory the directory of the table
+   */
+  void WriteFilter(const Directory &directory);
+
+  /**
+   * Writes the pair and tombstone counts of a table back to its header page.
+   * @param directory the directory of the table
+   */
+  void WriteCounts(const Directory &directory);
+
+  /**
+   * Looks the key up in a single table.
+   * @param directory the directory of the table
+   * @param key the key to look up
+   * @param[out] result the values associated with the key are appended to it
+   * @return true if any value was found
+   */
+  bool GetValueIn(const Directory &directory, const KeyType &key, std::vector<ValueType> *result);
+
+  /**
+   * Looks a batch of keys up in a single table.
+   * @param directory the directory of the table
+   * @param keys the keys to look up
+   * @param[out] results the values associated with keys[i] are appended to results[i]
+   */
+  void GetValuesIn(const Directory &directory, const std::vector<KeyType> &keys,
+                   std::vector<std::vector<ValueType>> *results);
+
+  /**
+   * Inserts into a single table, reusing the first tombstone of the probe chain if there is one.
+   * @param directory the directory of the table
+   * @param key the key to insert
+   * @param value the value to insert
+   * @return whether the pair was inserted, already present, or the table is full
+   */
+  InsertResult InsertInto(Directory *directory, const KeyType &key, const ValueType &value);
+
+  /**
+   * Removes from a single table.
+   * @param directory the directory of the table
+   * @param key the key to remove
+   * @param value the value to remove
+   * @return true if the pair was found and removed
+   */
+  bool RemoveFrom(Directory *directory, const KeyType &key, const ValueType &value);
+
+  /**
+   * Compacts a block in place, so lookups stop scanning its tombstones: pairs move back into earlier tombstones on
+   * their probe chain, and tombstones that end up at the end of a chain are cleared. The caller must hold the block
+   * page write latch.
+   * @param directory the directory of the table
+   * @param block_idx the index of the block
+   * @param hash_block_page the block
+   */
+  void CompactBlock(Directory *directory, size_t block_idx,
+                    HashTableBlockPage<KeyType, ValueType, KeyComparator> *hash_block_page);
+
+  /**
+   * Allocates a table with num_blocks blocks and starts migrating into it. The caller must hold the table latch in
+   * write mode and no resize may be running.
+   * @param num_blocks the number of blocks of the new table, at least the current number
+   * @return false if the new table would be smaller than the current one
+   */
+  bool StartResize(size_t num_blocks);
+
+  /**
+   * Migrates up to max_blocks blocks of the old table into the new one. The caller must hold the table latch. If the
+   * new table fills up, the rest of the block stays in the old table and the migration is marked stalled.
+   * @param max_blocks the most blocks to migrate
+   * @return true if this call migrated the last block, so the old table can be dropped
+   */
+  bool MigrateBlocks(size_t max_blocks);
+
+  /**
+   * Drops the old table once all of its blocks are migrated. If the migration stalled, the pairs of both tables move
+   * into a table twice the size of the new one first, unless the new one is as large as it gets, in which case both
+   * tables are kept. The caller must hold the table latch in write mode.
+   */
+  void FinishResize();
+
+  /**
+   * Migrates whatever is left of the old table and drops it, retrying a stalled migration if the new table has room
+   * again. The caller must hold the table latch in write mode.
+   * @return true if no old table is left
+   */
+  bool CompleteResize();
+
+  /**
+   * Inserts every pair of a table into another one, which must have room for them. The caller must hold the table
+   * latch in write mode.
+   */
+  void MoveAll(Directory *from, Directory *to);
+
+  /** Deletes the pages of a table. */
+  void DropTable(const Directory &directory);
+
+  /**
+   * @param directory the directory of the table
+   * @return true if pairs and tombstones fill more than MAX_LOAD_FACTOR of the table
+   */
+  bool IsOverloaded(const Directory &directory);
+
+  /**
+   * Picks the size to resize a table to. The table doubles if pairs take up more than half of MAX_LOAD_FACTOR and it
+   * may still double, otherwise it is rebuilt at the same size to drop its tombstones if they take up more than
+   * REBUILD_TOMBSTONE_RATIO of it.
+   * @param directory the directory of the table
+   * @return the number of blocks of the new table, 0 if resizing is not worth it
+   */
+  size_t ResizeTarget(const Directory &directory) const;
+
+  /**
+   * Starts resizing a table that is overloaded or full to ResizeTarget, unless another thread already did.
+   * @param full_header_page_id the header page of the table that was found overloaded or full
+   * @return false if the table cannot make room for any more pairs
+   */
+  bool Grow(page_id_t full_header_page_id);
+
   // member variable
-  page_id_t header_page_id_;
   BufferPoolManager *buffer_pool_manager_;
   KeyComparator comparator_;
 
-  // Readers includes inserts and removes, writer is only resize
+  // Readers include inserts, removes and lookups (which also migrate blocks during a resize), writers only start and
+  // finish a resize
   ReaderWriterLatch table_latch_;
 
+  // the directory of the table, and of the table being migrated from, which is null unless resizing
+  std::unique_ptr<Directory> directory_;
+  std::unique_ptr<Directory> old_directory_;
+  // the next old block to be claimed for migration, and the number of old blocks done
+  std::atomic<size_t> next_migrate_block_{0};
+  std::atomic<size_t> migrated_blocks_{0};
+  // set when the new table filled up before the old one was migrated, so pairs were left behind
+  std::atomic<bool> migration_stalled_{false};
+
+  // compaction counters
+  std::atomic<size_t> num_compactions_{0};
+  std::atomic<size_t> num_tombstones_cleared_{0};
+
+  const bool use_bloom_filter_;
+  std::atomic<size_t> num_filter_negatives_{0};
+
   // Hash function
   HashFunction<KeyType> hash_fn_;
 };
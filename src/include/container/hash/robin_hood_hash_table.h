@@ -0,0 +1,189 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// robin_hood_hash_table.h
+//
+// Identification: src/include/container/hash/robin_hood_hash_table.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "concurrency/transaction.h"
+#include "container/hash/hash_function.h"
+#include "container/hash/hash_table.h"
+#include "storage/page/hash_table_block_page.h"
+#include "storage/page/hash_table_header_page.h"
+#include "storage/page/hash_table_page_defs.h"
+
+namespace bustub {
+
+#define ROBIN_HOOD_HASH_TABLE_TYPE RobinHoodHashTable<KeyType, ValueType, KeyComparator>
+
+/**
+ * Implementation of Robin Hood hashing that is backed by a buffer pool manager, laid out like LinearProbeHashTable:
+ * a header page listing the block pages, and the slots of all blocks forming one big probe sequence. Non-unique keys
+ * are supported.
+ *
+ * An insert that probes past a pair closer to its home slot than the insert is takes that slot and carries the
+ * displaced pair on, which keeps every pair close to its home slot and lets a lookup stop at the first pair closer
+ * to its home than the lookup is. Removes shift the rest of the probe chain back by one slot instead of leaving a
+ * tombstone, so probe lengths stay bounded under insert/remove churn. The table doubles once it is
+ * MAX_LOAD_FACTOR full.
+ */
+template <typename KeyType, typename ValueType, typename KeyComparator>
+class RobinHoodHashTable : public HashTable<KeyType, ValueType, KeyComparator> {
+ public:
+  /**
+   * Creates a new RobinHoodHashTable.
+   *
+   * @param name the name of the hash table
+   * @param buffer_pool_manager buffer pool manager to be used
+   * @param comparator comparator for keys
+   * @param num_buckets initial number of buckets contained by this hash table
+   * @param hash_fn the hash function
+   */
+  explicit RobinHoodHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
+                              const KeyComparator &comparator, size_t num_buckets, HashFunction<KeyType> hash_fn);
+
+  /**
+   * Inserts a key-value pair into the hash table.
+   * @param transaction the current transaction
+   * @param key the key to create
+   * @param value the value to be associated with the key
+   * @return true if insert succeeded, false otherwise
+   */
+  bool Insert(Transaction *transaction, const KeyType &key, const ValueType &value) override;
+
+  /**
+   * Deletes the associated value for the given key.
+   * @param transaction the current transaction
+   * @param key the key to delete
+   * @param value the value to delete
+   * @return true if remove succeeded, false otherwise
+   */
+  bool Remove(Transaction *transaction, const KeyType &key, const ValueType &value) override;
+
+  /**
+   * Performs a point query on the hash table.
+   * @param transaction the current transaction
+   * @param key the key to look up
+   * @param[out] result the value(s) associated with a given key
+   * @return the value(s) associated with the given key
+   */
+  bool GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) override;
+
+  /**
+   * @return the number of pairs in the hash table
+   */
+  size_t GetSize();
+
+  /**
+   * Counts the pairs by their distance from their home slot. A lookup that finds a pair at distance d probes d + 1
+   * slots.
+   *
+   * @return the histogram, entry d is the number of pairs d slots away from their home slot
+   */
+  std::vector<size_t> GetProbeLengthHistogram();
+
+ private:
+  using BlockPage = HashTableBlockPage<KeyType, ValueType, KeyComparator>;
+
+  /** The table doubles before an insert would fill more than this fraction of the slots. */
+  static constexpr double MAX_LOAD_FACTOR = 0.9;
+
+  /**
+   * Keeps the block page of the slot a probe is at pinned, and moves on to the next block page with the probe.
+   */
+  class BlockCursor {
+   public:
+    BlockCursor(BufferPoolManager *buffer_pool_manager, HashTableHeaderPage *header_page)
+        : buffer_pool_manager_(buffer_pool_manager), header_page_(header_page) {}
+
+    ~BlockCursor() { Release(); }
+
+    /** @return the block page holding the slot */
+    BlockPage *At(size_t slot) {
+      size_t block_idx = slot / BLOCK_ARRAY_SIZE;
+      if (page_ == nullptr || block_idx != block_idx_) {
+        Release();
+        block_idx_ = block_idx;
+        page_ = buffer_pool_manager_->FetchPage(header_page_->GetBlockPageId(block_idx));
+      }
+      return reinterpret_cast<BlockPage *>(page_->GetData());
+    }
+
+    /** Marks the current block page dirty. */
+    void MarkDirty() { dirty_ = true; }
+
+   private:
+    void Release() {
+      if (page_ != nullptr) {
+        buffer_pool_manager_->UnpinPage(page_->GetPageId(), dirty_);
+        page_ = nullptr;
+        dirty_ = false;
+      }
+    }
+
+    BufferPoolManager *buffer_pool_manager_;
+    HashTableHeaderPage *header_page_;
+    Page *page_{nullptr};
+    size_t block_idx_{0};
+    bool dirty_{false};
+  };
+
+  /**
+   * Allocates an empty table.
+   * @param num_blocks the number of block pages
+   * @return the page id of its header page
+   */
+  page_id_t NewTable(size_t num_blocks);
+
+  /**
+   * @param slot the slot a pair sits in
+   * @param key the key of the pair
+   * @param num_slots the number of slots of the table
+   * @return how far the slot is from the home slot of the key
+   */
+  size_t Displacement(size_t slot, const KeyType &key, size_t num_slots);
+
+  /**
+   * Inserts a pair into the table, displacing pairs that are closer to their home slot. The caller must make sure
+   * there is a free slot.
+   *
+   * @param header_page the header page of the table
+   * @param key the key to insert
+   * @param value the value to insert
+   * @return false if the pair is already in the table
+   */
+  bool InsertInto(HashTableHeaderPage *header_page, const KeyType &key, const ValueType &value);
+
+  /**
+   * Rehashes every pair into a table twice the size. The caller must hold the table latch in write mode.
+   * @return false if the header page cannot address a bigger table
+   */
+  bool Grow();
+
+  // member variables
+  page_id_t header_page_id_;
+  BufferPoolManager *buffer_pool_manager_;
+  KeyComparator comparator_;
+
+  // Readers are lookups, writers are inserts and removes since both may move pairs across many blocks
+  ReaderWriterLatch table_latch_;
+
+  // Hash function
+  HashFunction<KeyType> hash_fn_;
+
+  // the number of pairs in the table
+  size_t num_pairs_{0};
+};
+
+}  // namespace bustub
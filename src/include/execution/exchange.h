@@ -0,0 +1,70 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// exchange.h
+//
+// Identification: src/include/execution/exchange.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <mutex>  // NOLINT
+#include <vector>
+
+#include "common/macros.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * Exchange hands batches of tuples from a number of producer threads to a single consumer. It holds a bounded number
+ * of batches, so producers that run ahead of the consumer wait instead of buffering the whole result.
+ */
+class Exchange {
+ public:
+  /**
+   * Creates an empty exchange.
+   * @param num_producers the number of producers, the exchange is drained once all of them are done
+   * @param capacity the number of batches it holds before Push waits
+   */
+  Exchange(size_t num_producers, size_t capacity);
+
+  DISALLOW_COPY_AND_MOVE(Exchange);
+
+  /**
+   * Adds a batch, waiting while the exchange is full.
+   * @param batch the batch
+   * @return false if the consumer closed the exchange, the producer should stop then
+   */
+  bool Push(std::vector<Tuple> &&batch);
+
+  /** Records that a producer has pushed its last batch. */
+  void ProducerDone();
+
+  /**
+   * Takes the oldest batch, waiting while the exchange is empty and producers are still running.
+   * @param[out] batch the batch
+   * @return false once all producers are done and every batch was taken
+   */
+  bool Pop(std::vector<Tuple> *batch);
+
+  /** Stops the exchange early: the batches it holds are dropped, and the producers' next Push fails. */
+  void Close();
+
+ private:
+  std::mutex latch_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::deque<std::vector<Tuple>> batches_;
+  size_t capacity_;
+  size_t num_running_producers_;
+  bool is_closed_{false};
+};
+
+}  // namespace bustub
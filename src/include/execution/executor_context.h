@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <memory>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -19,6 +20,7 @@
 #include "catalog/simple_catalog.h"
 #include "concurrency/transaction.h"
 #include "storage/page/tmp_tuple_page.h"
+#include "type/arena_pool.h"
 
 namespace bustub {
 /**
@@ -54,10 +56,41 @@ class ExecutorContext {
   /** @return the lock manager - don't worry about it for now */
   LockManager *GetLockManager() { return nullptr; }
 
+  /**
+   * Creates an arena for an executor to build the tuples and values of its batches in, resetting it between them.
+   * Every executor gets an arena of its own, so no executor gives back memory another one still uses. The arena lives
+   * as long as the context.
+   * @return the arena
+   */
+  ArenaPool *CreateArena() {
+    arenas_.push_back(std::make_unique<ArenaPool>());
+    return arenas_.back().get();
+  }
+
+  /** @return the number of allocations the arenas of the query served */
+  size_t GetNumArenaAllocations() const {
+    size_t num_allocations = 0;
+    for (const auto &arena : arenas_) {
+      num_allocations += arena->GetNumAllocations();
+    }
+    return num_allocations;
+  }
+
+  /** @return the number of chunks the arenas of the query took from the heap */
+  size_t GetNumArenaChunkAllocations() const {
+    size_t num_chunk_allocations = 0;
+    for (const auto &arena : arenas_) {
+      num_chunk_allocations += arena->GetNumChunkAllocations();
+    }
+    return num_chunk_allocations;
+  }
+
  private:
   Transaction *transaction_;
   SimpleCatalog *catalog_;
   BufferPoolManager *bpm_;
+  /** the arenas of the executors of the query */
+  std::vector<std::unique_ptr<ArenaPool>> arenas_;
 };
 
 }  // namespace bustub
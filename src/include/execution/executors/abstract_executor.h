@@ -37,7 +37,9 @@ class AbstractExecutor {
   virtual void Init() = 0;
 
   /**
-   * Produces the next tuple from this executor.
+   * Produces the next tuple from this executor. The tuple may not own its data, e.g. when it points into an arena of
+   * the executor, and is then only valid until the next call of Next. Copies of a tuple always own their data, so a
+   * caller that keeps the tuple longer copies it instead of moving it.
    * @param[out] tuple the next tuple produced by this executor
    * @return true if a tuple was produced, false if there are no more tuples
    */
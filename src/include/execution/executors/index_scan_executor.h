@@ -0,0 +1,54 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// index_scan_executor.h
+//
+// Identification: src/include/execution/executors/index_scan_executor.h
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/index_scan_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * IndexScanExecutor executes a point lookup in an index, either fetching the matching tuples from the table heap or,
+ * for an index-only scan, building them from the included columns of a covering index.
+ */
+class IndexScanExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Creates a new index scan executor.
+   * @param exec_ctx the executor context
+   * @param plan the index scan plan to be executed
+   */
+  IndexScanExecutor(ExecutorContext *exec_ctx, const IndexScanPlanNode *plan);
+
+  void Init() override;
+
+  bool Next(Tuple *tuple) override;
+
+  const Schema *GetOutputSchema() override { return plan_->OutputSchema(); }
+
+ private:
+  /** The index scan plan node to be executed. */
+  const IndexScanPlanNode *plan_;
+
+  /** The schema the matching tuples are in, the covering schema of the index for an index-only scan. */
+  const Schema *scan_schema_;
+  /** The tuples matching the key, before the predicate. */
+  std::vector<Tuple> matches_;
+  /** The next match to return. */
+  size_t next_match_;
+};
+}  // namespace bustub
@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
@@ -48,7 +49,17 @@ class InsertExecutor : public AbstractExecutor {
   /** The insert plan node to be executed. */
   const InsertPlanNode *plan_;
 
+  /**
+   * Inserts of at least this many tuples are appended to the end of the table with BulkInsert. Smaller ones insert
+   * tuple by tuple, so they reuse the space the free space map knows about on earlier pages.
+   */
+  static constexpr size_t BULK_INSERT_MIN_TUPLES = 64;
+
+  /** Inserts the entries of a new tuple into every index of the table. */
+  void InsertIntoIndexes(const Tuple &tuple, RID rid);
+
   TableMetadata *table_metadata_;
+  std::vector<IndexInfo *> indexes_;
   std::unique_ptr<AbstractExecutor> child_executor_;
 };
 
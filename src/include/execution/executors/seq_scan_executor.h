@@ -12,17 +12,47 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <vector>
 
+#include "common/worker_pool.h"
+#include "execution/exchange.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/seq_scan_plan.h"
+#include "storage/table/pax_scan_iterator.h"
+#include "storage/table/table_batch_iterator.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * SeqScanExecutor executes a sequential scan over a table.
+ * The number of pages a sequential scan read, and the number of pages it skipped because the zone map of the table
+ * showed that none of their tuples could satisfy the predicate.
+ */
+struct ScanStats {
+  size_t pages_read_{0};
+  size_t pages_skipped_{0};
+};
+
+/**
+ * SeqScanExecutor executes a sequential scan over a table a page at a time. Every page is fetched and latched once,
+ * the predicate is evaluated on views of its tuples, and only the matching tuples are copied into a buffer that Next
+ * then drains. Tables in the PAX format are read through their columnar scan path, which assembles the tuples of a
+ * page a column at a time.
+ *
+ * If the predicate compares a fixed-width column against a constant, the scan consults the zone map of the table and
+ * only reads the pages whose summaries do not rule the predicate out.
+ *
+ * The matches of a row table page are copied into an arena of the executor, which is reset when the next page is
+ * read, so a scan takes no memory from the heap per tuple. A tuple returned by Next does not own its data and is only
+ * valid until the next call of Next, callers that keep it longer copy it.
+ *
+ * If the plan asks for more than one worker, a row table is scanned in parallel: the pages to read are taken from the
+ * page directory of the table, split into morsels of contiguous pages, and the morsels run on a worker pool that
+ * feeds the matching tuples into an exchange, in no particular order. Next drains the exchange. Tuple locks are taken
+ * through the transaction, which is not thread safe, so scans stay serial while logging is enabled.
  */
 class SeqScanExecutor : public AbstractExecutor {
  public:
@@ -33,17 +63,70 @@ class SeqScanExecutor : public AbstractExecutor {
    */
   SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan);
 
+  ~SeqScanExecutor() override { StopWorkers(); }
+
   void Init() override;
 
   bool Next(Tuple *tuple) override;
 
   const Schema *GetOutputSchema() override { return plan_->OutputSchema(); }
 
+  /** @return the pages the scan read and skipped so far */
+  ScanStats GetStats() const;
+
  private:
   /** The sequential scan plan node to be executed. */
   const SeqScanPlanNode *plan_;
 
   TableMetadata* table_metadata_;
-  std::unique_ptr<TableIterator> table_iter_; // TableIterator has no default constructor, so use ptr
+  /** Loads the matching tuples of the next page into batch_, returns false at the end of the table. */
+  bool NextPage();
+
+  /**
+   * Picks the pages of a row table the predicate may match on, using the zone map of the table.
+   * @param[out] page_ids the pages to read, in the order of the page chain
+   * @return false if the predicate cannot be checked against the zone map, and all pages have to be read
+   */
+  bool PrunePages(std::vector<page_id_t> *page_ids);
+
+  /**
+   * Copies the tuples that satisfy the predicate out of views of a page.
+   * @param views the views of the tuples
+   * @param[out] matches the copies are appended to it
+   * @param pool the pool to allocate the copies from, nullptr to give every copy its own memory
+   */
+  void Filter(const std::vector<TupleView> &views, std::vector<Tuple> *matches, AbstractPool *pool) const;
+
+  /** Splits pages into morsels and starts the workers of a parallel scan on them. */
+  void StartWorkers(const std::vector<page_id_t> &page_ids);
+
+  /** Scans a morsel on a worker, pushing the matches of every page into the exchange. */
+  void ScanMorsel(const std::vector<page_id_t> &page_ids);
+
+  /** Stops the workers of a parallel scan, if one is running, and waits for them. */
+  void StopWorkers();
+
+  /** The iterator over the pages of a table in the row format. */
+  std::unique_ptr<TableBatchIterator> iter_;
+  /** The iterator over the pages of a table in the PAX format. */
+  std::unique_ptr<PaxScanIterator> pax_iter_;
+  /** The views of the tuples of the current page, reused across pages. */
+  std::vector<TupleView> views_;
+  /** The tuples of the current page of a PAX table, reused across pages. */
+  std::vector<Tuple> pax_tuples_;
+  /** The matching tuples of the current page. */
+  std::vector<Tuple> batch_;
+  /** The next tuple of batch_ to return. */
+  size_t cursor_{0};
+  /** The arena the matches of a serial scan of a row table are copied into, owned by the executor context. */
+  ArenaPool *arena_;
+  /** The number of pages PrunePages ruled out. */
+  size_t pages_skipped_{0};
+  /** The batches of matching tuples of a parallel scan. */
+  std::unique_ptr<Exchange> exchange_;
+  /** The workers of a parallel scan. */
+  std::unique_ptr<WorkerPool> workers_;
+  /** The number of pages the workers of a parallel scan read. */
+  std::atomic<size_t> pages_read_{0};
 };
 }  // namespace bustub
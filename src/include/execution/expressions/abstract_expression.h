@@ -39,6 +39,13 @@ class AbstractExpression {
   /** @return the value obtained by evaluating the tuple with the given schema */
   virtual Value Evaluate(const Tuple *tuple, const Schema *schema) const = 0;
 
+  /**
+   * Evaluates the tuple like Evaluate, except that a VARCHAR result may point into the tuple or the expression
+   * instead of owning its bytes. The result must not outlive either, e.g. it is only good for comparing.
+   * @return the value obtained by evaluating the tuple with the given schema
+   */
+  virtual Value EvaluateView(const Tuple *tuple, const Schema *schema) const { return Evaluate(tuple, schema); }
+
   /**
    * Returns the value obtained by evaluating a join.
    * @param left_tuple the left tuple
@@ -35,6 +35,10 @@ class ColumnValueExpression : public AbstractExpression {
 
   Value Evaluate(const Tuple *tuple, const Schema *schema) const override { return tuple->GetValue(schema, col_idx_); }
 
+  Value EvaluateView(const Tuple *tuple, const Schema *schema) const override {
+    return tuple->GetValueView(schema, col_idx_);
+  }
+
   Value EvaluateJoin(const Tuple *left_tuple, const Schema *left_schema, const Tuple *right_tuple,
                      const Schema *right_schema) const override {
     return tuple_idx_ == 0 ? left_tuple->GetValue(left_schema, col_idx_)
@@ -45,6 +49,12 @@ class ColumnValueExpression : public AbstractExpression {
     BUSTUB_ASSERT(false, "Aggregation should only refer to group-by and aggregates.");
   }
 
+  /** @return the index of the tuple, 0 for the left side and 1 for the right side of a join */
+  uint32_t GetTupleIdx() const { return tuple_idx_; }
+
+  /** @return the index of the column in the schema of the tuple */
+  uint32_t GetColIdx() const { return col_idx_; }
+
  private:
   /** Tuple index 0 = left side of join, tuple index 1 = right side of join */
   uint32_t tuple_idx_;
@@ -12,13 +12,18 @@
 
 #pragma once
 
+#include <functional>
+#include <optional>
 #include <utility>
 #include <vector>
 
 #include "catalog/schema.h"
 #include "execution/expressions/abstract_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "storage/table/overflow_chain.h"
 #include "storage/table/tuple.h"
 #include "type/value_factory.h"
+#include "type/value_kernels.h"
 
 namespace bustub {
 
@@ -27,24 +32,41 @@ enum class ComparisonType { Equal, NotEqual, LessThan, LessThanOrEqual, GreaterT
 
 /**
  * ComparisonExpression represents two expressions being compared.
+ *
+ * If both children return the same fixed-width type, the comparison picks a kernel for that type when it is created,
+ * and compares the values of every tuple with it instead of going through the Type of the left value. A varchar
+ * column stored out of line is streamed from its overflow chain and compared a chunk at a time, rather than fetched
+ * into a Value of its full size.
  */
 class ComparisonExpression : public AbstractExpression {
  public:
   /** Creates a new comparison expression representing (left comp_type right). */
   ComparisonExpression(const AbstractExpression *left, const AbstractExpression *right, ComparisonType comp_type)
-      : AbstractExpression({left, right}, TypeId::BOOLEAN), comp_type_{comp_type} {}
+      : AbstractExpression({left, right}, TypeId::BOOLEAN),
+        comp_type_{comp_type},
+        kernel_{SelectKernel(left->GetReturnType(), right->GetReturnType(), comp_type)} {
+    if (left->GetReturnType() == TypeId::VARCHAR && right->GetReturnType() == TypeId::VARCHAR) {
+      varchar_columns_[0] = dynamic_cast<const ColumnValueExpression *>(left);
+      varchar_columns_[1] = dynamic_cast<const ColumnValueExpression *>(right);
+    }
+  }
 
   Value Evaluate(const Tuple *tuple, const Schema *schema) const override {
-    Value lhs = GetChildAt(0)->Evaluate(tuple, schema);
-    Value rhs = GetChildAt(1)->Evaluate(tuple, schema);
-    return ValueFactory::GetBooleanValue(PerformComparison(lhs, rhs));
+    CmpBool streamed;
+    if (CompareStreamed(tuple, schema, &streamed)) {
+      return ValueFactory::GetBooleanValue(streamed);
+    }
+    // the operands are only compared, so strings need not be copied out of the tuple
+    Value lhs = GetChildAt(0)->EvaluateView(tuple, schema);
+    Value rhs = GetChildAt(1)->EvaluateView(tuple, schema);
+    return ValueFactory::GetBooleanValue(kernel_ != nullptr ? kernel_(lhs, rhs) : PerformComparison(lhs, rhs));
   }
 
   Value EvaluateJoin(const Tuple *left_tuple, const Schema *left_schema, const Tuple *right_tuple,
                      const Schema *right_schema) const override {
     Value lhs = GetChildAt(0)->EvaluateJoin(left_tuple, left_schema, right_tuple, right_schema);
     Value rhs = GetChildAt(1)->EvaluateJoin(left_tuple, left_schema, right_tuple, right_schema);
-    return ValueFactory::GetBooleanValue(PerformComparison(lhs, rhs));
+    return ValueFactory::GetBooleanValue(kernel_ != nullptr ? kernel_(lhs, rhs) : PerformComparison(lhs, rhs));
   }
 
   Value EvaluateAggregate(const std::vector<Value> &group_bys, const std::vector<Value> &aggregates) const override {
@@ -53,7 +75,108 @@ class ComparisonExpression : public AbstractExpression {
     return ValueFactory::GetBooleanValue(PerformComparison(lhs, rhs));
   }
 
+  /** @return the type of the comparison */
+  ComparisonType GetComparisonType() const { return comp_type_; }
+
+  /** @return true if the comparison uses a kernel for the type of its children */
+  bool HasKernel() const { return kernel_ != nullptr; }
+
  private:
+  /**
+   * Picks the kernel for a comparison. Aggregates do not use it, their values need not have the type their
+   * expressions declare.
+   * @return the kernel, nullptr if the children return different types or a type without kernels
+   */
+  static CompareKernel SelectKernel(TypeId left_type, TypeId right_type, ComparisonType comp_type) {
+    if (left_type != right_type) {
+      return nullptr;
+    }
+    switch (comp_type) {
+      case ComparisonType::Equal:
+        return ValueKernels::GetCompareKernel<std::equal_to<>>(left_type);
+      case ComparisonType::NotEqual:
+        return ValueKernels::GetCompareKernel<std::not_equal_to<>>(left_type);
+      case ComparisonType::LessThan:
+        return ValueKernels::GetCompareKernel<std::less<>>(left_type);
+      case ComparisonType::LessThanOrEqual:
+        return ValueKernels::GetCompareKernel<std::less_equal<>>(left_type);
+      case ComparisonType::GreaterThan:
+        return ValueKernels::GetCompareKernel<std::greater<>>(left_type);
+      case ComparisonType::GreaterThanOrEqual:
+        return ValueKernels::GetCompareKernel<std::greater_equal<>>(left_type);
+      default:
+        return nullptr;
+    }
+  }
+
+  /** @return true if the column the expression reads is a varchar stored out of line in the tuple */
+  static bool IsOutOfLine(const ColumnValueExpression *column, const Tuple *tuple, const Schema *schema) {
+    return column != nullptr && !schema->GetColumn(column->GetColIdx()).IsInlined() &&
+           tuple->GetVarlenReader(schema, column->GetColIdx()).IsOverflow();
+  }
+
+  /**
+   * Compares varchar operands of which at least one is a column stored out of line, streaming the stored values.
+   * @param[out] result the result of the comparison
+   * @return false if no operand is stored out of line, the operands are then compared as Values
+   */
+  bool CompareStreamed(const Tuple *tuple, const Schema *schema, CmpBool *result) const {
+    bool out_of_line[2];
+    for (size_t i = 0; i < 2; i++) {
+      out_of_line[i] = IsOutOfLine(varchar_columns_[i], tuple, schema);
+    }
+    if (!out_of_line[0] && !out_of_line[1]) {
+      return false;
+    }
+    // the views keep the bytes of the operands that are not streamed alive until they are compared
+    Value views[2];
+    std::optional<VarlenReader> readers[2];
+    for (size_t i = 0; i < 2; i++) {
+      if (out_of_line[i]) {
+        readers[i].emplace(tuple->GetVarlenReader(schema, varchar_columns_[i]->GetColIdx()));
+        continue;
+      }
+      views[i] = GetChildAt(i)->EvaluateView(tuple, schema);
+      if (views[i].IsNull()) {
+        *result = CmpBool::CmpNull;
+        return true;
+      }
+      if (views[i].GetLength() == BUSTUB_VARCHAR_MAX_LEN) {
+        // the sentinel of the largest varchar has no bytes to compare
+        return false;
+      }
+      readers[i].emplace(views[i].GetData(), views[i].GetLength());
+    }
+    if (readers[0]->IsNull() || readers[1]->IsNull()) {
+      *result = CmpBool::CmpNull;
+      return true;
+    }
+    int cmp = VarlenReader::Compare(&*readers[0], &*readers[1]);
+    switch (comp_type_) {
+      case ComparisonType::Equal:
+        *result = GetCmpBool(cmp == 0);
+        break;
+      case ComparisonType::NotEqual:
+        *result = GetCmpBool(cmp != 0);
+        break;
+      case ComparisonType::LessThan:
+        *result = GetCmpBool(cmp < 0);
+        break;
+      case ComparisonType::LessThanOrEqual:
+        *result = GetCmpBool(cmp <= 0);
+        break;
+      case ComparisonType::GreaterThan:
+        *result = GetCmpBool(cmp > 0);
+        break;
+      case ComparisonType::GreaterThanOrEqual:
+        *result = GetCmpBool(cmp >= 0);
+        break;
+      default:
+        return false;
+    }
+    return true;
+  }
+
   CmpBool PerformComparison(const Value &lhs, const Value &rhs) const {
     switch (comp_type_) {
       case ComparisonType::Equal:
@@ -75,5 +198,9 @@ class ComparisonExpression : public AbstractExpression {
 
   std::vector<const AbstractExpression *> children_;
   ComparisonType comp_type_;
+  /** The kernel picked for the types of the children, nullptr to compare through the Value methods. */
+  CompareKernel kernel_;
+  /** The children that read a column, if both children return varchars, so out-of-line values can be streamed. */
+  const ColumnValueExpression *varchar_columns_[2]{nullptr, nullptr};
 };
 }  // namespace bustub
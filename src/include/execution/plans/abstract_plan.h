@@ -20,7 +20,7 @@
 namespace bustub {
 
 /** PlanType represents the types of plans that we have in our system. */
-enum class PlanType { SeqScan, HashJoin, Insert, Aggregation };
+enum class PlanType { SeqScan, IndexScan, HashJoin, Insert, Aggregation };
 
 /**
  * AbstractPlanNode represents all the possible types of plan nodes in our system.
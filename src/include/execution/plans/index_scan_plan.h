@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// index_scan_plan.h
+//
+// Identification: src/include/execution/plans/index_scan_plan.h
+//
+// Copyright (c) 2015-19, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "catalog/simple_catalog.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+/**
+ * IndexScanPlanNode looks up the tuples matching a key in an index, with an optional predicate.
+ *
+ * An index-only scan answers the query from a covering index alone, without touching the table heap. Its predicate
+ * and output expressions then refer to the columns of the index's covering schema, i.e. the key columns followed by
+ * the included columns. Otherwise the matching tuples are fetched from the table heap and the expressions refer to
+ * the columns of the table.
+ */
+class IndexScanPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Creates a new index scan plan node.
+   * @param output the output format of this scan plan node
+   * @param predicate the predicate to scan with, tuples are returned if predicate(tuple) = true or predicate = nullptr
+   * @param index_oid the identifier of the index to be scanned
+   * @param key_values the values of the key columns to look up
+   * @param index_only true to answer the query from the included columns of a covering index
+   */
+  IndexScanPlanNode(const Schema *output, const AbstractExpression *predicate, index_oid_t index_oid,
+                    std::vector<Value> key_values, bool index_only)
+      : AbstractPlanNode(output, {}),
+        predicate_{predicate},
+        index_oid_(index_oid),
+        key_values_(std::move(key_values)),
+        index_only_(index_only) {}
+
+  PlanType GetType() const override { return PlanType::IndexScan; }
+
+  /** @return the predicate to test tuples against; tuples should only be returned if they evaluate to true */
+  const AbstractExpression *GetPredicate() const { return predicate_; }
+
+  /** @return the identifier of the index that should be scanned */
+  index_oid_t GetIndexOid() const { return index_oid_; }
+
+  /** @return the values of the key columns to look up */
+  const std::vector<Value> &GetKeyValues() const { return key_values_; }
+
+  /** @return true if the scan must not touch the table heap */
+  bool IsIndexOnly() const { return index_only_; }
+
+ private:
+  /** The predicate that all returned tuples must satisfy. */
+  const AbstractExpression *predicate_;
+  /** The index to be scanned. */
+  index_oid_t index_oid_;
+  /** The key to look up. */
+  std::vector<Value> key_values_;
+  /** Whether the query is answered from the index alone. */
+  bool index_only_;
+};
+
+}  // namespace bustub
@@ -27,9 +27,11 @@ class SeqScanPlanNode : public AbstractPlanNode {
    * @param output the output format of this scan plan node
    * @param predicate the predicate to scan with, tuples are returned if predicate(tuple) = true or predicate = nullptr
    * @param table_oid the identifier of table to be scanned
+   * @param num_workers the number of threads to scan the table with, more than one scans it in parallel
    */
-  SeqScanPlanNode(const Schema *output, const AbstractExpression *predicate, table_oid_t table_oid)
-      : AbstractPlanNode(output, {}), predicate_{predicate}, table_oid_(table_oid) {}
+  SeqScanPlanNode(const Schema *output, const AbstractExpression *predicate, table_oid_t table_oid,
+                  uint32_t num_workers = 1)
+      : AbstractPlanNode(output, {}), predicate_{predicate}, table_oid_(table_oid), num_workers_(num_workers) {}
 
   PlanType GetType() const override { return PlanType::SeqScan; }
 
@@ -39,11 +41,16 @@ class SeqScanPlanNode : public AbstractPlanNode {
   /** @return the identifier of the table that should be scanned */
   table_oid_t GetTableOid() const { return table_oid_; }
 
+  /** @return the number of threads to scan the table with */
+  uint32_t GetNumWorkers() const { return num_workers_; }
+
  private:
   /** The predicate that all returned tuples must satisfy. */
   const AbstractExpression *predicate_;
   /** The table whose tuples should be scanned. */
   table_oid_t table_oid_;
+  /** The number of threads to scan the table with. */
+  uint32_t num_workers_;
 };
 
 }  // namespace bustub
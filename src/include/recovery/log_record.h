@@ -32,6 +32,8 @@ enum class LogRecordType {
   ABORT,
   /** Creating a new page in the table heap. */
   NEWPAGE,
+  /** Overwriting a fixed-width column of a tuple in place. */
+  UPDATECOLUMN,
 };
 
 /**
@@ -57,6 +59,10 @@ enum class LogRecordType {
  *--------------------------
  * | HEADER | prev_page_id |
  *--------------------------
+ * For update column type log record, the values are serialized with the fixed width of their type
+ *-------------------------------------------------------------------
+ * | HEADER | tuple_rid | column_offset | old_value | new_value |
+ *-------------------------------------------------------------------
  */
 class LogRecord {
   friend class LogManager;
@@ -98,6 +104,20 @@ class LogRecord {
     size_ = HEADER_SIZE + sizeof(RID) + old_tuple.GetLength() + new_tuple.GetLength() + 2 * sizeof(int32_t);
   }
 
+  // constructor for UPDATECOLUMN type
+  LogRecord(txn_id_t txn_id, lsn_t prev_lsn, LogRecordType log_record_type, const RID &update_rid,
+            uint32_t column_offset, const Value &old_value, const Value &new_value)
+      : txn_id_(txn_id),
+        prev_lsn_(prev_lsn),
+        log_record_type_(log_record_type),
+        update_rid_(update_rid),
+        column_offset_(column_offset),
+        old_value_(old_value),
+        new_value_(new_value) {
+    // calculate log record size
+    size_ = HEADER_SIZE + sizeof(RID) + sizeof(uint32_t) + 2 * Type::GetTypeSize(new_value.GetTypeId());
+  }
+
   // constructor for NEWPAGE type
   LogRecord(txn_id_t txn_id, lsn_t prev_lsn, LogRecordType log_record_type, page_id_t prev_page_id)
       : size_(HEADER_SIZE),
@@ -164,7 +184,12 @@ class LogRecord {
   Tuple old_tuple_;
   Tuple new_tuple_;
 
-  // case4: for new page opeartion
+  // case4: for update column opeartion, reusing update_rid_
+  uint32_t column_offset_{0};
+  Value old_value_;
+  Value new_value_;
+
+  // case5: for new page opeartion
   page_id_t prev_page_id_{INVALID_PAGE_ID};
   page_id_t page_id_{INVALID_PAGE_ID};
   static const int HEADER_SIZE = 20;
@@ -0,0 +1,156 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree.h
+//
+// Identification: src/include/storage/index/b_plus_tree.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "concurrency/transaction.h"
+#include "storage/index/index_iterator.h"
+#include "storage/page/b_plus_tree_internal_page.h"
+#include "storage/page/b_plus_tree_leaf_page.h"
+
+namespace bustub {
+
+#define BPLUSTREE_TYPE BPlusTree<KeyType, ValueType, KeyComparator>
+
+/** The kind of operation a root-to-leaf traversal is made for. */
+enum class Operation { READ, INSERT, DELETE };
+
+/**
+ * Main class providing the API for the interactive B+ tree. Only unique keys are supported.
+ * Supports insert and remove. The structure shrinks and grows dynamically.
+ *
+ * Concurrency uses latch crabbing. Readers read-latch their way down, releasing each parent once the child is
+ * latched. Writers first try optimistically: read latches on internal pages and a write latch on the leaf only. If the
+ * leaf might split or underflow, they start over pessimistically, write-latching the path from the root and releasing
+ * all ancestors whenever a page is safe for the operation. The write-latched path lives in the transaction's page set,
+ * with a nullptr entry standing for the root latch, and is also how a page finds its parent.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class BPlusTree {
+  using InternalPage = BPlusTreeInternalPage<KeyType, page_id_t, KeyComparator>;
+  using LeafPage = BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>;
+  friend class IndexIterator<KeyType, ValueType, KeyComparator>;
+
+ public:
+  explicit BPlusTree(std::string name, BufferPoolManager *buffer_pool_manager, const KeyComparator &comparator,
+                     int leaf_max_size = LEAF_PAGE_SIZE - 1, int internal_max_size = INTERNAL_PAGE_SIZE - 1);
+
+  // Returns true if this B+ tree has no keys and values.
+  bool IsEmpty() const;
+
+  // Insert a key-value pair into this B+ tree, returns false if the key already exists.
+  bool Insert(const KeyType &key, const ValueType &value, Transaction *transaction = nullptr);
+
+  // Remove a key and its value from this B+ tree.
+  void Remove(const KeyType &key, Transaction *transaction = nullptr);
+
+  // return the value associated with a given key
+  bool GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *transaction = nullptr);
+
+  /**
+   * Builds the tree bottom-up from the given pairs: they are sorted, packed into leaves left to right and then into
+   * each internal level in turn, so every page is written once and in allocation order. Each level uses the fewest
+   * pages that can hold it, spread evenly so that none underflows. The tree must be empty.
+   *
+   * @param[in,out] entries the pairs to load, sorted in place
+   * @return false if two pairs share a key, nothing is loaded then
+   */
+  bool BulkLoad(std::vector<std::pair<KeyType, ValueType>> *entries);
+
+  // index iterator
+  INDEXITERATOR_TYPE Begin();
+  INDEXITERATOR_TYPE Begin(const KeyType &key);
+  INDEXITERATOR_TYPE End();
+
+  /** @return the page id of the root, INVALID_PAGE_ID if the tree is empty */
+  page_id_t GetRootPageId();
+
+  /**
+   * Asserts the B+ tree invariants: page sizes within bounds, keys ordered within and across pages, all leaves at the
+   * same depth and the leaf chain visiting every key in order. Not thread safe.
+   */
+  void VerifyIntegrity();
+
+ private:
+  /**
+   * Read-latches its way down to the leaf that may contain the key.
+   * @param left_most find the left most leaf instead
+   * @return the pinned and read-latched leaf, nullptr if the tree is empty
+   */
+  Page *FindLeafPageRead(const KeyType &key, bool left_most = false);
+
+  /**
+   * Read-latches its way down to the leaf that may contain the key, write-latching only the leaf.
+   * @return the pinned and write-latched leaf, nullptr if the tree is empty
+   */
+  Page *FindLeafPageOptimistic(const KeyType &key);
+
+  /**
+   * Write-latches its way down to the leaf that may contain the key, keeping every page that is not safe for the
+   * operation (plus the root latch if the root is not safe) in the transaction's page set.
+   * @return the leaf, nullptr if the tree is empty
+   */
+  Page *FindLeafPagePessimistic(const KeyType &key, Operation op, Transaction *transaction);
+
+  /** @return true if the operation cannot split or underflow the page */
+  bool IsSafe(BPlusTreePage *node, Operation op, bool is_root) const;
+
+  /** Releases every latch in the transaction's page set and unpins the pages. */
+  void ReleaseWLatches(Transaction *transaction, bool is_dirty);
+
+  /** Deletes the pages that were emptied by the last remove. */
+  void DeletePages(Transaction *transaction);
+
+  /** @return true if the write-latched page is the first one in the page set, see the comment in the definition */
+  bool IsRootPage(Page *page, Transaction *transaction) const;
+
+  /** @return the write-latched parent of a write-latched page */
+  Page *GetParentPage(Page *page, Transaction *transaction) const;
+
+  bool InsertPessimistic(const KeyType &key, const ValueType &value, Transaction *transaction);
+
+  void RemovePessimistic(const KeyType &key, Transaction *transaction);
+
+  void StartNewTree(const KeyType &key, const ValueType &value);
+
+  /**
+   * Inserts the separator for a freshly split page into its parent, splitting the parent or growing a new root as
+   * needed. new_page is pinned by the caller and not latched, it is unreachable until the parent points to it.
+   */
+  void InsertIntoParent(Page *old_page, const KeyType &key, Page *new_page, Transaction *transaction);
+
+  /** Fixes an underflowing page by merging it with, or borrowing from, a sibling. */
+  void CoalesceOrRedistribute(Page *page, Transaction *transaction);
+
+  /** Shrinks the tree after its root underflowed. */
+  void AdjustRoot(Page *page, Transaction *transaction);
+
+  /** @return the depth of the subtree, asserting its invariants */
+  int VerifySubtree(page_id_t page_id, bool is_root, const KeyType *lower, const KeyType *upper, int *num_keys);
+
+  // member variable
+  std::string index_name_;
+  page_id_t root_page_id_;
+  BufferPoolManager *buffer_pool_manager_;
+  KeyComparator comparator_;
+  int leaf_max_size_;
+  int internal_max_size_;
+  // protects root_page_id_
+  ReaderWriterLatch root_latch_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,60 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_index.h
+//
+// Identification: src/include/storage/index/b_plus_tree_index.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "storage/index/b_plus_tree.h"
+#include "storage/index/index.h"
+
+namespace bustub {
+
+#define BPLUSTREE_INDEX_TYPE BPlusTreeIndex<KeyType, ValueType, KeyComparator>
+
+/**
+ * A unique index on a B+ tree. Inserting a key that is already in the index, directly or by a bulk load, aborts the
+ * transaction and throws an Exception of type DUPLICATE_KEY, instead of losing the second RID.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class BPlusTreeIndex : public Index {
+ public:
+  BPlusTreeIndex(IndexMetadata *metadata, BufferPoolManager *buffer_pool_manager);
+
+  ~BPlusTreeIndex() override = default;
+
+  void InsertEntry(const Tuple &key, RID rid, Transaction *transaction) override;
+
+  void DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) override;
+
+  void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
+
+  void BulkLoad(TableHeap *table_heap, const Schema &tuple_schema, Transaction *transaction) override;
+
+  INDEXITERATOR_TYPE GetBeginIterator();
+
+  INDEXITERATOR_TYPE GetBeginIterator(const KeyType &key);
+
+  INDEXITERATOR_TYPE GetEndIterator();
+
+ protected:
+  /** Aborts the transaction, if there is one, and throws because the key is already in the index. */
+  void ThrowDuplicateKey(Transaction *transaction);
+
+  // comparator for key
+  KeyComparator comparator_;
+  // container
+  BPlusTree<KeyType, ValueType, KeyComparator> container_;
+};
+
+}  // namespace bustub
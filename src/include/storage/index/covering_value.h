@@ -0,0 +1,81 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// covering_value.h
+//
+// Identification: src/include/storage/index/covering_value.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstring>
+
+#include "common/exception.h"
+#include "common/rid.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * Index value of a covering index: the RID of the tuple, followed by the included columns of the tuple in the same
+ * fixed length layout GenericKey uses for keys. Lookups can then answer queries on the key and included columns
+ * without fetching the tuple from the table heap.
+ *
+ * Entries are identified by their RID alone, so removing an entry only needs its key and RID.
+ */
+template <size_t IncludedSize>
+class CoveringValue {
+ public:
+  /** The number of bytes of included columns the value holds. */
+  static constexpr size_t INCLUDED_SIZE = IncludedSize;
+
+  /**
+   * Sets the value from the RID and the included columns of a tuple.
+   * @param rid the RID of the tuple
+   * @param included the included columns of the tuple, which must all be inlined
+   * @throws Exception if the included columns do not fit into the value
+   */
+  inline void Set(RID rid, const Tuple &included) {
+    if (included.GetLength() > IncludedSize) {
+      throw Exception(ExceptionType::OUT_OF_RANGE, "The included columns do not fit into the index value.");
+    }
+    rid_ = rid;
+    memset(data_, 0, IncludedSize);
+    memcpy(data_, included.GetData(), included.GetLength());
+  }
+
+  /**
+   * Sets the value to a bare RID, e.g. to remove the entry of that RID.
+   * @param rid the RID of the tuple
+   */
+  inline void Set(RID rid) {
+    rid_ = rid;
+    memset(data_, 0, IncludedSize);
+  }
+
+  /** @return the RID of the tuple */
+  inline RID GetRid() const { return rid_; }
+
+  /**
+   * @param included_schema the schema of the included columns
+   * @param column_idx the index of a column in that schema
+   * @return the value of the column
+   */
+  inline Value ToValue(const Schema *included_schema, uint32_t column_idx) const {
+    const auto &col = included_schema->GetColumn(column_idx);
+    return Value::DeserializeFrom(data_ + col.GetOffset(), col.GetType());
+  }
+
+  inline bool operator==(const CoveringValue &other) const { return rid_ == other.rid_; }
+
+ private:
+  RID rid_;
+  char data_[IncludedSize];
+};
+
+}  // namespace bustub
@@ -12,13 +12,58 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <cstring>
+#include <type_traits>
 
+#include "common/exception.h"
+#include "common/macros.h"
 #include "storage/table/tuple.h"
+#include "type/limits.h"
 #include "type/value.h"
 
 namespace bustub {
 
+/**
+ * How GenericComparator compares two keys. The mode only depends on the key schema, so the comparator and
+ * GenericKey::SetFromKey(tuple, key_schema) always agree on the key layout.
+ */
+enum class KeyCompareMode {
+  /** Deserializes every column into a Value and compares those. */
+  VALUE,
+  /** Every column is a fixed-width integer, compared in place without building Values. */
+  FIXED_WIDTH,
+  /** The key holds a normalized encoding of its columns that orders like the columns do, compared with memcmp. */
+  NORMALIZED,
+};
+
+/**
+ * @param key_schema the key schema
+ * @return the compare mode of keys with the given schema
+ */
+inline KeyCompareMode GetKeyCompareMode(const Schema &key_schema) {
+  bool fixed_width = key_schema.GetColumnCount() > 0;
+  for (uint32_t i = 0; i < key_schema.GetColumnCount(); i++) {
+    switch (key_schema.GetColumn(i).GetType()) {
+      case TypeId::BOOLEAN:
+      case TypeId::TINYINT:
+      case TypeId::SMALLINT:
+      case TypeId::INTEGER:
+      case TypeId::BIGINT:
+      case TypeId::TIMESTAMP:
+        break;
+      case TypeId::DECIMAL:
+      case TypeId::VARCHAR:
+        fixed_width = false;
+        break;
+      default:
+        return KeyCompareMode::VALUE;
+    }
+  }
+  return fixed_width ? KeyCompareMode::FIXED_WIDTH : KeyCompareMode::NORMALIZED;
+}
+
 /**
  * Generic key is used for indexing with opaque data.
  *
@@ -35,6 +80,74 @@ class GenericKey {
     memcpy(data_, tuple.GetData(), tuple.GetLength());
   }
 
+  /**
+   * Sets the key from a tuple of the key schema, in the layout GenericComparator expects for that schema: the tuple
+   * bytes as is, or the normalized encoding for keys with varchar or decimal columns.
+   * @throws Exception if the normalized encoding, which grows with the varchar values, does not fit into KeySize bytes
+   */
+  inline void SetFromKey(const Tuple &tuple, const Schema &key_schema) {
+    if (GetKeyCompareMode(key_schema) != KeyCompareMode::NORMALIZED) {
+      SetFromKey(tuple);
+      return;
+    }
+
+    memset(data_, 0, KeySize);
+    size_t pos = 0;
+    for (uint32_t i = 0; i < key_schema.GetColumnCount(); i++) {
+      const Column &col = key_schema.GetColumn(i);
+      const char *src = tuple.GetData() + col.GetOffset();
+      switch (col.GetType()) {
+        case TypeId::BOOLEAN:
+        case TypeId::TINYINT:
+          pos = PutSigned<int8_t>(pos, src);
+          break;
+        case TypeId::SMALLINT:
+          pos = PutSigned<int16_t>(pos, src);
+          break;
+        case TypeId::INTEGER:
+          pos = PutSigned<int32_t>(pos, src);
+          break;
+        case TypeId::BIGINT:
+          pos = PutSigned<int64_t>(pos, src);
+          break;
+        case TypeId::TIMESTAMP: {
+          uint64_t bits;
+          memcpy(&bits, src, sizeof(bits));
+          pos = PutBigEndian(pos, bits);
+          break;
+        }
+        case TypeId::DECIMAL: {
+          // negative doubles order backwards bit-wise, flip all their bits. positive ones only need the sign bit
+          uint64_t bits;
+          memcpy(&bits, src, sizeof(bits));
+          bits = (bits >> 63) != 0 ? ~bits : bits ^ (1ULL << 63);
+          pos = PutBigEndian(pos, bits);
+          break;
+        }
+        case TypeId::VARCHAR: {
+          // the payload ends in a 0x00 0x00 terminator, so a 0x00 inside the payload is escaped to 0x00 0xff
+          uint32_t offset;
+          memcpy(&offset, src, sizeof(offset));
+          uint32_t len;
+          memcpy(&len, tuple.GetData() + offset, sizeof(len));
+          const char *payload = tuple.GetData() + offset + sizeof(uint32_t);
+          // the serialized length counts the trailing '\0'
+          for (uint32_t j = 0; len != BUSTUB_VALUE_NULL && j + 1 < len; j++) {
+            pos = PutByte(pos, payload[j]);
+            if (payload[j] == 0) {
+              pos = PutByte(pos, static_cast<char>(0xff));
+            }
+          }
+          pos = PutByte(pos, 0);
+          pos = PutByte(pos, 0);
+          break;
+        }
+        default:
+          UNREACHABLE("Cannot normalize this column type.");
+      }
+    }
+  }
+
   // NOTE: for test purpose only
   inline void SetFromInteger(int64_t key) {
     memset(data_, 0, KeySize);
@@ -68,15 +181,65 @@ class GenericKey {
 
   // actual location of data, extends past the end.
   char data_[KeySize];
+
+ private:
+  inline size_t PutByte(size_t pos, char byte) {
+    if (pos >= KeySize) {
+      throw Exception(ExceptionType::OUT_OF_RANGE, "The normalized key does not fit into the key size.");
+    }
+    data_[pos] = byte;
+    return pos + 1;
+  }
+
+  template <typename T>
+  inline size_t PutBigEndian(size_t pos, T bits) {
+    for (int shift = 8 * (sizeof(T) - 1); shift >= 0; shift -= 8) {
+      pos = PutByte(pos, static_cast<char>((bits >> shift) & 0xff));
+    }
+    return pos;
+  }
+
+  /** Signed integers are written big-endian with the sign bit flipped, so negative values sort first. */
+  template <typename T>
+  inline size_t PutSigned(size_t pos, const char *src) {
+    using UnsignedT = std::make_unsigned_t<T>;
+    UnsignedT bits;
+    memcpy(&bits, src, sizeof(bits));
+    bits ^= static_cast<UnsignedT>(UnsignedT(1) << (8 * sizeof(T) - 1));
+    return PutBigEndian(pos, bits);
+  }
 };
 
 /**
- * Function object returns true if lhs < rhs, used for trees
+ * Function object returns true if lhs < rhs, used for trees.
+ *
+ * The compare mode is picked from the key schema at construction. Keys of fixed-width integer columns are compared
+ * column by column in place, keys with varchar or decimal columns are expected in the normalized encoding written by
+ * GenericKey::SetFromKey(tuple, key_schema) and compared with memcmp. Neither builds a Value per probe. Both order the
+ * NULL sentinels like regular values (first), where Value comparisons treat a NULL as equal to anything.
  */
 template <size_t KeySize>
 class GenericComparator {
  public:
   inline int operator()(const GenericKey<KeySize> &lhs, const GenericKey<KeySize> &rhs) const {
+    switch (mode_) {
+      case KeyCompareMode::FIXED_WIDTH:
+        for (uint32_t i = 0; i < column_count_; i++) {
+          int cmp = CompareFixedWidth(lhs.data_ + columns_[i].offset_, rhs.data_ + columns_[i].offset_,
+                                      static_cast<TypeId>(columns_[i].type_));
+          if (cmp != 0) {
+            return cmp;
+          }
+        }
+        return 0;
+      case KeyCompareMode::NORMALIZED: {
+        int cmp = memcmp(lhs.data_, rhs.data_, KeySize);
+        return cmp < 0 ? -1 : (cmp > 0 ? 1 : 0);
+      }
+      case KeyCompareMode::VALUE:
+        break;
+    }
+
     uint32_t column_count = key_schema_->GetColumnCount();
 
     for (uint32_t i = 0; i < column_count; i++) {
@@ -94,13 +257,75 @@ class GenericComparator {
     return 0;
   }
 
-  GenericComparator(const GenericComparator &other) : key_schema_{other.key_schema_} {}
+  GenericComparator(const GenericComparator &other) = default;
 
-  // constructor
-  explicit GenericComparator(Schema *key_schema) : key_schema_(key_schema) {}
+  /**
+   * @param key_schema the schema of the keys
+   * @throws Exception if the fixed-size part of a key of the schema does not fit into KeySize bytes
+   */
+  explicit GenericComparator(Schema *key_schema) : key_schema_(key_schema), mode_(GetKeyCompareMode(*key_schema)) {
+    if (key_schema->GetLength() > KeySize) {
+      throw Exception(ExceptionType::OUT_OF_RANGE, "The key schema does not fit into the key size.");
+    }
+    if (mode_ == KeyCompareMode::FIXED_WIDTH) {
+      // every fixed-width column takes at least a byte and the schema fits into the key, so they all fit in the array
+      column_count_ = key_schema->GetColumnCount();
+      for (uint32_t i = 0; i < column_count_; i++) {
+        const Column &col = key_schema->GetColumn(i);
+        columns_[i] = {static_cast<uint16_t>(col.GetOffset()), static_cast<uint8_t>(col.GetType())};
+      }
+    }
+  }
+
+  /** @return how this comparator compares keys */
+  KeyCompareMode GetMode() const { return mode_; }
 
  private:
+  static_assert(KeySize <= UINT16_MAX, "Key offsets must fit into FixedWidthColumn.");
+
+  /** Packed into four bytes, so copying a comparator stays cheap and never allocates. */
+  struct FixedWidthColumn {
+    uint16_t offset_;
+    uint8_t type_;
+  };
+
+  /** Compares two columns of type T. The constructor rejected schemas with columns that do not fit into a key. */
+  template <typename T>
+  static inline int CompareAs(const char *lhs, const char *rhs) {
+    if constexpr (sizeof(T) <= KeySize) {
+      T lhs_value;
+      T rhs_value;
+      memcpy(&lhs_value, lhs, sizeof(T));
+      memcpy(&rhs_value, rhs, sizeof(T));
+      return lhs_value < rhs_value ? -1 : (lhs_value > rhs_value ? 1 : 0);
+    } else {
+      UNREACHABLE("The column does not fit into the key size.");
+    }
+  }
+
+  static inline int CompareFixedWidth(const char *lhs, const char *rhs, TypeId type) {
+    switch (type) {
+      case TypeId::BOOLEAN:
+      case TypeId::TINYINT:
+        return CompareAs<int8_t>(lhs, rhs);
+      case TypeId::SMALLINT:
+        return CompareAs<int16_t>(lhs, rhs);
+      case TypeId::INTEGER:
+        return CompareAs<int32_t>(lhs, rhs);
+      case TypeId::BIGINT:
+        return CompareAs<int64_t>(lhs, rhs);
+      case TypeId::TIMESTAMP:
+        return CompareAs<uint64_t>(lhs, rhs);
+      default:
+        UNREACHABLE("Not a fixed-width integer type.");
+    }
+  }
+
   Schema *key_schema_;
+  KeyCompareMode mode_;
+  /** the key columns, if the mode is FIXED_WIDTH */
+  uint32_t column_count_{0};
+  std::array<FixedWidthColumn, KeySize> columns_{};
 };
 
 }  // namespace bustub
@@ -18,6 +18,8 @@
 #include <vector>
 
 #include "catalog/schema.h"
+#include "common/exception.h"
+#include "storage/table/table_heap.h"
 #include "storage/table/tuple.h"
 #include "type/value.h"
 
@@ -37,12 +39,25 @@ class IndexMetadata {
   IndexMetadata() = delete;
 
   IndexMetadata(std::string index_name, std::string table_name, const Schema *tuple_schema,
-                std::vector<uint32_t> key_attrs)
-      : name_(std::move(index_name)), table_name_(std::move(table_name)), key_attrs_(std::move(key_attrs)) {
+                std::vector<uint32_t> key_attrs, std::vector<uint32_t> included_attrs = {})
+      : name_(std::move(index_name)),
+        table_name_(std::move(table_name)),
+        key_attrs_(std::move(key_attrs)),
+        included_attrs_(std::move(included_attrs)) {
     key_schema_ = Schema::CopySchema(tuple_schema, key_attrs_);
+    if (!included_attrs_.empty()) {
+      included_schema_ = Schema::CopySchema(tuple_schema, included_attrs_);
+      std::vector<uint32_t> covered_attrs(key_attrs_);
+      covered_attrs.insert(covered_attrs.end(), included_attrs_.begin(), included_attrs_.end());
+      covering_schema_ = Schema::CopySchema(tuple_schema, covered_attrs);
+    }
   }
 
-  ~IndexMetadata() { delete key_schema_; }
+  ~IndexMetadata() {
+    delete key_schema_;
+    delete included_schema_;
+    delete covering_schema_;
+  }
 
   inline const std::string &GetName() const { return name_; }
 
@@ -60,6 +75,17 @@ class IndexMetadata {
   //  columns
   inline const std::vector<uint32_t> &GetKeyAttrs() const { return key_attrs_; }
 
+  // Returns the base table columns stored next to the key by a covering
+  // index, empty for a plain index
+  inline const std::vector<uint32_t> &GetIncludedAttrs() const { return included_attrs_; }
+
+  // Returns the schema of the included columns, nullptr for a plain index
+  inline Schema *GetIncludedSchema() const { return included_schema_; }
+
+  // Returns the schema of what a covering index can answer on its own: the
+  // key columns followed by the included columns. nullptr for a plain index
+  inline Schema *GetCoveringSchema() const { return covering_schema_; }
+
   // Get a string representation for debugging
   std::string ToString() const {
     std::stringstream os;
@@ -78,8 +104,13 @@ class IndexMetadata {
   std::string table_name_;
   // The mapping relation between key schema and tuple schema
   const std::vector<uint32_t> key_attrs_;
+  // The included columns of a covering index in the base table
+  const std::vector<uint32_t> included_attrs_;
   // schema of the indexed key
   Schema *key_schema_;
+  // schemas of the included columns, and of the key and included columns
+  Schema *included_schema_{nullptr};
+  Schema *covering_schema_{nullptr};
 };
 
 /////////////////////////////////////////////////////////////////////
@@ -117,6 +148,10 @@ class Index {
 
   const std::vector<uint32_t> &GetKeyAttrs() const { return metadata_->GetKeyAttrs(); }
 
+  Schema *GetIncludedSchema() const { return metadata_->GetIncludedSchema(); }
+
+  const std::vector<uint32_t> &GetIncludedAttrs() const { return metadata_->GetIncludedAttrs(); }
+
   // Get a string representation for debugging
   std::string ToString() const {
     std::stringstream os;
@@ -132,11 +167,59 @@ class Index {
   // designed for secondary indexes.
   virtual void InsertEntry(const Tuple &key, RID rid, Transaction *transaction) = 0;
 
+  // insert an entry along with the included columns of its tuple. a
+  // covering index stores them next to the key, other indexes ignore them
+  virtual void InsertEntry(const Tuple &key, const Tuple &included, RID rid, Transaction *transaction) {
+    InsertEntry(key, rid, transaction);
+  }
+
   // delete the index entry linked to given tuple
   virtual void DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) = 0;
 
   virtual void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) = 0;
 
+  // point queries for a batch of keys, results[i] receives the matches of
+  // keys[i]. by default this scans one key at a time, indexes that can share
+  // page fetches across the batch override it.
+  virtual void ScanKeys(const std::vector<Tuple> &keys, std::vector<std::vector<RID>> *results,
+                        Transaction *transaction) {
+    results->resize(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+      ScanKey(keys[i], &(*results)[i], transaction);
+    }
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Index-only Scan
+  ///////////////////////////////////////////////////////////////////
+  // true if the index stores included columns, so ScanKeyIncluded can
+  // answer queries on them without touching the table heap
+  virtual bool IsCovering() const { return false; }
+
+  // point query returning the included columns of every match, as tuples of
+  // the included schema
+  virtual void ScanKeyIncluded(const Tuple &key, std::vector<Tuple> *result, Transaction *transaction) {
+    throw NotImplementedException("The index does not store included columns.");
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Bulk Load
+  ///////////////////////////////////////////////////////////////////
+  // build an empty index over every tuple of a table in one scan. by default
+  // this inserts one entry at a time, indexes with a faster bottom-up build
+  // override it.
+  virtual void BulkLoad(TableHeap *table_heap, const Schema &tuple_schema, Transaction *transaction) {
+    for (auto iter = table_heap->Begin(transaction); iter != table_heap->End(); ++iter) {
+      Tuple key = iter->KeyFromTuple(tuple_schema, *GetKeySchema(), GetKeyAttrs());
+      if (GetIncludedSchema() == nullptr) {
+        InsertEntry(key, iter->GetRid(), transaction);
+      } else {
+        InsertEntry(key, iter->KeyFromTuple(tuple_schema, *GetIncludedSchema(), GetIncludedAttrs()), iter->GetRid(),
+                    transaction);
+      }
+    }
+  }
+
  private:
   //===--------------------------------------------------------------------===//
   //  Data members
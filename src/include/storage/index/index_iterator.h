@@ -0,0 +1,81 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// index_iterator.h
+//
+// Identification: src/include/storage/index/index_iterator.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "storage/page/b_plus_tree_leaf_page.h"
+
+namespace bustub {
+
+#define INDEXITERATOR_TYPE IndexIterator<KeyType, ValueType, KeyComparator>
+
+INDEX_TEMPLATE_ARGUMENTS
+class BPlusTree;
+
+/**
+ * Forward iterator over the leaf level of a BPlusTree, used for range scans.
+ *
+ * The iterator keeps the current leaf pinned and read-latched until it moves past it or is destroyed, so the calling
+ * thread must not modify the tree while it holds a live iterator. Moving to the next leaf only try-latches it: a
+ * writer may be holding that leaf while it waits for the current one (to coalesce or redistribute), in which case the
+ * iterator backs off and finds the successor of the last key it saw from the root.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class IndexIterator {
+  using LeafPage = BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>;
+
+ public:
+  /** Creates an end iterator. */
+  IndexIterator();
+
+  /**
+   * @param tree the tree being scanned
+   * @param buffer_pool_manager buffer pool manager of the tree
+   * @param page the pinned and read-latched leaf to start at, nullptr for an end iterator
+   * @param index the position in the leaf to start at
+   */
+  IndexIterator(BPlusTree<KeyType, ValueType, KeyComparator> *tree, BufferPoolManager *buffer_pool_manager, Page *page,
+                int index);
+
+  ~IndexIterator();
+
+  DISALLOW_COPY(IndexIterator);
+
+  IndexIterator(IndexIterator &&other) noexcept;
+
+  IndexIterator &operator=(IndexIterator &&other) noexcept;
+
+  bool IsEnd() const;
+
+  const MappingType &operator*();
+
+  IndexIterator &operator++();
+
+  bool operator==(const IndexIterator &itr) const;
+
+  bool operator!=(const IndexIterator &itr) const;
+
+ private:
+  /** Moves to the next leaf until the position is valid or the end is reached. */
+  void SkipExhaustedLeaves();
+
+  /** Unlatches and unpins the current leaf, turning this into an end iterator. */
+  void Release();
+
+  BPlusTree<KeyType, ValueType, KeyComparator> *tree_{nullptr};
+  BufferPoolManager *buffer_pool_manager_{nullptr};
+  Page *page_{nullptr};
+  LeafPage *leaf_{nullptr};
+  int index_{0};
+};
+
+}  // namespace bustub
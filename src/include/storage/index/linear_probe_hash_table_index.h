@@ -14,35 +14,62 @@
 
 #include <map>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "container/hash/hash_function.h"
 #include "container/hash/linear_probe_hash_table.h"
+#include "storage/index/covering_value.h"
 #include "storage/index/index.h"
 
 namespace bustub {
 
 #define HASH_TABLE_INDEX_TYPE LinearProbeHashTableIndex<KeyType, ValueType, KeyComparator>
 
+/**
+ * A hash index. With ValueType RID it maps keys to tuples, with a CoveringValue it also stores the included columns
+ * of the index metadata next to every key and answers ScanKeyIncluded on its own.
+ */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 class LinearProbeHashTableIndex : public Index {
  public:
   LinearProbeHashTableIndex(IndexMetadata *metadata, BufferPoolManager *buffer_pool_manager, size_t num_buckets,
-                            const HashFunction<KeyType> &hash_fn);
+                            const HashFunction<KeyType> &hash_fn, bool use_bloom_filter = false);
 
   ~LinearProbeHashTableIndex() override = default;
 
   void InsertEntry(const Tuple &key, RID rid, Transaction *transaction) override;
 
+  void InsertEntry(const Tuple &key, const Tuple &included, RID rid, Transaction *transaction) override;
+
   void DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) override;
 
   void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
 
+  void ScanKeys(const std::vector<Tuple> &keys, std::vector<std::vector<RID>> *results,
+                Transaction *transaction) override;
+
+  bool IsCovering() const override { return !std::is_same_v<ValueType, RID>; }
+
+  void ScanKeyIncluded(const Tuple &key, std::vector<Tuple> *result, Transaction *transaction) override;
+
+  void BulkLoad(TableHeap *table_heap, const Schema &tuple_schema, Transaction *transaction) override;
+
+  /** @return the fraction of the slots of the index that hold tombstones */
+  double GetTombstoneRatio() { return container_.GetTombstoneRatio(); }
+
  protected:
   // comparator for key
   KeyComparator comparator_;
   // container
   LinearProbeHashTable<KeyType, ValueType, KeyComparator> container_;
+
+ private:
+  /** @return the value of the index entry of a tuple, the included columns are ignored by a plain index */
+  ValueType MakeValue(const Tuple *included, RID rid) const;
+
+  /** @return the RIDs of a list of values */
+  static std::vector<RID> ToRids(const std::vector<ValueType> &values);
 };
 
 }  // namespace bustub
@@ -0,0 +1,100 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_internal_page.h
+//
+// Identification: src/include/storage/page/b_plus_tree_internal_page.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+
+#include "storage/page/b_plus_tree_page.h"
+
+namespace bustub {
+
+#define B_PLUS_TREE_INTERNAL_PAGE_TYPE BPlusTreeInternalPage<KeyType, ValueType, KeyComparator>
+#define INTERNAL_PAGE_HEADER_SIZE 20
+#define INTERNAL_PAGE_SIZE ((PAGE_SIZE - INTERNAL_PAGE_HEADER_SIZE) / (sizeof(MappingType)))
+
+/**
+ * Store n indexed keys and n+1 child pointers (page_id) within internal page.
+ * Pointer PAGE_ID(i) points to a subtree in which all keys K satisfy:
+ * K(i) <= K < K(i+1).
+ * NOTE: since the number of keys does not equal to number of child pointers,
+ * the first key always remains invalid. That is to say, any search/lookup
+ * should ignore the first key.
+ *
+ * Internal page format (keys are stored in increasing order):
+ *  --------------------------------------------------------------------------
+ * | HEADER | KEY(1)+PAGE_ID(1) | KEY(2)+PAGE_ID(2) | ... | KEY(n)+PAGE_ID(n) |
+ *  --------------------------------------------------------------------------
+ *
+ * The array has room for one entry more than the max size, so a page may overflow by one child before it is split.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class BPlusTreeInternalPage : public BPlusTreePage {
+ public:
+  // must call initialize method after "create" a new node
+  void Init(page_id_t page_id, int max_size = INTERNAL_PAGE_SIZE - 1);
+
+  KeyType KeyAt(int index) const;
+  void SetKeyAt(int index, const KeyType &key);
+  int ValueIndex(const ValueType &value) const;
+  ValueType ValueAt(int index) const;
+
+  /**
+   * @return the child pointer whose subtree may contain the key
+   */
+  ValueType Lookup(const KeyType &key, const KeyComparator &comparator) const;
+
+  /**
+   * Fills a brand new root with the two halves of a split old root.
+   */
+  void PopulateNewRoot(const ValueType &old_value, const KeyType &new_key, const ValueType &new_value);
+
+  /**
+   * Inserts new_key/new_value right after the entry pointing to old_value.
+   * @return the size after the insertion
+   */
+  int InsertNodeAfter(const ValueType &old_value, const KeyType &new_key, const ValueType &new_value);
+
+  void Remove(int index);
+
+  /**
+   * Appends size children in key order, used by bulk loading. The key of the first child of an empty page is ignored.
+   */
+  void CopyNFrom(const MappingType *items, int size);
+
+  /**
+   * Moves the upper half of the entries into an empty recipient. Afterwards recipient->KeyAt(0) holds the separator
+   * that has to be pushed up into the parent.
+   */
+  void MoveHalfTo(BPlusTreeInternalPage *recipient);
+
+  /**
+   * Appends every entry to the left sibling recipient, pulling middle_key down from the parent.
+   */
+  void MoveAllTo(BPlusTreeInternalPage *recipient, const KeyType &middle_key);
+
+  /**
+   * Moves the first child to the end of the left sibling recipient. Afterwards this->KeyAt(0) holds the new separator.
+   */
+  void MoveFirstToEndOf(BPlusTreeInternalPage *recipient, const KeyType &middle_key);
+
+  /**
+   * Moves the last child to the front of the right sibling recipient. Afterwards recipient->KeyAt(0) holds the new
+   * separator.
+   */
+  void MoveLastToFrontOf(BPlusTreeInternalPage *recipient, const KeyType &middle_key);
+
+ private:
+  MappingType array_[0];
+};
+
+}  // namespace bustub
@@ -0,0 +1,109 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_leaf_page.h
+//
+// Identification: src/include/storage/page/b_plus_tree_leaf_page.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "storage/page/b_plus_tree_page.h"
+
+namespace bustub {
+
+#define B_PLUS_TREE_LEAF_PAGE_TYPE BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>
+#define LEAF_PAGE_HEADER_SIZE 24
+#define LEAF_PAGE_SIZE ((PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) / sizeof(MappingType))
+
+/**
+ * Store indexed key and record id (record id = page id combined with slot id, see include/common/rid.h for detailed
+ * implementation) together within leaf page. Only support unique key.
+ *
+ * Leaf page format (keys are stored in order):
+ *  ----------------------------------------------------------------------
+ * | HEADER | KEY(1) + RID(1) | KEY(2) + RID(2) | ... | KEY(n) + RID(n)
+ *  ----------------------------------------------------------------------
+ *
+ *  Header format (size in byte, 24 bytes in total):
+ *  ---------------------------------------------------------------------
+ * | PageType (4) | LSN (4) | CurrentSize (4) | MaxSize (4) |
+ *  ---------------------------------------------------------------------
+ *  -----------------------------------
+ * | PageId (4) | NextPageId (4) |
+ *  -----------------------------------
+ *
+ * The array has room for one entry more than the max size, so a page may overflow by one entry before it is split.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class BPlusTreeLeafPage : public BPlusTreePage {
+ public:
+  // After creating a new leaf page from buffer pool, must call initialize method to set default values
+  void Init(page_id_t page_id, int max_size = LEAF_PAGE_SIZE - 1);
+
+  page_id_t GetNextPageId() const;
+  void SetNextPageId(page_id_t next_page_id);
+
+  KeyType KeyAt(int index) const;
+  const MappingType &GetItem(int index);
+
+  /**
+   * @return the index of the first key that is >= key, GetSize() if there is none
+   */
+  int KeyIndex(const KeyType &key, const KeyComparator &comparator) const;
+
+  /**
+   * @param[out] value the value stored with the key, if any
+   * @return true if the key exists
+   */
+  bool Lookup(const KeyType &key, ValueType *value, const KeyComparator &comparator) const;
+
+  /**
+   * Inserts the pair in key order.
+   * @return false if the key already exists
+   */
+  bool Insert(const KeyType &key, const ValueType &value, const KeyComparator &comparator);
+
+  /**
+   * @return false if the key does not exist
+   */
+  bool RemoveAndDeleteRecord(const KeyType &key, const KeyComparator &comparator);
+
+  /**
+   * Appends size sorted items that all compare greater than the current last key, used by bulk loading.
+   */
+  void CopyNFrom(const MappingType *items, int size);
+
+  /**
+   * Moves the upper half of the entries into an empty recipient that becomes this page's right sibling.
+   */
+  void MoveHalfTo(BPlusTreeLeafPage *recipient);
+
+  /**
+   * Appends every entry to the left sibling recipient, which takes over this page's next page id.
+   */
+  void MoveAllTo(BPlusTreeLeafPage *recipient);
+
+  /**
+   * Moves the first entry to the end of the left sibling recipient.
+   */
+  void MoveFirstToEndOf(BPlusTreeLeafPage *recipient);
+
+  /**
+   * Moves the last entry to the front of the right sibling recipient.
+   */
+  void MoveLastToFrontOf(BPlusTreeLeafPage *recipient);
+
+ private:
+  page_id_t next_page_id_;
+  MappingType array_[0];
+};
+
+}  // namespace bustub
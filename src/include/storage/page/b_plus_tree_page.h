@@ -0,0 +1,77 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_page.h
+//
+// Identification: src/include/storage/page/b_plus_tree_page.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cassert>
+#include <climits>
+#include <cstdlib>
+#include <string>
+
+#include "buffer/buffer_pool_manager.h"
+#include "storage/index/generic_key.h"
+
+namespace bustub {
+
+#define MappingType std::pair<KeyType, ValueType>
+
+#define INDEX_TEMPLATE_ARGUMENTS template <typename KeyType, typename ValueType, typename KeyComparator>
+
+// define page type enum
+enum class IndexPageType { INVALID_INDEX_PAGE = 0, LEAF_PAGE, INTERNAL_PAGE };
+
+/**
+ * Both internal and leaf page are inherited from this page.
+ *
+ * It actually serves as a header part for each B+ tree page and
+ * contains information shared by both leaf page and internal page.
+ *
+ * Header format (size in byte, 20 bytes in total):
+ * ----------------------------------------------------------------------------
+ * | PageType (4) | LSN (4) | CurrentSize (4) | MaxSize (4) | PageId (4) |
+ * ----------------------------------------------------------------------------
+ *
+ * There is no parent page id: the tree finds parents through the pages it latched on the way down (see BPlusTree).
+ */
+class BPlusTreePage {
+ public:
+  bool IsLeafPage() const;
+  void SetPageType(IndexPageType page_type);
+
+  int GetSize() const;
+  void SetSize(int size);
+  void IncreaseSize(int amount);
+
+  int GetMaxSize() const;
+  void SetMaxSize(int max_size);
+
+  /**
+   * @param is_root whether this page is the root of its tree
+   * @return the smallest size this page may shrink to before it has to be coalesced or redistributed
+   */
+  int GetMinSize(bool is_root) const;
+
+  page_id_t GetPageId() const;
+  void SetPageId(page_id_t page_id);
+
+  void SetLSN(lsn_t lsn = INVALID_LSN);
+
+ private:
+  // member variable, attributes that both internal and leaf page share
+  IndexPageType page_type_;
+  lsn_t lsn_;
+  int size_;
+  int max_size_;
+  page_id_t page_id_;
+};
+
+}  // namespace bustub
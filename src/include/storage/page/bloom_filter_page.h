@@ -0,0 +1,94 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// bloom_filter_page.h
+//
+// Identification: src/include/storage/page/bloom_filter_page.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "common/config.h"
+
+namespace bustub {
+
+/**
+ * One page of a blocked Bloom filter. A filter is a chain of these pages, and every key maps to a single cache line
+ * sized block, in which it sets one bit in each of the block's eight 64-bit words. A lookup thus touches one cache
+ * line, and computing the eight bit positions is the same multiply and shift on every word, which compilers
+ * vectorize.
+ *
+ * The words are atomic, so bits can be set and tested concurrently without a latch.
+ *
+ * Bloom filter page format (size in byte):
+ * ---------------------------------------------------------------------------
+ * | NextPageId (4) | Padding (60) | Block(1) (64) | ... | Block(NUM_BLOCKS) (64)
+ * ---------------------------------------------------------------------------
+ */
+class BloomFilterPage {
+ public:
+  // Delete all constructor / destructor to ensure memory safety
+  BloomFilterPage() = delete;
+
+  /** The size of a block, one cache line. */
+  static constexpr size_t BLOCK_SIZE = 64;
+
+  /** The number of 64-bit words in a block, and the number of bits every key sets. */
+  static constexpr size_t WORDS_PER_BLOCK = BLOCK_SIZE / sizeof(uint64_t);
+
+  /** The number of blocks in a page, the first block sized slot holds the page header. */
+  static constexpr size_t NUM_BLOCKS = PAGE_SIZE / BLOCK_SIZE - 1;
+
+  /**
+   * @return the page id of the next page of the filter, INVALID_PAGE_ID on the last page
+   */
+  page_id_t GetNextPageId() const;
+
+  /**
+   * Sets the page id of the next page of the filter.
+   *
+   * @param next_page_id the next page id
+   */
+  void SetNextPageId(page_id_t next_page_id);
+
+  /**
+   * Sets the bits of a hash in a block.
+   *
+   * @param block_idx the block of the page the hash maps to
+   * @param hash the bits of the hash that were not used to pick the block
+   */
+  void Insert(size_t block_idx, uint32_t hash);
+
+  /**
+   * Tests the bits of a hash in a block.
+   *
+   * @param block_idx the block of the page the hash maps to
+   * @param hash the bits of the hash that were not used to pick the block
+   * @return false if the hash was never inserted, true if it may have been
+   */
+  bool MayContain(size_t block_idx, uint32_t hash) const;
+
+ private:
+  /**
+   * Computes the bit a hash sets in every word of its block.
+   *
+   * @param hash the hash
+   * @param[out] masks one single bit mask per word
+   */
+  static void Masks(uint32_t hash, uint64_t masks[WORDS_PER_BLOCK]);
+
+  page_id_t next_page_id_;
+  __attribute__((unused)) char padding_[BLOCK_SIZE - sizeof(page_id_t)];
+  std::atomic<uint64_t> blocks_[NUM_BLOCKS][WORDS_PER_BLOCK];
+};
+
+static_assert(sizeof(BloomFilterPage) == PAGE_SIZE, "A Bloom filter page must fill exactly one page.");
+
+}  // namespace bustub
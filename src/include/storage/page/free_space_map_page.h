@@ -0,0 +1,103 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map_page.h
+//
+// Identification: src/include/storage/page/free_space_map_page.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+
+#include "common/config.h"
+
+namespace bustub {
+
+/**
+ * One page of a free-space map. A free-space map is a chain of these pages that records, for every page of a table
+ * heap in the order the pages were added, the free space of the page as a category, i.e. in units of some number of
+ * bytes rounded down.
+ *
+ * Free-space map page format (size in byte):
+ * -------------------------------------------------------------------------------------
+ * | NextPageId (4) | NumEntries (4) | TablePageId(1) (4) | ... | TablePageId(CAPACITY) (4) |
+ * -------------------------------------------------------------------------------------
+ * -------------------------------------------------
+ * | Category(1) (1) | ... | Category(CAPACITY) (1) |
+ * -------------------------------------------------
+ */
+class FreeSpaceMapPage {
+ public:
+  // Delete all constructor / destructor to ensure memory safety
+  FreeSpaceMapPage() = delete;
+
+  /** The number of table pages a single page of the map holds. */
+  static constexpr uint32_t CAPACITY =
+      (PAGE_SIZE - sizeof(page_id_t) - sizeof(uint32_t)) / (sizeof(page_id_t) + sizeof(uint8_t));
+
+  /**
+   * Initializes an empty map page at the end of the chain.
+   */
+  void Init();
+
+  /**
+   * @return the page id of the next page of the map, INVALID_PAGE_ID on the last page
+   */
+  page_id_t GetNextPageId() const;
+
+  /**
+   * Sets the page id of the next page of the map.
+   *
+   * @param next_page_id the next page id
+   */
+  void SetNextPageId(page_id_t next_page_id);
+
+  /**
+   * @return the number of table pages in this page of the map
+   */
+  uint32_t GetNumEntries() const;
+
+  /**
+   * @param entry_idx the index of an entry in this page
+   * @return the id of the table page of the entry
+   */
+  page_id_t GetTablePageId(uint32_t entry_idx) const;
+
+  /**
+   * @param entry_idx the index of an entry in this page
+   * @return the free space category of the table page of the entry
+   */
+  uint8_t GetCategory(uint32_t entry_idx) const;
+
+  /**
+   * Sets the free space category of the table page of an entry.
+   *
+   * @param entry_idx the index of an entry in this page
+   * @param category the new category
+   */
+  void SetCategory(uint32_t entry_idx, uint8_t category);
+
+  /**
+   * Adds a table page at the end of this page.
+   *
+   * @param table_page_id the id of the table page
+   * @param category the free space category of the table page
+   * @return false if this page is full, true otherwise
+   */
+  bool Append(page_id_t table_page_id, uint8_t category);
+
+ private:
+  page_id_t next_page_id_;
+  uint32_t num_entries_;
+  page_id_t table_page_ids_[CAPACITY];
+  uint8_t categories_[CAPACITY];
+};
+
+static_assert(sizeof(FreeSpaceMapPage) <= PAGE_SIZE, "A free-space map page must fit into one page.");
+
+}  // namespace bustub
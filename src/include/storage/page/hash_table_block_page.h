@@ -93,6 +93,30 @@ class HashTableBlockPage {
    */
   bool IsReadable(slot_offset_t bucket_ind) const;
 
+  /**
+   * Asks the CPU to start loading the key and value at an index into the cache.
+   *
+   * @param bucket_ind index that is about to be read
+   */
+  void Prefetch(slot_offset_t bucket_ind) const;
+
+  /**
+   * Turns a tombstone back into a never occupied index. Only valid if no probe chain runs through the index.
+   *
+   * @param bucket_ind index to clear
+   */
+  void Clear(slot_offset_t bucket_ind);
+
+  /**
+   * @return the number of occupied indexes (key/value pairs and tombstones)
+   */
+  size_t NumOccupied() const;
+
+  /**
+   * @return the number of readable indexes (key/value pairs)
+   */
+  size_t NumReadable() const;
+
  private:
   std::atomic_char occupied_[(BLOCK_ARRAY_SIZE - 1) / 8 + 1];
 
@@ -0,0 +1,171 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// hash_table_directory_page.h
+//
+// Identification: src/include/storage/page/hash_table_directory_page.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cassert>
+#include <climits>
+#include <cstdlib>
+#include <string>
+
+#include "common/config.h"
+#include "storage/index/generic_key.h"
+#include "storage/page/hash_table_page_defs.h"
+
+namespace bustub {
+
+/**
+ *
+ * Directory Page for extendible hash table.
+ *
+ * Directory format (size in byte):
+ * --------------------------------------------------------------------------------------------
+ * | LSN (4) | PageId(4) | GlobalDepth(4) | LocalDepths(512) | BucketPageIds(2048) | Free(1524)
+ * --------------------------------------------------------------------------------------------
+ */
+class HashTableDirectoryPage {
+ public:
+  /**
+   * @return the page ID of this page
+   */
+  page_id_t GetPageId() const;
+
+  /**
+   * Sets the page ID of this page
+   *
+   * @param page_id the page id for the page id field to be set to
+   */
+  void SetPageId(page_id_t page_id);
+
+  /**
+   * @return the lsn of this page
+   */
+  lsn_t GetLSN() const;
+
+  /**
+   * Sets the LSN of this page
+   *
+   * @param lsn the log sequence number for the lsn field to be set to
+   */
+  void SetLSN(lsn_t lsn);
+
+  /**
+   * Lookup a bucket page using a directory index
+   *
+   * @param bucket_idx the index in the directory to lookup
+   * @return bucket page_id corresponding to bucket_idx
+   */
+  page_id_t GetBucketPageId(uint32_t bucket_idx) const;
+
+  /**
+   * Updates the directory index using a bucket index and page_id
+   *
+   * @param bucket_idx directory index at which to insert page_id
+   * @param bucket_page_id page_id to insert
+   */
+  void SetBucketPageId(uint32_t bucket_idx, page_id_t bucket_page_id);
+
+  /**
+   * Gets the split image of an index, i.e. the directory index that differs from bucket_idx only in the highest bit
+   * covered by its local depth.
+   *
+   * @param bucket_idx the directory index for which to find the split image
+   * @return the directory index of the split image
+   */
+  uint32_t GetSplitImageIndex(uint32_t bucket_idx) const;
+
+  /**
+   * @return a mask of global_depth 1's and the rest 0's, used to map a hash to a directory index
+   */
+  uint32_t GetGlobalDepthMask() const;
+
+  /**
+   * @param bucket_idx the directory index
+   * @return a mask of local_depth 1's and the rest 0's for the bucket at bucket_idx
+   */
+  uint32_t GetLocalDepthMask(uint32_t bucket_idx) const;
+
+  /**
+   * @return the global depth of the hash table directory
+   */
+  uint32_t GetGlobalDepth() const;
+
+  /**
+   * Doubles the directory: every entry in the lower half is mirrored into the upper half.
+   */
+  void IncrGlobalDepth();
+
+  /**
+   * Halves the directory. Only valid when CanShrink() is true.
+   */
+  void DecrGlobalDepth();
+
+  /**
+   * @return true if the directory can be shrunk, i.e. every local depth is below the global depth
+   */
+  bool CanShrink() const;
+
+  /**
+   * @return the current directory size, i.e. 2^global_depth
+   */
+  uint32_t Size() const;
+
+  /**
+   * @return the largest size the directory can grow to
+   */
+  static constexpr uint32_t MaxSize() { return DIRECTORY_ARRAY_SIZE; }
+
+  /**
+   * Gets the local depth of the bucket at bucket_idx
+   *
+   * @param bucket_idx the bucket index to lookup
+   * @return the local depth of the bucket at bucket_idx
+   */
+  uint32_t GetLocalDepth(uint32_t bucket_idx) const;
+
+  /**
+   * Set the local depth of the bucket at bucket_idx to local_depth
+   *
+   * @param bucket_idx bucket index to update
+   * @param local_depth new local depth
+   */
+  void SetLocalDepth(uint32_t bucket_idx, uint8_t local_depth);
+
+  /**
+   * Increment the local depth of the bucket at bucket_idx
+   * @param bucket_idx bucket index to increment
+   */
+  void IncrLocalDepth(uint32_t bucket_idx);
+
+  /**
+   * Decrement the local depth of the bucket at bucket_idx
+   * @param bucket_idx bucket index to decrement
+   */
+  void DecrLocalDepth(uint32_t bucket_idx);
+
+  /**
+   * Verifies the following invariants and asserts if any of them is broken:
+   * (1) all local depths <= global depth
+   * (2) each bucket has exactly 2^(global depth - local depth) pointers pointing to it
+   * (3) the local depth is the same at each index with the same bucket page id
+   */
+  void VerifyIntegrity() const;
+
+ private:
+  lsn_t lsn_;
+  page_id_t page_id_;
+  uint32_t global_depth_;
+  uint8_t local_depths_[DIRECTORY_ARRAY_SIZE];
+  page_id_t bucket_page_ids_[DIRECTORY_ARRAY_SIZE];
+};
+
+}  // namespace bustub
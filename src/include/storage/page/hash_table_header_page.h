@@ -26,10 +26,12 @@ namespace bustub {
  *
  * Header Page for linear probing hash table.
  *
- * Header format (size in byte, 16 bytes in total):
- * -------------------------------------------------------------
- * | LSN (4) | Size (4) | PageId(4) | NextBlockIndex(4)
- * -------------------------------------------------------------
+ * Header format (size in byte, 48 bytes in total with padding):
+ * ------------------------------------------------------------------------------------------------
+ * | LSN (4) | Size (8) | PageId(4) | NextBlockIndex(8) | NumPairs (4) | NumTombstones (4) |
+ * ------------------------------------------------------------------------------------------------
+ * | FilterPageId (4) | BlockPageIds
+ * ------------------------------------------------------------------------------------------------
  */
 class HashTableHeaderPage {
  public:
@@ -89,11 +91,35 @@ class HashTableHeaderPage {
    */
   size_t NumBlocks();
 
+  /**
+   * Records the pair and tombstone counts of the table. The table keeps its counts in memory while it is used, and
+   * only writes them here when a resize finishes and after a bulk load.
+   *
+   * @param num_pairs the number of pairs
+   * @param num_tombstones the number of tombstones
+   */
+  void SetCounts(size_t num_pairs, size_t num_tombstones);
+
+  /**
+   * Records the page id of the first page of the Bloom filter of the table, INVALID_PAGE_ID if it has none.
+   *
+   * @param filter_page_id the page id
+   */
+  void SetFilterPageId(page_id_t filter_page_id);
+
+  /**
+   * @return the largest number of blocks a header page can address
+   */
+  static constexpr size_t MaxNumBlocks() { return (PAGE_SIZE - sizeof(HashTableHeaderPage)) / sizeof(page_id_t); }
+
  private:
   __attribute__((unused)) lsn_t lsn_;
   __attribute__((unused)) size_t size_;
   __attribute__((unused)) page_id_t page_id_;
   __attribute__((unused)) size_t next_ind_;
+  __attribute__((unused)) uint32_t num_pairs_;
+  __attribute__((unused)) uint32_t num_tombstones_;
+  __attribute__((unused)) page_id_t filter_page_id_;
   __attribute__((unused)) page_id_t block_page_ids_[0];
 };
 
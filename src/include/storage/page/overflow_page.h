@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// overflow_page.h
+//
+// Identification: src/include/storage/page/overflow_page.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+
+#include "common/config.h"
+
+namespace bustub {
+
+/**
+ * One page of an overflow chain. A varlen value that is too large to keep in its tuple is stored in a chain of these
+ * pages, each holding the next piece of the value's bytes, and the tuple only keeps the id of the first page.
+ *
+ * Overflow page format (size in byte):
+ * --------------------------------------------------
+ * | NextPageId (4) | DataSize (4) | Data (CAPACITY) |
+ * --------------------------------------------------
+ */
+class OverflowPage {
+ public:
+  // Delete all constructor / destructor to ensure memory safety
+  OverflowPage() = delete;
+
+  /** The number of value bytes a single overflow page holds. */
+  static constexpr uint32_t CAPACITY = PAGE_SIZE - sizeof(page_id_t) - sizeof(uint32_t);
+
+  /**
+   * Initializes an empty overflow page at the end of the chain.
+   */
+  void Init();
+
+  /**
+   * @return the page id of the next page of the chain, INVALID_PAGE_ID on the last page
+   */
+  page_id_t GetNextPageId() const;
+
+  /**
+   * Sets the page id of the next page of the chain.
+   *
+   * @param next_page_id the next page id
+   */
+  void SetNextPageId(page_id_t next_page_id);
+
+  /**
+   * @return the number of value bytes in this page
+   */
+  uint32_t GetDataSize() const;
+
+  /**
+   * Sets the number of value bytes in this page.
+   *
+   * @param data_size the number of bytes, at most CAPACITY
+   */
+  void SetDataSize(uint32_t data_size);
+
+  /**
+   * @return the value bytes of this page
+   */
+  const char *GetData() const;
+
+  /**
+   * @return the value bytes of this page, for writing
+   */
+  char *GetData();
+
+ private:
+  page_id_t next_page_id_;
+  uint32_t data_size_;
+  char data_[CAPACITY];
+};
+
+static_assert(sizeof(OverflowPage) == PAGE_SIZE, "An overflow page must fill exactly one page.");
+
+}  // namespace bustub
@@ -0,0 +1,182 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// pax_page.h
+//
+// Identification: src/include/storage/page/pax_page.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstring>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/rid.h"
+#include "storage/page/page.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * PaxLayout computes where the minipages of a schema lie in a PaxPage. Every page of a table has the same layout, so
+ * the table computes it once and passes it to the page methods.
+ */
+class PaxLayout {
+ public:
+  /**
+   * Computes the layout of a schema.
+   * @param schema the schema of the table
+   */
+  explicit PaxLayout(const Schema &schema);
+
+  /** @return the schema of the table */
+  const Schema &GetSchema() const { return schema_; }
+
+  /** @return the number of rows a page has room for */
+  uint32_t GetCapacity() const { return capacity_; }
+
+  /** @return the size of a value in the minipage of a column, the offset into the varlen area for varlen columns */
+  uint32_t GetWidth(uint32_t column_idx) const {
+    const auto &col = schema_.GetColumn(column_idx);
+    return col.IsInlined() ? col.GetFixedLength() : sizeof(uint32_t);
+  }
+
+  /** @return the offset of the minipage of a column in the page */
+  uint32_t GetMinipageOffset(uint32_t column_idx) const { return minipage_offsets_[column_idx]; }
+
+  /** @return the end of the last minipage, the varlen area may grow down to it */
+  uint32_t GetMinipagesEnd() const { return minipages_end_; }
+
+ private:
+  Schema schema_;
+  uint32_t capacity_;
+  std::vector<uint32_t> minipage_offsets_;
+  uint32_t minipages_end_;
+};
+
+/**
+ * PAX (Partition Attributes Across) page format. A page holds up to capacity rows, and every column gets a minipage
+ * of capacity values, so a scan that reads one column walks one contiguous array instead of every tuple. Varlen
+ * columns keep the offsets of their values in their minipage, and the values themselves in a varlen area that grows
+ * down from the end of the page.
+ *
+ *  ---------------------------------------------------------------------------------------------------
+ *  | HEADER | Deleted flags | Minipage(0) | ... | Minipage(n-1) | ... FREE SPACE ... | VARLEN AREA |
+ *  ---------------------------------------------------------------------------------------------------
+ *                                                                                   ^
+ *                                                                                   free space pointer
+ *
+ *  Header format (size in bytes):
+ *  -----------------------------------------------------------------------------------------------
+ *  | PageId (4) | LSN (4) | NextPageId (4) | NumRows (4) | NumLiveRows (4) | FreeSpacePointer (4) |
+ *  -----------------------------------------------------------------------------------------------
+ *
+ *  The deleted flags hold one byte per row, and every minipage starts at an 8 byte boundary. Rows are only ever
+ *  appended, deleting a row just sets its flag.
+ */
+class PaxPage : public Page {
+ public:
+  /** The size of the page header. */
+  static constexpr uint32_t HEADER_SIZE = 24;
+
+  /**
+   * Initialize the PaxPage header.
+   * @param page_id the page ID of this page
+   */
+  void Init(page_id_t page_id);
+
+  /** @return the page ID of this page */
+  page_id_t GetPaxPageId() { return *reinterpret_cast<page_id_t *>(GetData()); }
+
+  /** @return the page ID of the next page of the table */
+  page_id_t GetNextPageId() { return *reinterpret_cast<page_id_t *>(GetData() + OFFSET_NEXT_PAGE_ID); }
+
+  /** Set the page id of the next page in the table. */
+  void SetNextPageId(page_id_t next_page_id) {
+    memcpy(GetData() + OFFSET_NEXT_PAGE_ID, &next_page_id, sizeof(page_id_t));
+  }
+
+  /** @return the number of rows in the page, including deleted ones */
+  uint32_t GetNumRows() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_NUM_ROWS); }
+
+  /** @return the number of rows in the page that are not deleted */
+  uint32_t GetNumLiveRows() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_NUM_LIVE_ROWS); }
+
+  /** @return true if the row was deleted */
+  bool IsDeleted(uint32_t row) { return GetData()[HEADER_SIZE + row] != 0; }
+
+  /**
+   * @param layout the layout of the table
+   * @param column_idx the index of a column in the schema
+   * @return the minipage of the column, GetNumRows values of GetWidth bytes each
+   */
+  const char *GetMinipage(const PaxLayout &layout, uint32_t column_idx) {
+    return GetData() + layout.GetMinipageOffset(column_idx);
+  }
+
+  /**
+   * Append a tuple to the page, splitting it up into its columns.
+   * @param layout the layout of the table
+   * @param tuple the tuple to insert
+   * @param[out] rid rid of the inserted tuple
+   * @return true if the insert is successful (i.e. there is a free row and enough varlen space)
+   */
+  bool InsertTuple(const PaxLayout &layout, const Tuple &tuple, RID *rid);
+
+  /**
+   * Mark a row as deleted.
+   * @param rid rid of the row
+   * @return true if the row existed and was not deleted yet
+   */
+  bool ApplyDelete(const RID &rid);
+
+  /**
+   * Read a row back into a tuple.
+   * @param layout the layout of the table
+   * @param rid rid of the row
+   * @param[out] tuple the tuple
+   * @return true if the read is successful (i.e. the row exists and is not deleted)
+   */
+  bool GetTuple(const PaxLayout &layout, const RID &rid, Tuple *tuple);
+
+  /**
+   * Read all rows of the page that are not deleted back into tuples. The tuples are assembled a column at a time, so
+   * every minipage is read sequentially.
+   * @param layout the layout of the table
+   * @param[out] tuples the tuples are appended to it in row order
+   */
+  void GetTuples(const PaxLayout &layout, std::vector<Tuple> *tuples);
+
+ private:
+  static_assert(sizeof(page_id_t) == 4);
+
+  static constexpr size_t OFFSET_NEXT_PAGE_ID = 8;
+  static constexpr size_t OFFSET_NUM_ROWS = 12;
+  static constexpr size_t OFFSET_NUM_LIVE_ROWS = 16;
+  static constexpr size_t OFFSET_FREE_SPACE = 20;
+
+  /** @return the size of a serialized varlen value, its length prefix included */
+  static uint32_t VarlenSize(const char *value);
+
+  uint32_t GetFreeSpacePointer() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_FREE_SPACE); }
+
+  void SetFreeSpacePointer(uint32_t free_space_pointer) {
+    memcpy(GetData() + OFFSET_FREE_SPACE, &free_space_pointer, sizeof(uint32_t));
+  }
+
+  void SetNumRows(uint32_t num_rows) { memcpy(GetData() + OFFSET_NUM_ROWS, &num_rows, sizeof(uint32_t)); }
+
+  void SetNumLiveRows(uint32_t num_live_rows) {
+    memcpy(GetData() + OFFSET_NUM_LIVE_ROWS, &num_live_rows, sizeof(uint32_t));
+  }
+
+  /** Assembles the tuples of some rows, one column at a time. */
+  void AssembleTuples(const PaxLayout &layout, const std::vector<uint32_t> &rows, Tuple *tuples);
+};
+
+}  // namespace bustub
@@ -19,6 +19,7 @@
 #include "recovery/log_manager.h"
 #include "storage/page/page.h"
 #include "storage/table/tuple.h"
+#include "storage/table/tuple_view.h"
 
 static constexpr uint64_t DELETE_MASK = (1U << (8 * sizeof(uint32_t) - 1));
 
@@ -36,10 +37,17 @@ namespace bustub {
  *  ----------------------------------------------------------------------------
  *  | PageId (4)| LSN (4)| PrevPageId (4)| NextPageId (4)| FreeSpacePointer(4) |
  *  ----------------------------------------------------------------------------
- *  ----------------------------------------------------------------
- *  | TupleCount (4) | Tuple_1 offset (4) | Tuple_1 size (4) | ... |
- *  ----------------------------------------------------------------
+ *  ------------------------------------------------------------------
+ *  | TupleCount (4) | FreeSlotHead (4) | FragmentedBytes (4) | ... |
+ *  ------------------------------------------------------------------
+ *  ------------------------------------------------------
+ *  | ... | Tuple_1 offset (4) | Tuple_1 size (4) | ... |
+ *  ------------------------------------------------------
  *
+ *  Empty slots, i.e. slots with size 0, form a chain starting at FreeSlotHead, where the offset of every empty slot
+ *  is the next empty slot, so inserts reuse a slot without searching for one. Deleting a tuple leaves a hole in the
+ *  tuple area, counted in FragmentedBytes, and the holes are only compacted away when an insert or update needs more
+ *  contiguous space than there is between the slots and the free space pointer.
  */
 class TablePage : public Page {
  public:
@@ -83,6 +91,15 @@ class TablePage : public Page {
    */
   bool InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn, LockManager *lock_manager, LogManager *log_manager);
 
+  /**
+   * Append a tuple in a new slot after the last one. Unlike InsertTuple this does not look for an empty slot to reuse,
+   * and it neither locks nor logs, so it is only for bulk inserts while logging is disabled.
+   * @param tuple tuple to append
+   * @param[out] rid rid of the appended tuple
+   * @return true if the append is successful (i.e. there is enough space)
+   */
+  bool AppendTuple(const Tuple &tuple, RID *rid);
+
   /**
    * Mark a tuple as deleted. This does not actually delete the tuple.
    * @param rid rid of the tuple to mark as deleted
@@ -106,6 +123,21 @@ class TablePage : public Page {
   bool UpdateTuple(const Tuple &new_tuple, Tuple *old_tuple, const RID &rid, Transaction *txn,
                    LockManager *lock_manager, LogManager *log_manager);
 
+  /**
+   * Overwrite a fixed-width column of a tuple in place. Neither the size of the tuple nor any other tuple changes, so
+   * only the bytes of the column are written, and only the column is logged.
+   * @param new_value new value of the column, of the type of the column
+   * @param[out] old_value old value of the column
+   * @param rid rid of the tuple
+   * @param column_offset the offset of the column in the tuple
+   * @param txn transaction performing the update
+   * @param lock_manager the lock manager
+   * @param log_manager the log manager
+   * @return true if updating the column succeeded
+   */
+  bool UpdateColumn(const Value &new_value, Value *old_value, const RID &rid, uint32_t column_offset,
+                    Transaction *txn, LockManager *lock_manager, LogManager *log_manager);
+
   /** To be called on commit or abort. Actually perform the delete or rollback an insert. */
   void ApplyDelete(const RID &rid, Transaction *txn, LogManager *log_manager);
 
@@ -122,6 +154,26 @@ class TablePage : public Page {
    */
   bool GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockManager *lock_manager);
 
+  /**
+   * Read a tuple from a table without copying it. The view is only valid while this page stays pinned and latched.
+   * Unlike GetTuple, a deleted tuple does not abort the transaction, so scans can skip over it.
+   * @param rid rid of the tuple to read
+   * @param[out] view a view of the tuple in this page
+   * @param txn transaction performing the read
+   * @param lock_manager the lock manager
+   * @return true if the read is successful (i.e. the tuple exists)
+   */
+  bool GetTupleView(const RID &rid, TupleView *view, Transaction *txn, LockManager *lock_manager);
+
+  /**
+   * View a tuple without locking it, whether it is marked deleted or not, for bookkeeping that must see every tuple
+   * the page holds.
+   * @param rid rid of the tuple to view
+   * @param[out] view a view of the tuple, valid as long as the page stays pinned and latched
+   * @return true if the slot holds a tuple
+   */
+  bool GetRawTupleView(const RID &rid, TupleView *view);
+
   /** @return the rid of the first tuple in this page */
 
   /**
@@ -137,17 +189,34 @@ class TablePage : public Page {
    */
   bool GetNextTupleRid(const RID &cur_rid, RID *next_rid);
 
+  /** @return the number of bytes that can still be claimed for tuples and their slots, holes included */
+  uint32_t GetFreeSpaceRemaining() { return GetContiguousFreeSpace() + GetFragmentedBytes(); }
+
+  /** @return the size of the largest tuple that fits into an empty page */
+  static constexpr uint32_t MaxTupleSize() {
+    return static_cast<uint32_t>(PAGE_SIZE - SIZE_TABLE_PAGE_HEADER - SIZE_TUPLE);
+  }
+
+  /** @return the free space a page needs to take a tuple of the given size */
+  static constexpr uint32_t SpaceForTuple(uint32_t tuple_size) {
+    return static_cast<uint32_t>(tuple_size + SIZE_TUPLE);
+  }
+
  private:
   static_assert(sizeof(page_id_t) == 4);
 
-  static constexpr size_t SIZE_TABLE_PAGE_HEADER = 24;
+  static constexpr size_t SIZE_TABLE_PAGE_HEADER = 32;
   static constexpr size_t SIZE_TUPLE = 8;
   static constexpr size_t OFFSET_PREV_PAGE_ID = 8;
   static constexpr size_t OFFSET_NEXT_PAGE_ID = 12;
   static constexpr size_t OFFSET_FREE_SPACE = 16;
   static constexpr size_t OFFSET_TUPLE_COUNT = 20;
-  static constexpr size_t OFFSET_TUPLE_OFFSET = 24;  // Naming things is hard.
-  static constexpr size_t OFFSET_TUPLE_SIZE = 28;
+  static constexpr size_t OFFSET_FREE_SLOT_HEAD = 24;
+  static constexpr size_t OFFSET_FRAGMENTED_BYTES = 28;
+  static constexpr size_t OFFSET_TUPLE_OFFSET = 32;  // Naming things is hard.
+  static constexpr size_t OFFSET_TUPLE_SIZE = 36;
+  /** Ends the chain of empty slots. */
+  static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
 
   /** @return pointer to the end of the current free space, see header comment */
   uint32_t GetFreeSpacePointer() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_FREE_SPACE); }
@@ -166,10 +235,35 @@ class TablePage : public Page {
   /** Set the number of tuples in this page. */
   void SetTupleCount(uint32_t tuple_count) { memcpy(GetData() + OFFSET_TUPLE_COUNT, &tuple_count, sizeof(uint32_t)); }
 
-  uint32_t GetFreeSpaceRemaining() {
+  /** @return the first empty slot, INVALID_SLOT if there is none */
+  uint32_t GetFreeSlotHead() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_FREE_SLOT_HEAD); }
+
+  /** Set the first empty slot. */
+  void SetFreeSlotHead(uint32_t slot_num) { memcpy(GetData() + OFFSET_FREE_SLOT_HEAD, &slot_num, sizeof(uint32_t)); }
+
+  /** @return the number of bytes of deleted tuples that have not been compacted away yet */
+  uint32_t GetFragmentedBytes() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_FRAGMENTED_BYTES); }
+
+  /** Set the number of bytes of deleted tuples that have not been compacted away yet. */
+  void SetFragmentedBytes(uint32_t bytes) { memcpy(GetData() + OFFSET_FRAGMENTED_BYTES, &bytes, sizeof(uint32_t)); }
+
+  /** @return the free space between the slots and the free space pointer */
+  uint32_t GetContiguousFreeSpace() {
     return GetFreeSpacePointer() - SIZE_TABLE_PAGE_HEADER - SIZE_TUPLE * GetTupleCount();
   }
 
+  /** Moves all tuples to the end of the page, which turns the holes of deleted tuples into contiguous free space. */
+  void Compact();
+
+  /**
+   * Claims a slot and contiguous space for a tuple, compacting the page if needed.
+   * @param tuple_size the size of the tuple
+   * @param[out] slot_num the claimed slot
+   * @param reuse_slot whether an empty slot may be reused, otherwise a new slot is added after the last one
+   * @return false if the page has not enough space
+   */
+  bool ClaimSpace(uint32_t tuple_size, uint32_t *slot_num, bool reuse_slot);
+
   /** @return tuple offset at slot slot_num */
   uint32_t GetTupleOffsetAtSlot(uint32_t slot_num) {
     return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_TUPLE_OFFSET + SIZE_TUPLE * slot_num);
@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_page_guard.h
+//
+// Identification: src/include/storage/page/table_page_guard.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "buffer/buffer_pool_manager.h"
+#include "storage/page/table_page.h"
+
+namespace bustub {
+
+/**
+ * TablePageGuard pins a table page and holds its read latch for as long as the guard lives. TupleViews into the page
+ * are valid for the same time.
+ */
+class TablePageGuard {
+ public:
+  /** Creates an empty guard that holds no page. */
+  TablePageGuard() : buffer_pool_manager_(nullptr), page_(nullptr) {}
+
+  /**
+   * Fetches and read latches a table page.
+   * @param buffer_pool_manager the buffer pool manager
+   * @param page_id the id of the table page
+   */
+  TablePageGuard(BufferPoolManager *buffer_pool_manager, page_id_t page_id)
+      : buffer_pool_manager_(buffer_pool_manager),
+        page_(static_cast<TablePage *>(buffer_pool_manager->FetchPage(page_id))) {
+    if (page_ != nullptr) {
+      page_->RLatch();
+    }
+  }
+
+  ~TablePageGuard() { Release(); }
+
+  TablePageGuard(const TablePageGuard &) = delete;
+  TablePageGuard &operator=(const TablePageGuard &) = delete;
+
+  TablePageGuard(TablePageGuard &&other) noexcept
+      : buffer_pool_manager_(other.buffer_pool_manager_), page_(other.page_) {
+    other.page_ = nullptr;
+  }
+
+  TablePageGuard &operator=(TablePageGuard &&other) noexcept {
+    if (this != &other) {
+      Release();
+      buffer_pool_manager_ = other.buffer_pool_manager_;
+      page_ = other.page_;
+      other.page_ = nullptr;
+    }
+    return *this;
+  }
+
+  /** @return the guarded page, nullptr if it could not be fetched */
+  TablePage *GetPage() const { return page_; }
+
+  /** Unlatches and unpins the page early. */
+  void Release() {
+    if (page_ != nullptr) {
+      page_->RUnlatch();
+      buffer_pool_manager_->UnpinPage(page_->GetTablePageId(), false);
+      page_ = nullptr;
+    }
+  }
+
+ private:
+  BufferPoolManager *buffer_pool_manager_;
+  TablePage *page_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map.h
+//
+// Identification: src/include/storage/table/free_space_map.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <mutex>  // NOLINT
+#include <unordered_map>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "storage/page/free_space_map_page.h"
+
+namespace bustub {
+
+/**
+ * FreeSpaceMap tracks the approximate free space of every page of a table heap, so inserts can go straight to a page
+ * with room instead of walking the page chain.
+ *
+ * The free space of a page is kept as a category, the free bytes divided by CATEGORY_SIZE and rounded down, so a page
+ * of category c has room for at least c * CATEGORY_SIZE bytes. The categories are persisted in a chain of
+ * FreeSpaceMapPages, updated in place whenever a category changes. In memory they are the leaves of a max tree, which
+ * finds the first page of the chain that has room for a tuple in a logarithmic number of steps.
+ *
+ * Since every table page is added when it is linked, the map also serves as the persisted directory of the pages of
+ * the table, in chain order, which lets scans split the table without walking the chain.
+ *
+ * The map is a hint and is not logged: a page may have less room than its category says if an update raced with
+ * another, so callers must handle a failed insert by updating the category and looking again.
+ */
+class FreeSpaceMap {
+ public:
+  /** The number of bytes of free space per category. */
+  static constexpr uint32_t CATEGORY_SIZE = 32;
+
+  /**
+   * Creates a new, empty free-space map.
+   * @param buffer_pool_manager the buffer pool manager
+   */
+  explicit FreeSpaceMap(BufferPoolManager *buffer_pool_manager);
+
+  /**
+   * Opens a persisted free-space map.
+   * @param buffer_pool_manager the buffer pool manager
+   * @param first_page_id the id of the first page of the map
+   */
+  FreeSpaceMap(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id);
+
+  /** @return the id of the first page of the map */
+  page_id_t GetFirstPageId() const { return map_page_ids_.front(); }
+
+  /**
+   * Adds a table page at the end of the map.
+   * @param table_page_id the id of the table page
+   * @param free_space the free bytes of the table page
+   */
+  void AddPage(page_id_t table_page_id, uint32_t free_space);
+
+  /**
+   * Records the free space of a table page in the map.
+   * @param table_page_id the id of the table page
+   * @param free_space the free bytes of the table page
+   */
+  void UpdatePage(page_id_t table_page_id, uint32_t free_space);
+
+  /**
+   * Finds the first page of the map with at least the given free space.
+   * @param space the number of bytes needed
+   * @return the id of the table page, INVALID_PAGE_ID if no page has room
+   */
+  page_id_t FindPage(uint32_t space);
+
+  /** @return the id of the last table page of the map, INVALID_PAGE_ID if the map is empty */
+  page_id_t GetLastPageId();
+
+  /** @return the number of table pages in the map */
+  size_t GetNumPages();
+
+  /** @return the ids of the table pages, in the order they were added */
+  std::vector<page_id_t> GetPageIds();
+
+ private:
+  /** @return the category of a page with the given free bytes */
+  static uint8_t ToCategory(uint32_t free_space);
+
+  /** Sets the category of the table page at the given position of the map in memory and on its map page. */
+  void SetCategory(size_t idx, uint8_t category);
+
+  /** Adds a table page in memory, growing the tree if needed. */
+  void AddLeaf(page_id_t table_page_id, uint8_t category);
+
+  BufferPoolManager *buffer_pool_manager_;
+  std::mutex latch_;
+  /** the pages of the map, in chain order */
+  std::vector<page_id_t> map_page_ids_;
+  /** the table pages, in the order they were added */
+  std::vector<page_id_t> table_page_ids_;
+  /** the position of every table page in table_page_ids_ */
+  std::unordered_map<page_id_t, size_t> positions_;
+  /** the number of leaves of the tree, a power of two */
+  size_t num_leaves_{1};
+  /** the max tree over the categories, node i has children 2i and 2i + 1 and the leaves start at num_leaves_ */
+  std::vector<uint8_t> tree_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,125 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// overflow_chain.h
+//
+// Identification: src/include/storage/table/overflow_chain.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/config.h"
+#include "type/limits.h"
+
+namespace bustub {
+
+/** The bit of the length of a varlen value that marks the value as stored out of line, in an overflow chain. */
+static constexpr uint32_t OVERFLOW_FLAG = 1U << 31;
+/** Tuples larger than this get their largest varlen values moved out of line until they are no longer. */
+static constexpr uint32_t OVERFLOW_TUPLE_THRESHOLD = PAGE_SIZE / 4;
+/** Varlen values shorter than this always stay in their tuple. */
+static constexpr uint32_t OVERFLOW_VALUE_THRESHOLD = 64;
+/** What an out-of-line value leaves in its tuple: its length with OVERFLOW_FLAG set, and its first overflow page. */
+static constexpr uint32_t OVERFLOW_POINTER_SIZE = sizeof(uint32_t) + sizeof(page_id_t);
+
+/**
+ * @param varlen a serialized varlen value in a tuple, i.e. its length followed by its bytes or an overflow pointer
+ * @return true if the value is stored out of line
+ */
+inline bool IsOverflowValue(const char *varlen) {
+  uint32_t len = *reinterpret_cast<const uint32_t *>(varlen);
+  return len != BUSTUB_VALUE_NULL && (len & OVERFLOW_FLAG) != 0;
+}
+
+/**
+ * VarlenReader streams the bytes of a serialized varlen value a piece at a time, whether the value is in its tuple
+ * or out of line, so reading a large value never needs a buffer of its full size. Overflow pages are only fetched
+ * by Read, one page at a time, and none stays pinned between calls.
+ */
+class VarlenReader {
+ public:
+  /**
+   * Creates a reader positioned at the start of a value.
+   * @param varlen a serialized varlen value in a tuple
+   * @param overflow_pool the buffer pool holding the overflow chain of the value, may be nullptr for inline values
+   */
+  VarlenReader(const char *varlen, BufferPoolManager *overflow_pool);
+
+  /**
+   * Creates a reader of the bytes of a value held in memory, e.g. the data of a varlen Value.
+   * @param data the bytes of the value
+   * @param length the length of the value, its terminating '\0' included
+   */
+  VarlenReader(const char *data, uint32_t length) : overflow_pool_(nullptr), inline_data_(data), length_(length) {}
+
+  /**
+   * Compares two non-null varchar values like VarlenType does, a chunk at a time, so neither is read whole.
+   * @param lhs a reader of the left value, at its start
+   * @param rhs a reader of the right value, at its start
+   * @return a negative number, 0 or a positive number if lhs orders before, like or after rhs
+   */
+  static int Compare(VarlenReader *lhs, VarlenReader *rhs);
+
+  /** @return true if the value is null */
+  inline bool IsNull() const { return is_null_; }
+
+  /** @return true if the value is stored out of line */
+  inline bool IsOverflow() const { return inline_data_ == nullptr && !is_null_; }
+
+  /** @return the length of the value in bytes, 0 if it is null */
+  inline uint32_t GetLength() const { return length_; }
+
+  /** @return the id of the first overflow page of the value, INVALID_PAGE_ID if it is not stored out of line */
+  inline page_id_t GetFirstPageId() const { return first_page_id_; }
+
+  /**
+   * Reads the next bytes of the value.
+   * @param[out] buffer the bytes are copied to it
+   * @param size the most bytes to read
+   * @return the number of bytes read, less than size only at the end of the value
+   */
+  uint32_t Read(char *buffer, uint32_t size);
+
+ private:
+  BufferPoolManager *overflow_pool_;
+  bool is_null_{false};
+  /** the bytes of an inline value, nullptr if the value is out of line */
+  const char *inline_data_{nullptr};
+  uint32_t length_{0};
+  uint32_t position_{0};
+  page_id_t first_page_id_{INVALID_PAGE_ID};
+  /** the overflow page holding the next bytes, and where in it they start */
+  page_id_t page_id_{INVALID_PAGE_ID};
+  uint32_t page_offset_{0};
+};
+
+/**
+ * OverflowChain writes values out of line into chains of overflow pages and frees the chains again. A chain is never
+ * modified after it is written, so readers only need to pin its pages.
+ */
+class OverflowChain {
+ public:
+  /**
+   * Copies a value into a new overflow chain.
+   * @param buffer_pool_manager the buffer pool to allocate the pages from
+   * @param reader a reader of the value, at its start
+   * @return the id of the first page of the chain, INVALID_PAGE_ID if not all pages could be created
+   */
+  static page_id_t Write(BufferPoolManager *buffer_pool_manager, VarlenReader *reader);
+
+  /**
+   * Deletes all pages of an overflow chain.
+   * @param buffer_pool_manager the buffer pool holding the chain
+   * @param first_page_id the id of the first page of the chain
+   */
+  static void Free(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id);
+};
+
+}  // namespace bustub
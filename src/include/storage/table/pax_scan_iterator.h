@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// pax_scan_iterator.h
+//
+// Identification: src/include/storage/table/pax_scan_iterator.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "common/macros.h"
+#include "storage/page/pax_page.h"
+#include "storage/table/pax_table_heap.h"
+
+namespace bustub {
+
+/**
+ * PaxScanIterator is the columnar scan path of a PaxTableHeap. It holds one page at a time, pinned and read latched,
+ * and hands out the minipages of the columns a scan needs, so the other columns are never touched. GetTuples
+ * assembles whole rows for the consumers that need tuples.
+ */
+class PaxScanIterator {
+ public:
+  /**
+   * Creates an iterator positioned before the first page of a table.
+   * @param table_heap the table to scan
+   */
+  explicit PaxScanIterator(PaxTableHeap *table_heap);
+
+  ~PaxScanIterator() { ReleasePage(); }
+
+  DISALLOW_COPY_AND_MOVE(PaxScanIterator);
+
+  /**
+   * Moves on to the next page that has rows that are not deleted, releasing the current one.
+   * @return false once there are no more pages with rows, or if a page could not be fetched
+   */
+  bool NextPage();
+
+  /** @return the number of rows of the current page, including deleted ones */
+  uint32_t GetNumRows() { return page_->GetNumRows(); }
+
+  /** @return true if a row of the current page was deleted */
+  bool IsDeleted(uint32_t row) { return page_->IsDeleted(row); }
+
+  /**
+   * @param column_idx the index of a fixed-width column
+   * @return the values of the column on the current page, GetNumRows of them, deleted rows included
+   */
+  template <typename T>
+  const T *GetColumn(uint32_t column_idx) {
+    BUSTUB_ASSERT((table_heap_->GetLayout().GetWidth(column_idx) == sizeof(T)), "Wrong type for the column.");
+    BUSTUB_ASSERT(table_heap_->GetLayout().GetSchema().GetColumn(column_idx).IsInlined(), "Varlen column.");
+    return reinterpret_cast<const T *>(page_->GetMinipage(table_heap_->GetLayout(), column_idx));
+  }
+
+  /**
+   * Assembles the rows of the current page that are not deleted into tuples.
+   * @param[out] tuples the tuples are appended to it in row order
+   */
+  void GetTuples(std::vector<Tuple> *tuples) { page_->GetTuples(table_heap_->GetLayout(), tuples); }
+
+  /** Unlatches and unpins the current page early. */
+  void ReleasePage();
+
+ private:
+  PaxTableHeap *table_heap_;
+  /** The page NextPage reads next, INVALID_PAGE_ID once the scan is done. */
+  page_id_t next_page_id_;
+  /** The current page, nullptr if none is held. */
+  PaxPage *page_{nullptr};
+};
+
+}  // namespace bustub
@@ -0,0 +1,108 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// pax_table_heap.h
+//
+// Identification: src/include/storage/table/pax_table_heap.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <mutex>  // NOLINT
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "catalog/schema.h"
+#include "concurrency/transaction.h"
+#include "storage/page/pax_page.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * PaxTableHeap is a table stored in PAX pages, for analytic tables that are mostly appended to and scanned a few
+ * columns at a time. It is a singly-linked list of pages, and inserts always append to the last page, so the rows of
+ * a page are never reused once deleted.
+ *
+ * Unlike TableHeap it neither locks nor logs, the format is meant for tables that are loaded in bulk and then read.
+ */
+class PaxTableHeap {
+ public:
+  /**
+   * Create a table heap. (create table)
+   * @param buffer_pool_manager the buffer pool manager
+   * @param schema the schema of the table
+   * @param txn the creating transaction
+   */
+  PaxTableHeap(BufferPoolManager *buffer_pool_manager, const Schema &schema, Transaction *txn);
+
+  /**
+   * Insert a tuple into the table. If the tuple does not fit into an empty page, return false.
+   * @param tuple tuple to insert
+   * @param[out] rid the rid of the inserted tuple
+   * @param txn the transaction performing the insert
+   * @return true iff the insert is successful
+   */
+  bool InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn);
+
+  /**
+   * Append tuples to the end of the table, keeping the last page latched while it is filled.
+   * @param tuples the tuples to insert
+   * @param[out] rids the rids of the inserted tuples, in the order of the tuples
+   * @param txn the transaction performing the insert
+   * @return true iff all tuples were inserted, the tuples before the first one that did not fit are kept
+   */
+  bool BulkInsert(const std::vector<Tuple> &tuples, std::vector<RID> *rids, Transaction *txn);
+
+  /**
+   * Delete a tuple.
+   * @param rid rid of the tuple to delete
+   * @param txn transaction performing the delete
+   * @return true iff the delete is successful (i.e the tuple exists)
+   */
+  bool ApplyDelete(const RID &rid, Transaction *txn);
+
+  /**
+   * Read a tuple from the table.
+   * @param rid rid of the tuple to read
+   * @param tuple output variable for the tuple
+   * @param txn transaction performing the read
+   * @return true if the read was successful (i.e. the tuple exists)
+   */
+  bool GetTuple(const RID &rid, Tuple *tuple, Transaction *txn);
+
+  /** @return the id of the first page of this table */
+  inline page_id_t GetFirstPageId() const { return first_page_id_; }
+
+  /** @return the layout of the pages of this table */
+  inline const PaxLayout &GetLayout() const { return layout_; }
+
+  /** @return the buffer pool manager of this table */
+  inline BufferPoolManager *GetBufferPoolManager() const { return buffer_pool_manager_; }
+
+ private:
+  /**
+   * Appends a new page after the last page. The last page must be write latched, the new page comes back pinned and
+   * write latched, and the old one unlatched and unpinned.
+   */
+  PaxPage *AppendPage(PaxPage *last_page);
+
+  /**
+   * Appends a tuple to the last page, or to a new page if it is full. The last page must be write latched, and is
+   * replaced by the new page if one was appended.
+   */
+  bool AppendTuple(PaxPage **last_page, const Tuple &tuple, RID *rid);
+
+  BufferPoolManager *buffer_pool_manager_;
+  PaxLayout layout_;
+  page_id_t first_page_id_;
+  /** The page inserts append to, protected by append_latch_. */
+  page_id_t last_page_id_;
+  std::mutex append_latch_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,77 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_batch_iterator.h
+//
+// Identification: src/include/storage/table/table_batch_iterator.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "concurrency/transaction.h"
+#include "storage/page/table_page_guard.h"
+#include "storage/table/tuple_view.h"
+
+namespace bustub {
+
+class TableHeap;
+
+/**
+ * TableBatchIterator scans a TableHeap a page at a time. Every page is fetched and read latched exactly once, and
+ * NextBatch hands out views of all of its tuples at once, instead of fetching the page again for every tuple the way
+ * TableIterator does.
+ */
+class TableBatchIterator {
+ public:
+  /**
+   * Creates an iterator positioned before the first page of a table.
+   * @param table_heap the table to scan
+   * @param txn the transaction performing the scan
+   */
+  TableBatchIterator(TableHeap *table_heap, Transaction *txn);
+
+  /**
+   * Creates an iterator over some pages of a table only, e.g. those a zone map could not rule out.
+   * @param table_heap the table to scan
+   * @param page_ids the pages to scan, in the order to scan them
+   * @param txn the transaction performing the scan
+   */
+  TableBatchIterator(TableHeap *table_heap, std::vector<page_id_t> page_ids, Transaction *txn);
+
+  /**
+   * Moves on to the next page that holds tuples and fills a batch with views of them. The views stay valid until the
+   * next call to NextBatch or ReleasePage, or until the iterator is destroyed.
+   * @param[out] batch the views of the tuples of the page, in slot order; it is cleared first
+   * @return false once there are no more pages with tuples, or if a page could not be fetched, which aborts the
+   * transaction
+   */
+  bool NextBatch(std::vector<TupleView> *batch);
+
+  /** Unlatches and unpins the page of the current batch early, which invalidates its views. */
+  void ReleasePage() { guard_.Release(); }
+
+  /** @return the number of pages fetched so far */
+  size_t GetNumPagesRead() const { return num_pages_read_; }
+
+ private:
+  TableHeap *table_heap_;
+  Transaction *txn_;
+  /** Whether the scan follows page_ids_ rather than the page chain. */
+  bool use_page_ids_{false};
+  std::vector<page_id_t> page_ids_;
+  /** The position of next_page_id_ in page_ids_. */
+  size_t page_idx_{0};
+  /** The page NextBatch reads next, INVALID_PAGE_ID once the scan is done. */
+  page_id_t next_page_id_;
+  size_t num_pages_read_{0};
+  /** The guard holding the page of the current batch. */
+  TablePageGuard guard_;
+};
+
+}  // namespace bustub
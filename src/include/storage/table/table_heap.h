@@ -12,17 +12,26 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>  // NOLINT
+#include <vector>
+
 #include "buffer/buffer_pool_manager.h"
 #include "recovery/log_manager.h"
 #include "storage/page/table_page.h"
+#include "storage/page/table_page_guard.h"
+#include "storage/table/free_space_map.h"
+#include "storage/table/overflow_chain.h"
 #include "storage/table/table_iterator.h"
 #include "storage/table/tuple.h"
+#include "storage/table/zone_map.h"
 
 namespace bustub {
 
 /**
  * TableHeap represents a physical table on disk.
- * This is just a doubly-linked list of pages.
+ * This is just a doubly-linked list of pages, with a free-space map that
+ * tells inserts which page has room.
  */
 class TableHeap {
   friend class TableIterator;
@@ -36,9 +45,11 @@ class TableHeap {
    * @param lock_manager the lock manager
    * @param log_manager the log manager
    * @param first_page_id the id of the first page
+   * @param free_space_map_page_id the id of the first page of the free-space map, if INVALID_PAGE_ID the map is
+   * rebuilt from the pages of the table
    */
   TableHeap(BufferPoolManager *buffer_pool_manager, LockManager *lock_manager, LogManager *log_manager,
-            page_id_t first_page_id);
+            page_id_t first_page_id, page_id_t free_space_map_page_id = INVALID_PAGE_ID);
 
   /**
    * Create a table heap with a transaction. (create table)
@@ -51,7 +62,8 @@ class TableHeap {
             Transaction *txn);
 
   /**
-   * Insert a tuple into the table. If the tuple is too large (>= page_size), return false.
+   * Insert a tuple into the table. If the table stores large values out of line, they are moved to overflow chains
+   * first. If the tuple is still too large (>= page_size), return false.
    * @param tuple tuple to insert
    * @param[out] rid the rid of the inserted tuple
    * @param txn the transaction performing the insert
@@ -59,6 +71,16 @@ class TableHeap {
    */
   bool InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn);
 
+  /**
+   * Append tuples to the end of the table. The tail page stays pinned and latched while it is filled, and the next
+   * page is only linked once it is full, so no page is fetched twice. If any tuple is too large, nothing is inserted.
+   * @param tuples the tuples to insert
+   * @param[out] rids the rids of the inserted tuples, in the order of the tuples
+   * @param txn the transaction performing the insert
+   * @return true iff all tuples were inserted
+   */
+  bool BulkInsert(const std::vector<Tuple> &tuples, std::vector<RID> *rids, Transaction *txn);
+
   /**
    * Mark the tuple as deleted. The actual delete will occur when ApplyDelete is called.
    * @param rid resource id of the tuple of delete
@@ -69,6 +91,7 @@ class TableHeap {
 
   /**
    * if the new tuple is too large to fit in the old page, return false (will delete and insert)
+   * The overflow chains of the old tuple are kept for a rollback, and freed by ApplyUpdate when the update commits.
    * @param tuple new tuple
    * @param rid rid of the old tuple
    * @param txn transaction performing the update
@@ -77,7 +100,44 @@ class TableHeap {
   bool UpdateTuple(const Tuple &tuple, const RID &rid, Transaction *txn);
 
   /**
-   * Called on Commit/Abort to actually delete a tuple or rollback an insert.
+   * Called on commit of an UpdateTuple. Frees the overflow chains of the old tuple, no rollback needs them anymore.
+   * @param old_tuple the tuple before the update, as stored in the page
+   */
+  void ApplyUpdate(const Tuple &old_tuple);
+
+  /**
+   * Called on abort to rollback an UpdateTuple. The old tuple is put back as it was stored, still pointing to its
+   * overflow chains, and the chains of the tuple it replaces are freed.
+   * @param old_tuple the tuple before the update, as stored in the page
+   * @param rid rid of the tuple
+   * @param txn transaction performing the rollback
+   */
+  void RollbackUpdate(const Tuple &old_tuple, const RID &rid, Transaction *txn);
+
+  /**
+   * Overwrite a fixed-width column of a tuple in place, e.g. a counter or a status flag. Unlike UpdateTuple, neither
+   * the old tuple nor a new one is built: only the bytes of the column are patched, logged and kept for a rollback.
+   * @param schema the schema of the tuples of the table
+   * @param rid rid of the tuple
+   * @param column_idx the index of an inlined column
+   * @param value the new value of the column, of the type of the column
+   * @param txn transaction performing the update
+   * @return true if the update is successful (i.e. the tuple exists), false without updating anything if the column is
+   * not inlined or the value is of another type
+   */
+  bool UpdateColumn(const Schema &schema, const RID &rid, uint32_t column_idx, const Value &value, Transaction *txn);
+
+  /**
+   * Called on abort to rollback an UpdateColumn.
+   * @param rid rid of the tuple
+   * @param column_offset the offset of the column in the tuple
+   * @param old_value the value of the column before the update
+   * @param txn transaction performing the rollback
+   */
+  void RollbackUpdateColumn(const RID &rid, uint32_t column_offset, const Value &old_value, Transaction *txn);
+
+  /**
+   * Called on Commit/Abort to actually delete a tuple or rollback an insert. Frees the overflow chains of the tuple.
    * @param rid rid of the tuple to delete
    * @param txn transaction performing the delete.
    */
@@ -99,6 +159,29 @@ class TableHeap {
    */
   bool GetTuple(const RID &rid, Tuple *tuple, Transaction *txn);
 
+  /**
+   * Pin and read latch a page of the table, so its tuples can be read in place.
+   * @param page_id the id of the page
+   * @return a guard holding the page, whose GetPage is nullptr if the page could not be fetched
+   */
+  TablePageGuard ReadPage(page_id_t page_id) { return TablePageGuard(buffer_pool_manager_, page_id); }
+
+  /**
+   * Read a tuple of a guarded page without copying it.
+   * @param guard the guard holding the page of the tuple
+   * @param rid rid of the tuple to read
+   * @param[out] view a view of the tuple, valid as long as the guard
+   * @param txn transaction performing the read
+   * @return true if the read was successful (i.e. the tuple exists)
+   */
+  bool GetTupleView(const TablePageGuard &guard, const RID &rid, TupleView *view, Transaction *txn) {
+    if (!guard.GetPage()->GetTupleView(rid, view, txn, lock_manager_)) {
+      return false;
+    }
+    view->SetOverflowPool(buffer_pool_manager_);
+    return true;
+  }
+
   /** @return the begin iterator of this table */
   TableIterator Begin(Transaction *txn);
 
@@ -108,11 +191,89 @@ class TableHeap {
   /** @return the id of the first page of this table */
   inline page_id_t GetFirstPageId() const { return first_page_id_; }
 
+  /** @return the id of the first page of the free-space map of this table */
+  inline page_id_t GetFreeSpaceMapPageId() const { return free_space_map_->GetFirstPageId(); }
+
+  /** @return the number of pages of this table */
+  inline size_t GetNumPages() const { return free_space_map_->GetNumPages(); }
+
+  /** @return the ids of the pages of this table in the order of the page chain, read from the free-space map */
+  inline std::vector<page_id_t> GetPageIds() const { return free_space_map_->GetPageIds(); }
+
+  /**
+   * Splits pages into contiguous ranges of about the same size, e.g. to scan them in parallel.
+   * @param page_ids the pages, e.g. from GetPageIds
+   * @param num_ranges the number of ranges
+   * @return the non-empty ranges, at most num_ranges of them, in the order of the pages
+   */
+  static std::vector<std::vector<page_id_t>> SplitPages(const std::vector<page_id_t> &page_ids, size_t num_ranges);
+
+  /**
+   * Starts keeping a zone map of the table, summarizing the tuples already in it. The table must not be modified
+   * concurrently while the map is created.
+   * @param schema the schema of the tuples of the table
+   */
+  void CreateZoneMap(const Schema &schema);
+
+  /** @return the zone map of this table, nullptr if it keeps none */
+  inline ZoneMap *GetZoneMap() const { return zone_map_.get(); }
+
+  /**
+   * Starts storing large varlen values out of line, TOAST style: tuples larger than OVERFLOW_TUPLE_THRESHOLD get
+   * their largest values moved to chains of overflow pages, until they are small enough. Tuples read from the table
+   * only fetch such a value when it is read, see Tuple::GetValue and Tuple::GetVarlenReader.
+   * @param schema the schema of the tuples of the table
+   */
+  void EnableOverflow(const Schema &schema);
+
  private:
+  /**
+   * Appends a new page to the table, unless another insert appended one with room for the tuple first.
+   * @param space the free space the caller needs
+   * @param txn the transaction performing the insert
+   * @return the id of a page with room, INVALID_PAGE_ID if no page could be created
+   */
+  page_id_t AppendPage(uint32_t space, Transaction *txn);
+
+  /**
+   * Creates a new page and links it after the last page of the table. The caller must hold the append latch and the
+   * write latch of the last page, and adds the new page to the free-space map. The new page is added to the zone map
+   * here, so the zone map lists the pages in the order of the chain.
+   * @param last_page the last page of the table
+   * @param txn the transaction creating the page
+   * @return the new page, pinned and write latched, nullptr if no page could be created
+   */
+  TablePage *LinkNewPage(TablePage *last_page, Transaction *txn);
+
+  /**
+   * @return true if a tuple must be rewritten before it is stored: it is too large, or it holds values out of line
+   * that need chains of their own, e.g. because they were read from another tuple
+   */
+  bool NeedsOverflow(const Tuple &tuple) const;
+
+  /**
+   * Rewrites a tuple the way it is stored, with its large values and the values it already held out of line moved
+   * to new overflow chains.
+   * @param tuple the tuple to store
+   * @param[out] stored the tuple to insert into a page
+   * @return false if not all chains could be written, none are left behind then
+   */
+  bool MoveOutOfLine(const Tuple &tuple, Tuple *stored);
+
+  /** Frees the overflow chains of a stored tuple. */
+  void FreeOverflow(const Tuple &stored);
+
   BufferPoolManager *buffer_pool_manager_;
   LockManager *lock_manager_;
   LogManager *log_manager_;
   page_id_t first_page_id_{};
+  std::unique_ptr<FreeSpaceMap> free_space_map_;
+  /** the summaries of the pages for scans to skip them, if the table keeps any */
+  std::unique_ptr<ZoneMap> zone_map_;
+  /** the schema of the tuples, if the table stores large values out of line */
+  std::unique_ptr<Schema> overflow_schema_;
+  /** serializes appending pages to the end of the table */
+  std::mutex append_latch_;
 };
 
 }  // namespace bustub
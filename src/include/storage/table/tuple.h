@@ -17,15 +17,22 @@
 
 #include "catalog/schema.h"
 #include "common/rid.h"
+#include "type/abstract_pool.h"
 #include "type/value.h"
 
 namespace bustub {
 
+class BufferPoolManager;
+class VarlenReader;
+
 /**
  * Tuple format:
  * ---------------------------------------------------------------------
  * | FIXED-SIZE or VARIED-SIZED OFFSET | PAYLOAD OF VARIED-SIZED FIELD |
  * ---------------------------------------------------------------------
+ *
+ * A large varied-sized field may be stored out of line, in a chain of overflow pages of its table, see
+ * overflow_chain.h. Tuples read from a table remember its buffer pool, and fetch such a field only when it is read.
  */
 class Tuple {
   friend class TablePage;
@@ -34,6 +41,10 @@ class Tuple {
 
   friend class TableIterator;
 
+  friend class TupleView;
+
+  friend class PaxPage;
+
  public:
   // Default constructor (to create a dummy tuple)
   Tuple() = default;
@@ -42,14 +53,21 @@ class Tuple {
   explicit Tuple(RID rid) : rid_(rid) {}
 
   // constructor for creating a new tuple based on input value
-  Tuple(std::vector<Value> values, const Schema *schema);
+  // if a pool is given, the data is allocated from it and the tuple does not own it, like a tuple of a page
+  Tuple(std::vector<Value> values, const Schema *schema, AbstractPool *pool = nullptr);
 
-  // copy constructor, deep copy
+  // copy constructor, deep copy: the copy owns its data, also when other does not, e.g. a tuple of a page or a pool
   Tuple(const Tuple &other);
 
-  // assign operator, deep copy
+  // assign operator, deep copy like the copy constructor
   Tuple &operator=(const Tuple &other);
 
+  // move constructor, takes over the data of other, and whether it owns it
+  Tuple(Tuple &&other) noexcept;
+
+  // move assign operator, takes over the data of other, and whether it owns it
+  Tuple &operator=(Tuple &&other) noexcept;
+
   ~Tuple() {
     if (allocated_) {
       delete[] data_;
@@ -72,16 +90,24 @@ class Tuple {
   // Get length of the tuple, including varchar legth
   inline uint32_t GetLength() const { return size_; }
 
+  // Generate a key tuple given schemas and attributes
+  Tuple KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs) const;
+
   // Get the value of a specified column (const)
   // checks the schema to see how to return the Value.
   Value GetValue(const Schema *schema, uint32_t column_idx) const;
 
-  // Is the column value null ?
-  inline bool IsNull(const Schema *schema, uint32_t column_idx) const {
-    Value value = GetValue(schema, column_idx);
-    return value.IsNull();
-  }
-  inline bool IsAllocated() { return allocated_; }
+  // Get the value of a specified column without copying a varied-sized value stored in the tuple, the value points
+  // into the tuple data and must not outlive it (or the pin of the page it lies in). A value stored out of line is
+  // still fetched whole, into a buffer of its size; use GetVarlenReader to stream it instead
+  Value GetValueView(const Schema *schema, uint32_t column_idx) const;
+
+  // Get a reader that streams the bytes of a varied-sized column, without fetching all of it at once
+  VarlenReader GetVarlenReader(const Schema *schema, uint32_t column_idx) const;
+
+  // Is the column value null ? Does not fetch a varied-sized value stored out of line.
+  bool IsNull(const Schema *schema, uint32_t column_idx) const;
+  inline bool IsAllocated() const { return allocated_; }
 
   std::string ToString(const Schema *schema) const;
 
@@ -93,6 +119,7 @@ class Tuple {
   RID rid_{};              // if pointing to the table heap, the rid is valid
   uint32_t size_{0};
   char *data_{nullptr};
+  BufferPoolManager *overflow_pool_{nullptr};  // the buffer pool of the out-of-line fields, if read from a table
 };
 
 }  // namespace bustub
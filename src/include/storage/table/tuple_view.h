@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_view.h
+//
+// Identification: src/include/storage/table/tuple_view.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstring>
+
+#include "catalog/schema.h"
+#include "common/rid.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * TupleView is a read-only view of a tuple in a table page. It points straight into the page frame, so creating one
+ * neither allocates nor copies, and it is only valid while the page stays pinned and latched, i.e. while the
+ * TablePageGuard it came from is alive. Use ToTuple to keep a tuple beyond that.
+ */
+class TupleView {
+ public:
+  TupleView() = default;
+
+  /**
+   * Creates a view of tuple data.
+   * @param rid the rid of the tuple
+   * @param data the start of the tuple in the page
+   * @param size the size of the tuple
+   */
+  TupleView(RID rid, char *data, uint32_t size) {
+    tuple_.rid_ = rid;
+    tuple_.data_ = data;
+    tuple_.size_ = size;
+  }
+
+  /**
+   * Lets the view fetch the values of the tuple that are stored out of line.
+   * @param overflow_pool the buffer pool of the table of the tuple
+   */
+  inline void SetOverflowPool(BufferPoolManager *overflow_pool) { tuple_.overflow_pool_ = overflow_pool; }
+
+  /** @return the rid of the tuple */
+  inline RID GetRid() const { return tuple_.rid_; }
+
+  /** @return the size of the tuple */
+  inline uint32_t GetLength() const { return tuple_.size_; }
+
+  /** @return the value of a column of the tuple */
+  inline Value GetValue(const Schema *schema, uint32_t column_idx) const { return tuple_.GetValue(schema, column_idx); }
+
+  /**
+   * @return the viewed data as a tuple that does not own it, for the interfaces that take tuples such as expressions.
+   * Copies of it own their data, like ToTuple.
+   */
+  inline const Tuple &AsTuple() const { return tuple_; }
+
+  /** @return a tuple with its own copy of the data */
+  Tuple ToTuple() const { return tuple_; }
+
+  /**
+   * @param pool the pool to allocate the copy from
+   * @return a tuple with a copy of the data in the pool, valid until the pool gives its memory back
+   */
+  Tuple ToTuple(AbstractPool *pool) const {
+    Tuple tuple(tuple_.rid_);
+    tuple.size_ = tuple_.size_;
+    tuple.overflow_pool_ = tuple_.overflow_pool_;
+    tuple.data_ = static_cast<char *>(pool->Allocate(tuple.size_));
+    memcpy(tuple.data_, tuple_.data_, tuple.size_);
+    return tuple;
+  }
+
+ private:
+  /** a tuple that borrows the data of the page */
+  Tuple tuple_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,127 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// zone_map.h
+//
+// Identification: src/include/storage/table/zone_map.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <mutex>  // NOLINT
+#include <unordered_map>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/config.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * The summary of one column on one page: the smallest and largest value that is not null, and the number of nulls.
+ */
+struct ColumnSummary {
+  /** false as long as the page holds no value of the column that is not null, min_ and max_ are unset until then */
+  bool has_values_{false};
+  Value min_;
+  Value max_;
+  uint32_t null_count_{0};
+};
+
+/**
+ * ZoneMap keeps a summary of every fixed-width column on every page of a table heap, so a scan can skip the pages
+ * whose values cannot satisfy its predicate without fetching them. The summaries live in memory next to the table and
+ * are not persisted, a table heap that is opened again rebuilds them from its pages.
+ *
+ * Inserts and updates only widen the summary of their page, and deletes leave it as is, so a summary may be wider
+ * than the values on its page, but never narrower. Once the last tuple of a page is deleted, its summary is reset.
+ */
+class ZoneMap {
+ public:
+  /**
+   * Creates a zone map without any pages.
+   * @param schema the schema of the tuples of the table
+   */
+  explicit ZoneMap(const Schema &schema);
+
+  /** @return true if a column is summarized, i.e. it is fixed-width */
+  bool IsSummarized(uint32_t column_idx) const { return schema_.GetColumn(column_idx).IsInlined(); }
+
+  /**
+   * Adds an empty page at the end of the table.
+   * @param page_id the id of the page
+   */
+  void AddPage(page_id_t page_id);
+
+  /**
+   * Widens the summaries of a page to cover a tuple that was inserted into it.
+   * @param page_id the id of the page
+   * @param tuple the tuple
+   */
+  void Insert(page_id_t page_id, const Tuple &tuple);
+
+  /**
+   * Widens the summaries of a page to cover the new version of a tuple that was updated in place.
+   * @param page_id the id of the page
+   * @param tuple the new version of the tuple
+   */
+  void Update(page_id_t page_id, const Tuple &tuple);
+
+  /**
+   * Widens the summary of a column of a page to cover a value that was written over the column of one of its tuples.
+   * @param page_id the id of the page
+   * @param column_idx the index of a summarized column
+   * @param value the new value of the column
+   */
+  void UpdateColumn(page_id_t page_id, uint32_t column_idx, const Value &value);
+
+  /**
+   * Records that a tuple was removed from a page. The summaries of the page stay as wide as they were, until the last
+   * tuple is gone and they are reset.
+   * @param page_id the id of the page
+   */
+  void Delete(page_id_t page_id);
+
+  /**
+   * @param page_id the id of the page
+   * @param column_idx the index of a summarized column
+   * @param[out] summary the summary of the column on the page
+   * @return false if the page is unknown
+   */
+  bool GetSummary(page_id_t page_id, uint32_t column_idx, ColumnSummary *summary);
+
+  /**
+   * @param page_id the id of the page
+   * @return the number of tuples on the page, including those marked deleted but not deleted yet
+   */
+  uint32_t GetNumTuples(page_id_t page_id);
+
+  /** @return the ids of the pages of the table, in the order of the page chain */
+  std::vector<page_id_t> GetPageIds();
+
+ private:
+  /** The summaries of all columns of a page, with an empty entry for every column that is not summarized. */
+  struct PageSummary {
+    uint32_t num_tuples_{0};
+    std::vector<ColumnSummary> columns_;
+  };
+
+  /** Widens a page summary to cover a tuple. */
+  void Widen(PageSummary *summary, const Tuple &tuple) const;
+
+  /** Widens a column summary to cover a value. */
+  static void WidenColumn(ColumnSummary *column, const Value &value);
+
+  Schema schema_;
+  std::mutex latch_;
+  std::vector<page_id_t> page_ids_;
+  std::unordered_map<page_id_t, PageSummary> summaries_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,73 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// arena_pool.h
+//
+// Identification: src/include/type/arena_pool.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "common/macros.h"
+#include "type/abstract_pool.h"
+
+namespace bustub {
+
+/**
+ * ArenaPool is a bump allocator: it carves allocations out of large chunks taken from the heap, and gives all of them
+ * back at once on Reset instead of one at a time. Free does nothing. The chunks are kept across resets, so a pool
+ * that is reset between batches of similar size stops touching the heap after the first batch.
+ *
+ * The pool is not thread safe.
+ */
+class ArenaPool : public AbstractPool {
+ public:
+  /** The default size of a chunk. */
+  static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+  /** Every allocation is aligned to this many bytes. */
+  static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+
+  /**
+   * Creates an empty pool.
+   * @param chunk_size the size of the chunks, allocations larger than half of it get a chunk of their own
+   */
+  explicit ArenaPool(size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+  DISALLOW_COPY_AND_MOVE(ArenaPool);
+
+  void *Allocate(size_t size) override;
+
+  /** Does nothing, the memory is given back by Reset. */
+  void Free([[maybe_unused]] void *ptr) override {}
+
+  /** Gives back all memory allocated so far. The regular chunks are kept for the allocations to come. */
+  void Reset();
+
+  /** @return the number of allocations the pool served since it was created */
+  size_t GetNumAllocations() const { return num_allocations_; }
+
+  /** @return the number of chunks the pool took from the heap since it was created */
+  size_t GetNumChunkAllocations() const { return num_chunk_allocations_; }
+
+ private:
+  size_t chunk_size_;
+  /** the regular chunks, chunks_[current_chunk_] is the one allocations are carved from */
+  std::vector<std::unique_ptr<char[]>> chunks_;
+  size_t current_chunk_{0};
+  /** the offset of the free space in the current chunk */
+  size_t offset_{0};
+  /** the chunks of allocations larger than half a chunk, freed on Reset */
+  std::vector<std::unique_ptr<char[]>> large_chunks_;
+  size_t num_allocations_{0};
+  size_t num_chunk_allocations_{0};
+};
+
+}  // namespace bustub
@@ -26,6 +26,11 @@ inline CmpBool GetCmpBool(bool boolean) { return boolean ? CmpBool::CmpTrue : Cm
 // A value is an abstract class that represents a view over SQL data stored in
 // some materialized state. All values have a type and comparison functions, but
 // subclasses implement other type-specific functionality.
+//
+// A VARCHAR either owns its bytes (manage_data_) or points to bytes owned by
+// someone else, e.g. a pinned page. Owned strings of up to INLINE_VARCHAR_SIZE
+// bytes, the terminating NUL included, are kept inside the value itself, so
+// creating, copying and destroying them never touches the heap.
 class Value {
   // Friend Type classes
   friend class Type;
@@ -61,7 +66,10 @@ class Value {
 
   Value() : Value(TypeId::INVALID) {}
   Value(const Value &other);
-  Value &operator=(Value other);
+  // leaves other a null value of its type, without copying the data
+  Value(Value &&other) noexcept;
+  Value &operator=(const Value &other);
+  Value &operator=(Value &&other) noexcept;
   ~Value();
   // NOLINTNEXTLINE
   friend void Swap(Value &first, Value &second) {
@@ -136,8 +144,21 @@ class Value {
   inline std::string ToString() const { return Type::GetInstance(type_id_)->ToString(*this); }
   // Create a copy of this value
   inline Value Copy() const { return Type::GetInstance(type_id_)->Copy(*this); }
+  // Create a value that points to the data of this value without owning it,
+  // so it must not outlive this value
+  Value View() const;
+
+  // The largest owned VARCHAR, the terminating NUL included, that is kept inline
+  static constexpr uint32_t INLINE_VARCHAR_SIZE = 16;
 
  protected:
+  // Whether this is an owned VARCHAR kept in inline_
+  inline bool IsInlinedVarchar() const { return manage_data_ && size_.len_ <= INLINE_VARCHAR_SIZE; }
+  // The bytes of a VARCHAR, wherever they are kept
+  inline const char *GetVarlen() const { return IsInlinedVarchar() ? value_.inline_ : value_.const_varlen_; }
+  // Sets the bytes of a VARCHAR this value owns
+  void SetOwnedVarlen(const char *data, uint32_t len);
+
   // The actual value item
   union Val {
     int8_t boolean_;
@@ -149,6 +170,7 @@ class Value {
     uint64_t timestamp_;
     char *varlen_;
     const char *const_varlen_;
+    char inline_[INLINE_VARCHAR_SIZE];
   } value_;
 
   union {
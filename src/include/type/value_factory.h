@@ -34,7 +34,10 @@ namespace bustub {
 
 class ValueFactory {
  public:
-  static inline Value Clone(const Value &src, __attribute__((__unused__)) AbstractPool *dataPool = nullptr) {
+  static inline Value Clone(const Value &src, AbstractPool *dataPool = nullptr) {
+    if (dataPool != nullptr && src.GetTypeId() == TypeId::VARCHAR && !src.IsNull()) {
+      return GetVarcharValue(src.GetData(), src.GetLength(), false, dataPool);
+    }
     return src.Copy();
   }
 
@@ -58,19 +61,26 @@ class ValueFactory {
 
   static inline Value GetBooleanValue(int8_t value) { return Value(TypeId::BOOLEAN, value); }
 
-  static inline Value GetVarcharValue(const char *value, bool manage_data,
-                                      __attribute__((__unused__)) AbstractPool *pool = nullptr) {
+  static inline Value GetVarcharValue(const char *value, bool manage_data, AbstractPool *pool = nullptr) {
     auto len = static_cast<uint32_t>(value == nullptr ? 0U : strlen(value) + 1);
-    return GetVarcharValue(value, len, manage_data);
+    return GetVarcharValue(value, len, manage_data, pool);
   }
 
+  // With a pool, the bytes are copied into the pool and the value points to them without owning them.
   static inline Value GetVarcharValue(const char *value, uint32_t len, bool manage_data,
-                                      __attribute__((__unused__)) AbstractPool *pool = nullptr) {
+                                      AbstractPool *pool = nullptr) {
+    if (pool != nullptr && value != nullptr) {
+      auto data = static_cast<char *>(pool->Allocate(len));
+      memcpy(data, value, len);
+      return Value(TypeId::VARCHAR, data, len, false);
+    }
     return Value(TypeId::VARCHAR, value, len, manage_data);
   }
 
-  static inline Value GetVarcharValue(const std::string &value,
-                                      __attribute__((__unused__)) AbstractPool *pool = nullptr) {
+  static inline Value GetVarcharValue(const std::string &value, AbstractPool *pool = nullptr) {
+    if (pool != nullptr) {
+      return GetVarcharValue(value.c_str(), static_cast<uint32_t>(value.length() + 1), false, pool);
+    }
     return Value(TypeId::VARCHAR, value);
   }
 
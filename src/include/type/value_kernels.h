@@ -0,0 +1,156 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// value_kernels.h
+//
+// Identification: src/include/type/value_kernels.h
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+#include "common/exception.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/** A comparison of two values of the same type. */
+using CompareKernel = CmpBool (*)(const Value &left, const Value &right);
+
+/** An arithmetic operation on two values of the same type. */
+using ArithmeticKernel = Value (*)(const Value &left, const Value &right);
+
+/**
+ * ValueKernels hands out comparison and arithmetic functions specialized for two operands of the same fixed-width
+ * type. The Value methods look up the Type of the left operand and call it virtually, which then switches on the type
+ * of the right operand, on every call. A caller that knows the types of both operands up front, e.g. an expression
+ * when its plan is built, picks a kernel once and calls it for every row instead.
+ *
+ * There are comparison kernels for INTEGER, BIGINT, DECIMAL and TIMESTAMP, and arithmetic kernels for INTEGER, BIGINT
+ * and DECIMAL. For any other type the getters return nullptr, and the caller keeps using the Value methods. Kernels
+ * treat nulls and overflows the way the Value methods do, the operands must have the type the kernel was picked for.
+ */
+class ValueKernels {
+ public:
+  /**
+   * @tparam Op the comparison, e.g. std::less<>
+   * @param type_id the type of both operands
+   * @return the kernel comparing two values of the type, nullptr if there is none
+   */
+  template <class Op>
+  static CompareKernel GetCompareKernel(TypeId type_id) {
+    switch (type_id) {
+      case TypeId::INTEGER:
+        return Compare<int32_t, Op>;
+      case TypeId::BIGINT:
+        return Compare<int64_t, Op>;
+      case TypeId::DECIMAL:
+        return Compare<double, Op>;
+      case TypeId::TIMESTAMP:
+        return Compare<uint64_t, Op>;
+      default:
+        return nullptr;
+    }
+  }
+
+  /**
+   * @param type_id the type of both operands
+   * @return the kernel adding two values of the type, nullptr if there is none
+   */
+  static ArithmeticKernel GetAddKernel(TypeId type_id) { return GetArithmeticKernel<AddOp>(type_id); }
+
+  /**
+   * @param type_id the type of both operands
+   * @return the kernel subtracting two values of the type, nullptr if there is none
+   */
+  static ArithmeticKernel GetSubtractKernel(TypeId type_id) { return GetArithmeticKernel<SubtractOp>(type_id); }
+
+  /**
+   * @param type_id the type of both operands
+   * @return the kernel multiplying two values of the type, nullptr if there is none
+   */
+  static ArithmeticKernel GetMultiplyKernel(TypeId type_id) { return GetArithmeticKernel<MultiplyOp>(type_id); }
+
+ private:
+  /** The arithmetic operations, Apply returns false if the result overflows. */
+  struct AddOp {
+    template <class T>
+    static bool Apply(T x, T y, T *result) {
+      if constexpr (std::is_integral_v<T>) {
+        return !__builtin_add_overflow(x, y, result);
+      } else {
+        *result = x + y;
+        return true;
+      }
+    }
+  };
+
+  struct SubtractOp {
+    template <class T>
+    static bool Apply(T x, T y, T *result) {
+      if constexpr (std::is_integral_v<T>) {
+        return !__builtin_sub_overflow(x, y, result);
+      } else {
+        *result = x - y;
+        return true;
+      }
+    }
+  };
+
+  struct MultiplyOp {
+    template <class T>
+    static bool Apply(T x, T y, T *result) {
+      if constexpr (std::is_integral_v<T>) {
+        return !__builtin_mul_overflow(x, y, result);
+      } else {
+        *result = x * y;
+        return true;
+      }
+    }
+  };
+
+  template <class Op>
+  static ArithmeticKernel GetArithmeticKernel(TypeId type_id) {
+    switch (type_id) {
+      case TypeId::INTEGER:
+        return Compute<int32_t, Op>;
+      case TypeId::BIGINT:
+        return Compute<int64_t, Op>;
+      case TypeId::DECIMAL:
+        return Compute<double, Op>;
+      default:
+        return nullptr;
+    }
+  }
+
+  template <class T, class Op>
+  static CmpBool Compare(const Value &left, const Value &right) {
+    assert(left.GetTypeId() == right.GetTypeId());
+    if (left.IsNull() || right.IsNull()) {
+      return CmpBool::CmpNull;
+    }
+    return GetCmpBool(Op()(left.GetAs<T>(), right.GetAs<T>()));
+  }
+
+  template <class T, class Op>
+  static Value Compute(const Value &left, const Value &right) {
+    assert(left.GetTypeId() == right.GetTypeId());
+    if (left.IsNull() || right.IsNull()) {
+      return left.OperateNull(right);
+    }
+    T result;
+    if (!Op::Apply(left.GetAs<T>(), right.GetAs<T>(), &result)) {
+      throw Exception(ExceptionType::OUT_OF_RANGE, "Numeric value out of range.");
+    }
+    return Value(left.GetTypeId(), result);
+  }
+};
+
+}  // namespace bustub
@@ -0,0 +1,591 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree.cpp
+//
+// Identification: src/storage/index/b_plus_tree.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/index/b_plus_tree.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "common/rid.h"
+
+namespace bustub {
+
+INDEX_TEMPLATE_ARGUMENTS
+BPLUSTREE_TYPE::BPlusTree(std::string name, BufferPoolManager *buffer_pool_manager, const KeyComparator &comparator,
+                          int leaf_max_size, int internal_max_size)
+    : index_name_(std::move(name)),
+      root_page_id_(INVALID_PAGE_ID),
+      buffer_pool_manager_(buffer_pool_manager),
+      comparator_(comparator),
+      leaf_max_size_(leaf_max_size),
+      internal_max_size_(internal_max_size) {
+  BUSTUB_ASSERT(leaf_max_size_ >= 2 && leaf_max_size_ < static_cast<int>(LEAF_PAGE_SIZE), "Bad leaf max size.");
+  BUSTUB_ASSERT(internal_max_size_ >= 3 && internal_max_size_ < static_cast<int>(INTERNAL_PAGE_SIZE),
+                "Bad internal max size.");
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool BPLUSTREE_TYPE::IsEmpty() const { return root_page_id_ == INVALID_PAGE_ID; }
+
+INDEX_TEMPLATE_ARGUMENTS
+page_id_t BPLUSTREE_TYPE::GetRootPageId() {
+  root_latch_.RLock();
+  page_id_t root_page_id = root_page_id_;
+  root_latch_.RUnlock();
+  return root_page_id;
+}
+
+/*****************************************************************************
+ * SEARCH
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+bool BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *transaction) {
+  Page *page = FindLeafPageRead(key);
+  if (page == nullptr) {
+    return false;
+  }
+  auto *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+  ValueType value;
+  bool found = leaf->Lookup(key, &value, comparator_);
+  if (found) {
+    result->push_back(value);
+  }
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+  return found;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+Page *BPLUSTREE_TYPE::FindLeafPageRead(const KeyType &key, bool left_most) {
+  root_latch_.RLock();
+  if (IsEmpty()) {
+    root_latch_.RUnlock();
+    return nullptr;
+  }
+  Page *page = buffer_pool_manager_->FetchPage(root_page_id_);
+  page->RLatch();
+  root_latch_.RUnlock();
+
+  auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+  while (!node->IsLeafPage()) {
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    page_id_t child_page_id = left_most ? internal->ValueAt(0) : internal->Lookup(key, comparator_);
+    Page *child_page = buffer_pool_manager_->FetchPage(child_page_id);
+    child_page->RLatch();
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    page = child_page;
+    node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+  }
+  return page;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+Page *BPLUSTREE_TYPE::FindLeafPageOptimistic(const KeyType &key) {
+  root_latch_.RLock();
+  if (IsEmpty()) {
+    root_latch_.RUnlock();
+    return nullptr;
+  }
+  // the type of a reachable page never changes, so it can be checked before latching the page
+  Page *page = buffer_pool_manager_->FetchPage(root_page_id_);
+  auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+  if (node->IsLeafPage()) {
+    page->WLatch();
+  } else {
+    page->RLatch();
+  }
+  root_latch_.RUnlock();
+
+  while (!node->IsLeafPage()) {
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    Page *child_page = buffer_pool_manager_->FetchPage(internal->Lookup(key, comparator_));
+    auto *child = reinterpret_cast<BPlusTreePage *>(child_page->GetData());
+    if (child->IsLeafPage()) {
+      child_page->WLatch();
+    } else {
+      child_page->RLatch();
+    }
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    page = child_page;
+    node = child;
+  }
+  return page;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+Page *BPLUSTREE_TYPE::FindLeafPagePessimistic(const KeyType &key, Operation op, Transaction *transaction) {
+  root_latch_.WLock();
+  transaction->AddIntoPageSet(nullptr);
+  if (IsEmpty()) {
+    return nullptr;
+  }
+  Page *page = buffer_pool_manager_->FetchPage(root_page_id_);
+  page->WLatch();
+  auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+  if (IsSafe(node, op, true)) {
+    ReleaseWLatches(transaction, false);
+  }
+  transaction->AddIntoPageSet(page);
+
+  while (!node->IsLeafPage()) {
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    page = buffer_pool_manager_->FetchPage(internal->Lookup(key, comparator_));
+    page->WLatch();
+    node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+    if (IsSafe(node, op, false)) {
+      ReleaseWLatches(transaction, false);
+    }
+    transaction->AddIntoPageSet(page);
+  }
+  return page;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool BPLUSTREE_TYPE::IsSafe(BPlusTreePage *node, Operation op, bool is_root) const {
+  if (op == Operation::INSERT) {
+    return node->GetSize() < node->GetMaxSize();
+  }
+  if (op == Operation::DELETE) {
+    return node->GetSize() > node->GetMinSize(is_root);
+  }
+  return true;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::ReleaseWLatches(Transaction *transaction, bool is_dirty) {
+  auto page_set = transaction->GetPageSet();
+  while (!page_set->empty()) {
+    Page *page = page_set->front();
+    page_set->pop_front();
+    if (page == nullptr) {
+      root_latch_.WUnlock();
+    } else {
+      page->WUnlatch();
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), is_dirty);
+    }
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::DeletePages(Transaction *transaction) {
+  auto deleted_page_set = transaction->GetDeletedPageSet();
+  for (page_id_t page_id : *deleted_page_set) {
+    buffer_pool_manager_->DeletePage(page_id);
+  }
+  deleted_page_set->clear();
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool BPLUSTREE_TYPE::IsRootPage(Page *page, Transaction *transaction) const {
+  // the first latched page has no latched parent: it is either the root or it was safe, and a safe page never
+  // splits or underflows, so it can be treated as the root either way
+  auto page_set = transaction->GetPageSet();
+  auto first = page_set->begin();
+  if (first != page_set->end() && *first == nullptr) {
+    ++first;
+  }
+  return first != page_set->end() && *first == page;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+Page *BPLUSTREE_TYPE::GetParentPage(Page *page, Transaction *transaction) const {
+  auto page_set = transaction->GetPageSet();
+  for (size_t i = 1; i < page_set->size(); i++) {
+    if ((*page_set)[i] == page) {
+      BUSTUB_ASSERT((*page_set)[i - 1] != nullptr, "The parent of a page must be latched.");
+      return (*page_set)[i - 1];
+    }
+  }
+  UNREACHABLE("The page is not latched.");
+}
+
+/*****************************************************************************
+ * INSERTION
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+bool BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transaction *transaction) {
+  Page *page = FindLeafPageOptimistic(key);
+  if (page != nullptr) {
+    auto *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+    if (IsSafe(leaf, Operation::INSERT, false)) {
+      bool inserted = leaf->Insert(key, value, comparator_);
+      page->WUnlatch();
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), inserted);
+      return inserted;
+    }
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+  }
+
+  // the leaf may split, start over with write latches from the root
+  if (transaction == nullptr) {
+    Transaction local_transaction(INVALID_TXN_ID);
+    return InsertPessimistic(key, value, &local_transaction);
+  }
+  return InsertPessimistic(key, value, transaction);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool BPLUSTREE_TYPE::InsertPessimistic(const KeyType &key, const ValueType &value, Transaction *transaction) {
+  Page *page = FindLeafPagePessimistic(key, Operation::INSERT, transaction);
+  if (page == nullptr) {
+    StartNewTree(key, value);
+    ReleaseWLatches(transaction, true);
+    return true;
+  }
+
+  auto *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+  if (!leaf->Insert(key, value, comparator_)) {
+    ReleaseWLatches(transaction, false);
+    return false;
+  }
+  if (leaf->GetSize() > leaf->GetMaxSize()) {
+    page_id_t new_page_id;
+    Page *new_page = buffer_pool_manager_->NewPage(&new_page_id);
+    BUSTUB_ASSERT(new_page != nullptr, "Couldn't create a page to split a leaf into.");
+    auto *new_leaf = reinterpret_cast<LeafPage *>(new_page->GetData());
+    new_leaf->Init(new_page_id, leaf_max_size_);
+    leaf->MoveHalfTo(new_leaf);
+    InsertIntoParent(page, new_leaf->KeyAt(0), new_page, transaction);
+    buffer_pool_manager_->UnpinPage(new_page_id, true);
+  }
+  ReleaseWLatches(transaction, true);
+  return true;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::StartNewTree(const KeyType &key, const ValueType &value) {
+  page_id_t root_page_id;
+  Page *page = buffer_pool_manager_->NewPage(&root_page_id);
+  BUSTUB_ASSERT(page != nullptr, "Couldn't create a root page for the B+ tree.");
+  auto *root = reinterpret_cast<LeafPage *>(page->GetData());
+  root->Init(root_page_id, leaf_max_size_);
+  root->Insert(key, value, comparator_);
+  root_page_id_ = root_page_id;
+  buffer_pool_manager_->UnpinPage(root_page_id, true);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::InsertIntoParent(Page *old_page, const KeyType &key, Page *new_page, Transaction *transaction) {
+  if (IsRootPage(old_page, transaction)) {
+    page_id_t root_page_id;
+    Page *root_page = buffer_pool_manager_->NewPage(&root_page_id);
+    BUSTUB_ASSERT(root_page != nullptr, "Couldn't create a new root page for the B+ tree.");
+    auto *root = reinterpret_cast<InternalPage *>(root_page->GetData());
+    root->Init(root_page_id, internal_max_size_);
+    root->PopulateNewRoot(old_page->GetPageId(), key, new_page->GetPageId());
+    root_page_id_ = root_page_id;
+    buffer_pool_manager_->UnpinPage(root_page_id, true);
+    return;
+  }
+
+  Page *parent_page = GetParentPage(old_page, transaction);
+  auto *parent = reinterpret_cast<InternalPage *>(parent_page->GetData());
+  parent->InsertNodeAfter(old_page->GetPageId(), key, new_page->GetPageId());
+  if (parent->GetSize() > parent->GetMaxSize()) {
+    page_id_t sibling_page_id;
+    Page *sibling_page = buffer_pool_manager_->NewPage(&sibling_page_id);
+    BUSTUB_ASSERT(sibling_page != nullptr, "Couldn't create a page to split an internal page into.");
+    auto *sibling = reinterpret_cast<InternalPage *>(sibling_page->GetData());
+    sibling->Init(sibling_page_id, internal_max_size_);
+    parent->MoveHalfTo(sibling);
+    InsertIntoParent(parent_page, sibling->KeyAt(0), sibling_page, transaction);
+    buffer_pool_manager_->UnpinPage(sibling_page_id, true);
+  }
+}
+
+/*****************************************************************************
+ * BULK LOAD
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+bool BPLUSTREE_TYPE::BulkLoad(std::vector<std::pair<KeyType, ValueType>> *entries) {
+  root_latch_.WLock();
+  BUSTUB_ASSERT(IsEmpty(), "Bulk loading needs an empty tree.");
+
+  std::sort(entries->begin(), entries->end(),
+            [this](const auto &lhs, const auto &rhs) { return comparator_(lhs.first, rhs.first) < 0; });
+  // like Insert, a key that is already in the tree is rejected instead of dropping one of its values
+  auto duplicate = std::adjacent_find(entries->begin(), entries->end(), [this](const auto &lhs, const auto &rhs) {
+    return comparator_(lhs.first, rhs.first) == 0;
+  });
+  if (entries->empty() || duplicate != entries->end()) {
+    root_latch_.WUnlock();
+    return entries->empty();
+  }
+
+  // leaf level, remembering the first key and page id of every leaf for the level above
+  std::vector<std::pair<KeyType, page_id_t>> level;
+  int num_entries = static_cast<int>(entries->size());
+  int num_pages = (num_entries + leaf_max_size_ - 1) / leaf_max_size_;
+  LeafPage *prev_leaf = nullptr;
+  int offset = 0;
+  for (int i = 0; i < num_pages; i++) {
+    int size = num_entries / num_pages + (i < num_entries % num_pages ? 1 : 0);
+    page_id_t page_id;
+    Page *page = buffer_pool_manager_->NewPage(&page_id);
+    BUSTUB_ASSERT(page != nullptr, "Couldn't create a leaf page to bulk load into.");
+    auto *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+    leaf->Init(page_id, leaf_max_size_);
+    leaf->CopyNFrom(entries->data() + offset, size);
+    if (prev_leaf != nullptr) {
+      prev_leaf->SetNextPageId(page_id);
+      buffer_pool_manager_->UnpinPage(prev_leaf->GetPageId(), true);
+    }
+    level.emplace_back(leaf->KeyAt(0), page_id);
+    prev_leaf = leaf;
+    offset += size;
+  }
+  buffer_pool_manager_->UnpinPage(prev_leaf->GetPageId(), true);
+
+  // internal levels, until a single root is left
+  while (level.size() > 1) {
+    std::vector<std::pair<KeyType, page_id_t>> parents;
+    int num_children = static_cast<int>(level.size());
+    num_pages = (num_children + internal_max_size_ - 1) / internal_max_size_;
+    offset = 0;
+    for (int i = 0; i < num_pages; i++) {
+      int size = num_children / num_pages + (i < num_children % num_pages ? 1 : 0);
+      page_id_t page_id;
+      Page *page = buffer_pool_manager_->NewPage(&page_id);
+      BUSTUB_ASSERT(page != nullptr, "Couldn't create an internal page to bulk load into.");
+      auto *internal = reinterpret_cast<InternalPage *>(page->GetData());
+      internal->Init(page_id, internal_max_size_);
+      internal->CopyNFrom(level.data() + offset, size);
+      parents.emplace_back(level[offset].first, page_id);
+      buffer_pool_manager_->UnpinPage(page_id, true);
+      offset += size;
+    }
+    level = std::move(parents);
+  }
+
+  root_page_id_ = level[0].second;
+  root_latch_.WUnlock();
+  return true;
+}
+
+/*****************************************************************************
+ * REMOVE
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *transaction) {
+  Page *page = FindLeafPageOptimistic(key);
+  if (page == nullptr) {
+    return;
+  }
+  auto *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+  if (IsSafe(leaf, Operation::DELETE, false)) {
+    bool removed = leaf->RemoveAndDeleteRecord(key, comparator_);
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), removed);
+    return;
+  }
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+
+  // the leaf may underflow, start over with write latches from the root
+  if (transaction == nullptr) {
+    Transaction local_transaction(INVALID_TXN_ID);
+    RemovePessimistic(key, &local_transaction);
+    return;
+  }
+  RemovePessimistic(key, transaction);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::RemovePessimistic(const KeyType &key, Transaction *transaction) {
+  Page *page = FindLeafPagePessimistic(key, Operation::DELETE, transaction);
+  if (page == nullptr) {
+    ReleaseWLatches(transaction, false);
+    return;
+  }
+
+  auto *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+  if (!leaf->RemoveAndDeleteRecord(key, comparator_)) {
+    ReleaseWLatches(transaction, false);
+    return;
+  }
+  if (leaf->GetSize() < leaf->GetMinSize(IsRootPage(page, transaction))) {
+    CoalesceOrRedistribute(page, transaction);
+  }
+  ReleaseWLatches(transaction, true);
+  DeletePages(transaction);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::CoalesceOrRedistribute(Page *page, Transaction *transaction) {
+  if (IsRootPage(page, transaction)) {
+    AdjustRoot(page, transaction);
+    return;
+  }
+
+  Page *parent_page = GetParentPage(page, transaction);
+  auto *parent = reinterpret_cast<InternalPage *>(parent_page->GetData());
+  auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+  int index = parent->ValueIndex(node->GetPageId());
+
+  // pair up with the left sibling, or the right one for the left most child; siblings are only reachable through the
+  // write-latched parent, so latching one cannot deadlock with another writer
+  int sibling_index = index == 0 ? 1 : index - 1;
+  Page *sibling_page = buffer_pool_manager_->FetchPage(parent->ValueAt(sibling_index));
+  sibling_page->WLatch();
+  auto *sibling = reinterpret_cast<BPlusTreePage *>(sibling_page->GetData());
+
+  int right_index = index == 0 ? 1 : index;
+  BPlusTreePage *left = index == 0 ? node : sibling;
+  BPlusTreePage *right = index == 0 ? sibling : node;
+
+  if (node->GetSize() + sibling->GetSize() <= node->GetMaxSize()) {
+    // coalesce: the right page is merged into the left one and dropped from the parent
+    if (node->IsLeafPage()) {
+      reinterpret_cast<LeafPage *>(right)->MoveAllTo(reinterpret_cast<LeafPage *>(left));
+    } else {
+      reinterpret_cast<InternalPage *>(right)->MoveAllTo(reinterpret_cast<InternalPage *>(left),
+                                                          parent->KeyAt(right_index));
+    }
+    parent->Remove(right_index);
+    transaction->AddIntoDeletedPageSet(right->GetPageId());
+    sibling_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(sibling_page->GetPageId(), true);
+
+    if (parent->GetSize() < parent->GetMinSize(IsRootPage(parent_page, transaction))) {
+      CoalesceOrRedistribute(parent_page, transaction);
+    }
+    return;
+  }
+
+  // redistribute: borrow one entry from the sibling
+  if (node->IsLeafPage()) {
+    auto *leaf = reinterpret_cast<LeafPage *>(node);
+    auto *sibling_leaf = reinterpret_cast<LeafPage *>(sibling);
+    if (index == 0) {
+      sibling_leaf->MoveFirstToEndOf(leaf);
+    } else {
+      sibling_leaf->MoveLastToFrontOf(leaf);
+    }
+    parent->SetKeyAt(right_index, reinterpret_cast<LeafPage *>(right)->KeyAt(0));
+  } else {
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    auto *sibling_internal = reinterpret_cast<InternalPage *>(sibling);
+    if (index == 0) {
+      sibling_internal->MoveFirstToEndOf(internal, parent->KeyAt(right_index));
+    } else {
+      sibling_internal->MoveLastToFrontOf(internal, parent->KeyAt(right_index));
+    }
+    parent->SetKeyAt(right_index, reinterpret_cast<InternalPage *>(right)->KeyAt(0));
+  }
+  sibling_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(sibling_page->GetPageId(), true);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::AdjustRoot(Page *page, Transaction *transaction) {
+  auto *root = reinterpret_cast<BPlusTreePage *>(page->GetData());
+  if (root->IsLeafPage()) {
+    // the last key was removed
+    root_page_id_ = INVALID_PAGE_ID;
+  } else {
+    // only one child is left, it becomes the new root
+    root_page_id_ = reinterpret_cast<InternalPage *>(root)->ValueAt(0);
+  }
+  transaction->AddIntoDeletedPageSet(root->GetPageId());
+}
+
+/*****************************************************************************
+ * INDEX ITERATOR
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin() {
+  KeyType key{};
+  return INDEXITERATOR_TYPE(this, buffer_pool_manager_, FindLeafPageRead(key, true), 0);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin(const KeyType &key) {
+  Page *page = FindLeafPageRead(key);
+  if (page == nullptr) {
+    return INDEXITERATOR_TYPE();
+  }
+  int index = reinterpret_cast<LeafPage *>(page->GetData())->KeyIndex(key, comparator_);
+  return INDEXITERATOR_TYPE(this, buffer_pool_manager_, page, index);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE BPLUSTREE_TYPE::End() { return INDEXITERATOR_TYPE(); }
+
+/*****************************************************************************
+ * UTILITIES AND DEBUG
+ *****************************************************************************/
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::VerifyIntegrity() {
+  if (IsEmpty()) {
+    return;
+  }
+  int num_keys = 0;
+  VerifySubtree(root_page_id_, true, nullptr, nullptr, &num_keys);
+
+  // the leaf chain visits every key in order
+  int num_chained = 0;
+  KeyType prev_key{};
+  for (auto iter = Begin(); !iter.IsEnd(); ++iter) {
+    BUSTUB_ASSERT(num_chained == 0 || comparator_(prev_key, (*iter).first) < 0, "Leaf chain out of order.");
+    prev_key = (*iter).first;
+    num_chained++;
+  }
+  BUSTUB_ASSERT(num_chained == num_keys, "Leaf chain misses keys.");
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+int BPLUSTREE_TYPE::VerifySubtree(page_id_t page_id, bool is_root, const KeyType *lower, const KeyType *upper,
+                                  int *num_keys) {
+  Page *page = buffer_pool_manager_->FetchPage(page_id);
+  auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+  BUSTUB_ASSERT(node->GetPageId() == page_id, "Page id mismatch.");
+  BUSTUB_ASSERT(node->GetSize() <= node->GetMaxSize(), "Page overflow.");
+  BUSTUB_ASSERT(node->GetSize() >= node->GetMinSize(is_root), "Page underflow.");
+
+  int depth = 0;
+  if (node->IsLeafPage()) {
+    auto *leaf = reinterpret_cast<LeafPage *>(node);
+    for (int i = 0; i < leaf->GetSize(); i++) {
+      [[maybe_unused]] KeyType key = leaf->KeyAt(i);
+      BUSTUB_ASSERT(i == 0 || comparator_(leaf->KeyAt(i - 1), key) < 0, "Leaf keys out of order.");
+      BUSTUB_ASSERT(lower == nullptr || comparator_(*lower, key) <= 0, "Leaf key below its separator.");
+      BUSTUB_ASSERT(upper == nullptr || comparator_(key, *upper) < 0, "Leaf key above its separator.");
+    }
+    *num_keys += leaf->GetSize();
+  } else {
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    for (int i = 0; i < internal->GetSize(); i++) {
+      KeyType child_lower = i == 0 ? KeyType{} : internal->KeyAt(i);
+      KeyType child_upper = i + 1 < internal->GetSize() ? internal->KeyAt(i + 1) : KeyType{};
+      int child_depth =
+          VerifySubtree(internal->ValueAt(i), false, i == 0 ? lower : &child_lower,
+                        i + 1 < internal->GetSize() ? &child_upper : upper, num_keys);
+      BUSTUB_ASSERT(i == 0 || child_depth == depth, "Leaves at different depths.");
+      depth = child_depth;
+    }
+    depth++;
+  }
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  return depth;
+}
+
+template class BPlusTree<GenericKey<4>, RID, GenericComparator<4>>;
+template class BPlusTree<GenericKey<8>, RID, GenericComparator<8>>;
+template class BPlusTree<GenericKey<16>, RID, GenericComparator<16>>;
+template class BPlusTree<GenericKey<32>, RID, GenericComparator<32>>;
+template class BPlusTree<GenericKey<64>, RID, GenericComparator<64>>;
+
+}  // namespace bustub
@@ -0,0 +1,101 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_index.cpp
+//
+// Identification: src/storage/index/b_plus_tree_index.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/index/b_plus_tree_index.h"
+
+#include <utility>
+#include <vector>
+
+#include "common/exception.h"
+
+namespace bustub {
+/*
+ * Constructor
+ */
+INDEX_TEMPLATE_ARGUMENTS
+BPLUSTREE_INDEX_TYPE::BPlusTreeIndex(IndexMetadata *metadata, BufferPoolManager *buffer_pool_manager)
+    : Index(metadata),
+      comparator_(metadata->GetKeySchema()),
+      container_(metadata->GetName(), buffer_pool_manager, comparator_) {}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) {
+  // construct insert index key
+  KeyType index_key;
+  index_key.SetFromKey(key, *GetKeySchema());
+
+  if (!container_.Insert(index_key, rid, transaction)) {
+    ThrowDuplicateKey(transaction);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
+  // construct delete index key
+  KeyType index_key;
+  index_key.SetFromKey(key, *GetKeySchema());
+
+  // the key may belong to another tuple by now, e.g. after a failed insert of this one
+  std::vector<RID> rids;
+  if (container_.GetValue(index_key, &rids, transaction) && rids[0] == rid) {
+    container_.Remove(index_key, transaction);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) {
+  // construct scan index key
+  KeyType index_key;
+  index_key.SetFromKey(key, *GetKeySchema());
+
+  container_.GetValue(index_key, result, transaction);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::BulkLoad(TableHeap *table_heap, const Schema &tuple_schema, Transaction *transaction) {
+  // collect every key in one scan, the tree sorts them and builds itself bottom-up
+  std::vector<std::pair<KeyType, ValueType>> entries;
+  KeyType index_key;
+  for (auto iter = table_heap->Begin(transaction); iter != table_heap->End(); ++iter) {
+    index_key.SetFromKey(iter->KeyFromTuple(tuple_schema, *GetKeySchema(), GetKeyAttrs()), *GetKeySchema());
+    entries.emplace_back(index_key, iter->GetRid());
+  }
+
+  if (!container_.BulkLoad(&entries)) {
+    ThrowDuplicateKey(transaction);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::ThrowDuplicateKey(Transaction *transaction) {
+  if (transaction != nullptr) {
+    transaction->SetState(TransactionState::ABORTED);
+  }
+  throw Exception(ExceptionType::DUPLICATE_KEY, "The key is already in the unique index " + GetName() + ".");
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE BPLUSTREE_INDEX_TYPE::GetBeginIterator() { return container_.Begin(); }
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE BPLUSTREE_INDEX_TYPE::GetBeginIterator(const KeyType &key) { return container_.Begin(key); }
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE BPLUSTREE_INDEX_TYPE::GetEndIterator() { return container_.End(); }
+
+template class BPlusTreeIndex<GenericKey<4>, RID, GenericComparator<4>>;
+template class BPlusTreeIndex<GenericKey<8>, RID, GenericComparator<8>>;
+template class BPlusTreeIndex<GenericKey<16>, RID, GenericComparator<16>>;
+template class BPlusTreeIndex<GenericKey<32>, RID, GenericComparator<32>>;
+template class BPlusTreeIndex<GenericKey<64>, RID, GenericComparator<64>>;
+
+}  // namespace bustub
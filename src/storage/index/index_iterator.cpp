@@ -0,0 +1,141 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// index_iterator.cpp
+//
+// Identification: src/storage/index/index_iterator.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/index/index_iterator.h"
+
+#include <thread>  // NOLINT
+
+#include "common/rid.h"
+#include "storage/index/b_plus_tree.h"
+
+namespace bustub {
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE::IndexIterator() = default;
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE::IndexIterator(BPlusTree<KeyType, ValueType, KeyComparator> *tree,
+                                  BufferPoolManager *buffer_pool_manager, Page *page, int index)
+    : tree_(tree), buffer_pool_manager_(buffer_pool_manager), page_(page), index_(index) {
+  if (page_ != nullptr) {
+    leaf_ = reinterpret_cast<LeafPage *>(page_->GetData());
+    SkipExhaustedLeaves();
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE::~IndexIterator() { Release(); }
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE::IndexIterator(IndexIterator &&other) noexcept
+    : tree_(other.tree_),
+      buffer_pool_manager_(other.buffer_pool_manager_),
+      page_(other.page_),
+      leaf_(other.leaf_),
+      index_(other.index_) {
+  other.page_ = nullptr;
+  other.leaf_ = nullptr;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE &INDEXITERATOR_TYPE::operator=(IndexIterator &&other) noexcept {
+  if (this != &other) {
+    Release();
+    tree_ = other.tree_;
+    buffer_pool_manager_ = other.buffer_pool_manager_;
+    page_ = other.page_;
+    leaf_ = other.leaf_;
+    index_ = other.index_;
+    other.page_ = nullptr;
+    other.leaf_ = nullptr;
+  }
+  return *this;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool INDEXITERATOR_TYPE::IsEnd() const { return page_ == nullptr; }
+
+INDEX_TEMPLATE_ARGUMENTS
+const MappingType &INDEXITERATOR_TYPE::operator*() { return leaf_->GetItem(index_); }
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE &INDEXITERATOR_TYPE::operator++() {
+  index_++;
+  SkipExhaustedLeaves();
+  return *this;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool INDEXITERATOR_TYPE::operator==(const IndexIterator &itr) const {
+  if (IsEnd() || itr.IsEnd()) {
+    return IsEnd() && itr.IsEnd();
+  }
+  return page_->GetPageId() == itr.page_->GetPageId() && index_ == itr.index_;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+bool INDEXITERATOR_TYPE::operator!=(const IndexIterator &itr) const { return !(*this == itr); }
+
+INDEX_TEMPLATE_ARGUMENTS
+void INDEXITERATOR_TYPE::SkipExhaustedLeaves() {
+  while (page_ != nullptr && index_ >= leaf_->GetSize()) {
+    page_id_t next_page_id = leaf_->GetNextPageId();
+    if (next_page_id == INVALID_PAGE_ID) {
+      Release();
+      return;
+    }
+
+    Page *next_page = buffer_pool_manager_->FetchPage(next_page_id);
+    if (next_page->TryRLatch()) {
+      Release();
+      page_ = next_page;
+      leaf_ = reinterpret_cast<LeafPage *>(page_->GetData());
+      index_ = 0;
+      continue;
+    }
+
+    // a writer holds the next leaf and may be waiting for this one, back off and look the successor up again
+    buffer_pool_manager_->UnpinPage(next_page_id, false);
+    BUSTUB_ASSERT(leaf_->GetSize() > 0, "Only an empty tree has an empty leaf.");
+    KeyType last_key = leaf_->KeyAt(leaf_->GetSize() - 1);
+    Release();
+    std::this_thread::yield();
+
+    page_ = tree_->FindLeafPageRead(last_key);
+    if (page_ == nullptr) {
+      return;
+    }
+    leaf_ = reinterpret_cast<LeafPage *>(page_->GetData());
+    index_ = leaf_->KeyIndex(last_key, tree_->comparator_);
+    if (index_ < leaf_->GetSize() && tree_->comparator_(leaf_->KeyAt(index_), last_key) == 0) {
+      index_++;
+    }
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void INDEXITERATOR_TYPE::Release() {
+  if (page_ != nullptr) {
+    page_->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page_->GetPageId(), false);
+    page_ = nullptr;
+    leaf_ = nullptr;
+  }
+}
+
+template class IndexIterator<GenericKey<4>, RID, GenericComparator<4>>;
+template class IndexIterator<GenericKey<8>, RID, GenericComparator<8>>;
+template class IndexIterator<GenericKey<16>, RID, GenericComparator<16>>;
+template class IndexIterator<GenericKey<32>, RID, GenericComparator<32>>;
+template class IndexIterator<GenericKey<64>, RID, GenericComparator<64>>;
+
+}  // namespace bustub
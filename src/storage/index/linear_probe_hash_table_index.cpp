@@ -1,3 +1,5 @@
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "storage/index/linear_probe_hash_table_index.h"
@@ -8,41 +10,162 @@ namespace bustub {
  */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 HASH_TABLE_INDEX_TYPE::LinearProbeHashTableIndex(IndexMetadata *metadata, BufferPoolManager *buffer_pool_manager,
-                                                 size_t num_buckets, const HashFunction<KeyType> &hash_fn)
+                                                 size_t num_buckets, const HashFunction<KeyType> &hash_fn,
+                                                 bool use_bloom_filter)
     : Index(metadata),
       comparator_(metadata->GetKeySchema()),
-      container_(metadata->GetName(), buffer_pool_manager, comparator_, num_buckets, hash_fn) {}
+      container_(metadata->GetName(), buffer_pool_manager, comparator_, num_buckets, hash_fn, use_bloom_filter) {}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+ValueType HASH_TABLE_INDEX_TYPE::MakeValue(const Tuple *included, RID rid) const {
+  if constexpr (std::is_same_v<ValueType, RID>) {
+    return rid;
+  } else {
+    ValueType value;
+    if (included == nullptr) {
+      value.Set(rid);
+    } else {
+      value.Set(rid, *included);
+    }
+    return value;
+  }
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+std::vector<RID> HASH_TABLE_INDEX_TYPE::ToRids(const std::vector<ValueType> &values) {
+  if constexpr (std::is_same_v<ValueType, RID>) {
+    return values;
+  } else {
+    std::vector<RID> rids;
+    rids.reserve(values.size());
+    for (const auto &value : values) {
+      rids.push_back(value.GetRid());
+    }
+    return rids;
+  }
+}
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 void HASH_TABLE_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) {
+  BUSTUB_ASSERT(!IsCovering(), "A covering index needs the included columns of the tuple.");
+  // construct insert index key
+  KeyType index_key;
+  index_key.SetFromKey(key, *GetKeySchema());
+
+  container_.Insert(transaction, index_key, MakeValue(nullptr, rid));
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_INDEX_TYPE::InsertEntry(const Tuple &key, const Tuple &included, RID rid, Transaction *transaction) {
   // construct insert index key
   KeyType index_key;
-  index_key.SetFromKey(key);
+  index_key.SetFromKey(key, *GetKeySchema());
 
-  container_.Insert(transaction, index_key, rid);
+  container_.Insert(transaction, index_key, MakeValue(&included, rid));
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 void HASH_TABLE_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
   // construct delete index key
   KeyType index_key;
-  index_key.SetFromKey(key);
+  index_key.SetFromKey(key, *GetKeySchema());
 
-  container_.Remove(transaction, index_key, rid);
+  // entries are equal by their RID, so the included columns are not needed
+  container_.Remove(transaction, index_key, MakeValue(nullptr, rid));
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 void HASH_TABLE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) {
   // construct scan index key
   KeyType index_key;
-  index_key.SetFromKey(key);
+  index_key.SetFromKey(key, *GetKeySchema());
 
-  container_.GetValue(transaction, index_key, result);
+  if constexpr (std::is_same_v<ValueType, RID>) {
+    container_.GetValue(transaction, index_key, result);
+  } else {
+    std::vector<ValueType> values;
+    container_.GetValue(transaction, index_key, &values);
+    std::vector<RID> rids = ToRids(values);
+    result->insert(result->end(), rids.begin(), rids.end());
+  }
 }
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_INDEX_TYPE::ScanKeys(const std::vector<Tuple> &keys, std::vector<std::vector<RID>> *results,
+                                     Transaction *transaction) {
+  std::vector<KeyType> index_keys(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    index_keys[i].SetFromKey(keys[i], *GetKeySchema());
+  }
+
+  if constexpr (std::is_same_v<ValueType, RID>) {
+    container_.GetValues(transaction, index_keys, results);
+  } else {
+    std::vector<std::vector<ValueType>> values;
+    container_.GetValues(transaction, index_keys, &values);
+    results->clear();
+    results->reserve(values.size());
+    for (const auto &key_values : values) {
+      results->push_back(ToRids(key_values));
+    }
+  }
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_INDEX_TYPE::ScanKeyIncluded(const Tuple &key, std::vector<Tuple> *result, Transaction *transaction) {
+  if constexpr (std::is_same_v<ValueType, RID>) {
+    Index::ScanKeyIncluded(key, result, transaction);
+  } else {
+    KeyType index_key;
+    index_key.SetFromKey(key, *GetKeySchema());
+
+    std::vector<ValueType> values;
+    container_.GetValue(transaction, index_key, &values);
+    const Schema *included_schema = GetIncludedSchema();
+    for (const auto &value : values) {
+      std::vector<Value> included;
+      included.reserve(included_schema->GetColumnCount());
+      for (uint32_t i = 0; i < included_schema->GetColumnCount(); i++) {
+        included.push_back(value.ToValue(included_schema, i));
+      }
+      result->emplace_back(included, included_schema);
+    }
+  }
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_INDEX_TYPE::BulkLoad(TableHeap *table_heap, const Schema &tuple_schema, Transaction *transaction) {
+  // collect every key in one scan so the table is sized once and filled block by block
+  std::vector<std::pair<KeyType, ValueType>> entries;
+  KeyType index_key;
+  for (auto iter = table_heap->Begin(transaction); iter != table_heap->End(); ++iter) {
+    index_key.SetFromKey(iter->KeyFromTuple(tuple_schema, *GetKeySchema(), GetKeyAttrs()), *GetKeySchema());
+    if (IsCovering()) {
+      Tuple included = iter->KeyFromTuple(tuple_schema, *GetIncludedSchema(), GetIncludedAttrs());
+      entries.emplace_back(index_key, MakeValue(&included, iter->GetRid()));
+    } else {
+      entries.emplace_back(index_key, MakeValue(nullptr, iter->GetRid()));
+    }
+  }
+
+  container_.BulkLoad(transaction, entries);
+}
+
 template class LinearProbeHashTableIndex<GenericKey<4>, RID, GenericComparator<4>>;
 template class LinearProbeHashTableIndex<GenericKey<8>, RID, GenericComparator<8>>;
 template class LinearProbeHashTableIndex<GenericKey<16>, RID, GenericComparator<16>>;
 template class LinearProbeHashTableIndex<GenericKey<32>, RID, GenericComparator<32>>;
 template class LinearProbeHashTableIndex<GenericKey<64>, RID, GenericComparator<64>>;
 
+template class LinearProbeHashTableIndex<GenericKey<4>, CoveringValue<16>, GenericComparator<4>>;
+template class LinearProbeHashTableIndex<GenericKey<8>, CoveringValue<16>, GenericComparator<8>>;
+template class LinearProbeHashTableIndex<GenericKey<16>, CoveringValue<16>, GenericComparator<16>>;
+template class LinearProbeHashTableIndex<GenericKey<32>, CoveringValue<16>, GenericComparator<32>>;
+template class LinearProbeHashTableIndex<GenericKey<64>, CoveringValue<16>, GenericComparator<64>>;
+template class LinearProbeHashTableIndex<GenericKey<4>, CoveringValue<32>, GenericComparator<4>>;
+template class LinearProbeHashTableIndex<GenericKey<8>, CoveringValue<32>, GenericComparator<8>>;
+template class LinearProbeHashTableIndex<GenericKey<16>, CoveringValue<32>, GenericComparator<16>>;
+template class LinearProbeHashTableIndex<GenericKey<32>, CoveringValue<32>, GenericComparator<32>>;
+template class LinearProbeHashTableIndex<GenericKey<64>, CoveringValue<32>, GenericComparator<64>>;
+
 }  // namespace bustub
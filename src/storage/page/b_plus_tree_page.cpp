@@ -0,0 +1,45 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_page.cpp
+//
+// Identification: src/storage/page/b_plus_tree_page.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/page/b_plus_tree_page.h"
+
+namespace bustub {
+
+bool BPlusTreePage::IsLeafPage() const { return page_type_ == IndexPageType::LEAF_PAGE; }
+
+void BPlusTreePage::SetPageType(IndexPageType page_type) { page_type_ = page_type; }
+
+int BPlusTreePage::GetSize() const { return size_; }
+
+void BPlusTreePage::SetSize(int size) { size_ = size; }
+
+void BPlusTreePage::IncreaseSize(int amount) { size_ += amount; }
+
+int BPlusTreePage::GetMaxSize() const { return max_size_; }
+
+void BPlusTreePage::SetMaxSize(int max_size) { max_size_ = max_size; }
+
+int BPlusTreePage::GetMinSize(bool is_root) const {
+  if (is_root) {
+    // a root leaf may hold a single key, a root internal page needs at least two children
+    return IsLeafPage() ? 1 : 2;
+  }
+  return (max_size_ + 1) / 2;
+}
+
+page_id_t BPlusTreePage::GetPageId() const { return page_id_; }
+
+void BPlusTreePage::SetPageId(page_id_t page_id) { page_id_ = page_id; }
+
+void BPlusTreePage::SetLSN(lsn_t lsn) { lsn_ = lsn; }
+
+}  // namespace bustub
@@ -0,0 +1,54 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// bloom_filter_page.cpp
+//
+// Identification: src/storage/page/bloom_filter_page.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/page/bloom_filter_page.h"
+
+namespace bustub {
+
+namespace {
+
+// odd multipliers, one per word, that spread a hash into independent bit positions
+constexpr uint32_t SALTS[BloomFilterPage::WORDS_PER_BLOCK] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                                               0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+}  // namespace
+
+page_id_t BloomFilterPage::GetNextPageId() const { return next_page_id_; }
+
+void BloomFilterPage::SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+void BloomFilterPage::Masks(uint32_t hash, uint64_t masks[WORDS_PER_BLOCK]) {
+  // the top six bits of each product pick one of the 64 bits of the word
+  for (size_t i = 0; i < WORDS_PER_BLOCK; ++i) {
+    masks[i] = uint64_t{1} << ((hash * SALTS[i]) >> 26);
+  }
+}
+
+void BloomFilterPage::Insert(size_t block_idx, uint32_t hash) {
+  uint64_t masks[WORDS_PER_BLOCK];
+  Masks(hash, masks);
+  for (size_t i = 0; i < WORDS_PER_BLOCK; ++i) {
+    blocks_[block_idx][i].fetch_or(masks[i], std::memory_order_relaxed);
+  }
+}
+
+bool BloomFilterPage::MayContain(size_t block_idx, uint32_t hash) const {
+  uint64_t masks[WORDS_PER_BLOCK];
+  Masks(hash, masks);
+  uint64_t missing = 0;
+  for (size_t i = 0; i < WORDS_PER_BLOCK; ++i) {
+    missing |= masks[i] & ~blocks_[block_idx][i].load(std::memory_order_relaxed);
+  }
+  return missing == 0;
+}
+
+}  // namespace bustub
@@ -0,0 +1,44 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map_page.cpp
+//
+// Identification: src/storage/page/free_space_map_page.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/page/free_space_map_page.h"
+
+namespace bustub {
+
+void FreeSpaceMapPage::Init() {
+  next_page_id_ = INVALID_PAGE_ID;
+  num_entries_ = 0;
+}
+
+page_id_t FreeSpaceMapPage::GetNextPageId() const { return next_page_id_; }
+
+void FreeSpaceMapPage::SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+uint32_t FreeSpaceMapPage::GetNumEntries() const { return num_entries_; }
+
+page_id_t FreeSpaceMapPage::GetTablePageId(uint32_t entry_idx) const { return table_page_ids_[entry_idx]; }
+
+uint8_t FreeSpaceMapPage::GetCategory(uint32_t entry_idx) const { return categories_[entry_idx]; }
+
+void FreeSpaceMapPage::SetCategory(uint32_t entry_idx, uint8_t category) { categories_[entry_idx] = category; }
+
+bool FreeSpaceMapPage::Append(page_id_t table_page_id, uint8_t category) {
+  if (num_entries_ == CAPACITY) {
+    return false;
+  }
+  table_page_ids_[num_entries_] = table_page_id;
+  categories_[num_entries_] = category;
+  num_entries_++;
+  return true;
+}
+
+}  // namespace bustub
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "storage/page/hash_table_block_page.h"
+#include "storage/index/covering_value.h"
 #include "storage/index/generic_key.h"
 
 namespace bustub {
@@ -58,6 +59,35 @@ bool HASH_TABLE_BLOCK_TYPE::IsReadable(slot_offset_t bucket_ind) const {
   return readable_[bucket_ind/8] & (1 << bucket_ind%8);
 }
 
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_BLOCK_TYPE::Prefetch(slot_offset_t bucket_ind) const {
+  __builtin_prefetch(&array_[bucket_ind]);
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_BLOCK_TYPE::Clear(slot_offset_t bucket_ind) {
+  readable_[bucket_ind / 8] &= ~(1 << bucket_ind % 8);
+  occupied_[bucket_ind / 8] &= ~(1 << bucket_ind % 8);
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+size_t HASH_TABLE_BLOCK_TYPE::NumOccupied() const {
+  size_t num_occupied = 0;
+  for (size_t i = 0; i < (BLOCK_ARRAY_SIZE - 1) / 8 + 1; ++i) {
+    num_occupied += __builtin_popcount(static_cast<unsigned char>(occupied_[i]));
+  }
+  return num_occupied;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+size_t HASH_TABLE_BLOCK_TYPE::NumReadable() const {
+  size_t num_readable = 0;
+  for (size_t i = 0; i < (BLOCK_ARRAY_SIZE - 1) / 8 + 1; ++i) {
+    num_readable += __builtin_popcount(static_cast<unsigned char>(readable_[i]));
+  }
+  return num_readable;
+}
+
 // DO NOT REMOVE ANYTHING BELOW THIS LINE
 template class HashTableBlockPage<int, int, IntComparator>;
 template class HashTableBlockPage<GenericKey<4>, RID, GenericComparator<4>>;
@@ -66,4 +96,15 @@ template class HashTableBlockPage<GenericKey<16>, RID, GenericComparator<16>>;
 template class HashTableBlockPage<GenericKey<32>, RID, GenericComparator<32>>;
 template class HashTableBlockPage<GenericKey<64>, RID, GenericComparator<64>>;
 
+template class HashTableBlockPage<GenericKey<4>, CoveringValue<16>, GenericComparator<4>>;
+template class HashTableBlockPage<GenericKey<8>, CoveringValue<16>, GenericComparator<8>>;
+template class HashTableBlockPage<GenericKey<16>, CoveringValue<16>, GenericComparator<16>>;
+template class HashTableBlockPage<GenericKey<32>, CoveringValue<16>, GenericComparator<32>>;
+template class HashTableBlockPage<GenericKey<64>, CoveringValue<16>, GenericComparator<64>>;
+template class HashTableBlockPage<GenericKey<4>, CoveringValue<32>, GenericComparator<4>>;
+template class HashTableBlockPage<GenericKey<8>, CoveringValue<32>, GenericComparator<8>>;
+template class HashTableBlockPage<GenericKey<16>, CoveringValue<32>, GenericComparator<16>>;
+template class HashTableBlockPage<GenericKey<32>, CoveringValue<32>, GenericComparator<32>>;
+template class HashTableBlockPage<GenericKey<64>, CoveringValue<32>, GenericComparator<64>>;
+
 }  // namespace bustub
@@ -51,4 +51,11 @@ size_t HashTableHeaderPage::GetSize() const {
   return size_;
 }
 
+void HashTableHeaderPage::SetFilterPageId(page_id_t filter_page_id) { filter_page_id_ = filter_page_id; }
+
+void HashTableHeaderPage::SetCounts(size_t num_pairs, size_t num_tombstones) {
+  num_pairs_ = static_cast<uint32_t>(num_pairs);
+  num_tombstones_ = static_cast<uint32_t>(num_tombstones);
+}
+
 }  // namespace bustub
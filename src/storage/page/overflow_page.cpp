@@ -0,0 +1,34 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// overflow_page.cpp
+//
+// Identification: src/storage/page/overflow_page.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/page/overflow_page.h"
+
+namespace bustub {
+
+void OverflowPage::Init() {
+  next_page_id_ = INVALID_PAGE_ID;
+  data_size_ = 0;
+}
+
+page_id_t OverflowPage::GetNextPageId() const { return next_page_id_; }
+
+void OverflowPage::SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+uint32_t OverflowPage::GetDataSize() const { return data_size_; }
+
+void OverflowPage::SetDataSize(uint32_t data_size) { data_size_ = data_size; }
+
+const char *OverflowPage::GetData() const { return data_; }
+
+char *OverflowPage::GetData() { return data_; }
+
+}  // namespace bustub
@@ -0,0 +1,177 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// pax_page.cpp
+//
+// Identification: src/storage/page/pax_page.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/page/pax_page.h"
+
+#include "type/limits.h"
+
+namespace bustub {
+
+namespace {
+
+// every minipage starts at an 8 byte boundary, so values up to 8 bytes wide are aligned
+constexpr uint32_t MINIPAGE_ALIGNMENT = 8;
+
+constexpr uint32_t AlignUp(uint32_t offset) { return (offset + MINIPAGE_ALIGNMENT - 1) & ~(MINIPAGE_ALIGNMENT - 1); }
+
+}  // namespace
+
+PaxLayout::PaxLayout(const Schema &schema) : schema_(schema) {
+  // a row takes its deleted flag and a value in every minipage, and varlen columns reserve their declared length plus
+  // its length prefix in the varlen area
+  uint32_t row_size = 1;
+  for (const auto &col : schema_.GetColumns()) {
+    if (col.IsInlined()) {
+      row_size += col.GetFixedLength();
+    } else {
+      row_size += sizeof(uint32_t) + sizeof(uint32_t) + col.GetVariableLength();
+    }
+  }
+  uint32_t num_regions = schema_.GetColumnCount() + 1;
+  capacity_ = (PAGE_SIZE - PaxPage::HEADER_SIZE - num_regions * MINIPAGE_ALIGNMENT) / row_size;
+
+  uint32_t offset = PaxPage::HEADER_SIZE + capacity_;
+  for (uint32_t i = 0; i < schema_.GetColumnCount(); i++) {
+    offset = AlignUp(offset);
+    minipage_offsets_.push_back(offset);
+    offset += capacity_ * GetWidth(i);
+  }
+  minipages_end_ = offset;
+}
+
+void PaxPage::Init(page_id_t page_id) {
+  memcpy(GetData(), &page_id, sizeof(page_id));
+  SetNextPageId(INVALID_PAGE_ID);
+  SetNumRows(0);
+  SetNumLiveRows(0);
+  SetFreeSpacePointer(PAGE_SIZE);
+}
+
+uint32_t PaxPage::VarlenSize(const char *value) {
+  uint32_t len = *reinterpret_cast<const uint32_t *>(value);
+  return sizeof(uint32_t) + (len == BUSTUB_VALUE_NULL ? 0 : len);
+}
+
+bool PaxPage::InsertTuple(const PaxLayout &layout, const Tuple &tuple, RID *rid) {
+  const Schema &schema = layout.GetSchema();
+  uint32_t row = GetNumRows();
+  if (row == layout.GetCapacity()) {
+    return false;
+  }
+  uint32_t varlen_size = 0;
+  for (uint32_t col_idx : schema.GetUnlinedColumns()) {
+    varlen_size += VarlenSize(tuple.GetDataPtr(&schema, col_idx));
+  }
+  uint32_t free_space_pointer = GetFreeSpacePointer();
+  if (free_space_pointer - layout.GetMinipagesEnd() < varlen_size) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+    const auto &col = schema.GetColumn(i);
+    uint32_t width = layout.GetWidth(i);
+    char *value = GetData() + layout.GetMinipageOffset(i) + row * width;
+    if (col.IsInlined()) {
+      memcpy(value, tuple.GetData() + col.GetOffset(), width);
+    } else {
+      const char *varlen = tuple.GetDataPtr(&schema, i);
+      uint32_t size = VarlenSize(varlen);
+      free_space_pointer -= size;
+      memcpy(GetData() + free_space_pointer, varlen, size);
+      memcpy(value, &free_space_pointer, sizeof(uint32_t));
+    }
+  }
+  GetData()[HEADER_SIZE + row] = 0;
+  SetFreeSpacePointer(free_space_pointer);
+  SetNumRows(row + 1);
+  SetNumLiveRows(GetNumLiveRows() + 1);
+  rid->Set(GetPaxPageId(), row);
+  return true;
+}
+
+bool PaxPage::ApplyDelete(const RID &rid) {
+  uint32_t row = rid.GetSlotNum();
+  if (row >= GetNumRows() || IsDeleted(row)) {
+    return false;
+  }
+  GetData()[HEADER_SIZE + row] = 1;
+  SetNumLiveRows(GetNumLiveRows() - 1);
+  return true;
+}
+
+bool PaxPage::GetTuple(const PaxLayout &layout, const RID &rid, Tuple *tuple) {
+  uint32_t row = rid.GetSlotNum();
+  if (row >= GetNumRows() || IsDeleted(row)) {
+    return false;
+  }
+  AssembleTuples(layout, {row}, tuple);
+  return true;
+}
+
+void PaxPage::GetTuples(const PaxLayout &layout, std::vector<Tuple> *tuples) {
+  std::vector<uint32_t> rows;
+  rows.reserve(GetNumLiveRows());
+  for (uint32_t row = 0; row < GetNumRows(); row++) {
+    if (!IsDeleted(row)) {
+      rows.push_back(row);
+    }
+  }
+  size_t first = tuples->size();
+  tuples->resize(first + rows.size());
+  AssembleTuples(layout, rows, tuples->data() + first);
+}
+
+void PaxPage::AssembleTuples(const PaxLayout &layout, const std::vector<uint32_t> &rows, Tuple *tuples) {
+  const Schema &schema = layout.GetSchema();
+  // the size of every tuple is its inlined part plus its varlen values
+  std::vector<uint32_t> sizes(rows.size(), schema.GetLength());
+  for (uint32_t col_idx : schema.GetUnlinedColumns()) {
+    const char *minipage = GetMinipage(layout, col_idx);
+    for (size_t i = 0; i < rows.size(); i++) {
+      uint32_t offset = *reinterpret_cast<const uint32_t *>(minipage + rows[i] * sizeof(uint32_t));
+      sizes[i] += VarlenSize(GetData() + offset);
+    }
+  }
+  for (size_t i = 0; i < rows.size(); i++) {
+    Tuple &tuple = tuples[i];
+    if (tuple.allocated_) {
+      delete[] tuple.data_;
+    }
+    tuple.rid_ = RID(GetPaxPageId(), rows[i]);
+    tuple.size_ = sizes[i];
+    tuple.data_ = new char[tuple.size_];
+    tuple.allocated_ = true;
+    // from now on the end of the varlen values written so far
+    sizes[i] = schema.GetLength();
+  }
+
+  for (uint32_t col_idx = 0; col_idx < schema.GetColumnCount(); col_idx++) {
+    const auto &col = schema.GetColumn(col_idx);
+    const char *minipage = GetMinipage(layout, col_idx);
+    uint32_t width = layout.GetWidth(col_idx);
+    if (col.IsInlined()) {
+      for (size_t i = 0; i < rows.size(); i++) {
+        memcpy(tuples[i].data_ + col.GetOffset(), minipage + rows[i] * width, width);
+      }
+      continue;
+    }
+    for (size_t i = 0; i < rows.size(); i++) {
+      const char *varlen = GetData() + *reinterpret_cast<const uint32_t *>(minipage + rows[i] * width);
+      uint32_t size = VarlenSize(varlen);
+      memcpy(tuples[i].data_ + sizes[i], varlen, size);
+      memcpy(tuples[i].data_ + col.GetOffset(), &sizes[i], sizeof(uint32_t));
+      sizes[i] += size;
+    }
+  }
+}
+
+}  // namespace bustub
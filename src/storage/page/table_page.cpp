@@ -12,7 +12,10 @@
 
 #include "storage/page/table_page.h"
 
+#include <algorithm>
 #include <cassert>
+#include <utility>
+#include <vector>
 
 namespace bustub {
 
@@ -32,43 +35,72 @@ void TablePage::Init(page_id_t page_id, uint32_t page_size, page_id_t prev_page_
   SetNextPageId(INVALID_PAGE_ID);
   SetFreeSpacePointer(page_size);
   SetTupleCount(0);
+  SetFreeSlotHead(INVALID_SLOT);
+  SetFragmentedBytes(0);
 }
 
-bool TablePage::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn, LockManager *lock_manager,
-                            LogManager *log_manager) {
-  BUSTUB_ASSERT(tuple.size_ > 0, "Cannot have empty tuples.");
-  // If there is not enough space, then return false.
-  if (GetFreeSpaceRemaining() < tuple.size_ + SIZE_TUPLE) {
+void TablePage::Compact() {
+  // Collect the tuples, including the ones marked as deleted, from the end of the page down.
+  std::vector<std::pair<uint32_t, uint32_t>> tuples;  // (offset, slot)
+  uint32_t tuple_bytes = 0;
+  for (uint32_t i = 0; i < GetTupleCount(); i++) {
+    uint32_t tuple_size = GetTupleSize(i);
+    if (tuple_size != 0) {
+      tuples.emplace_back(GetTupleOffsetAtSlot(i), i);
+      tuple_bytes += UnsetDeletedFlag(tuple_size);
+    }
+  }
+  std::sort(tuples.begin(), tuples.end(), std::greater<>());
+
+  // Slide every tuple up against the one after it. Tuples only move up, so moving the highest first never overwrites
+  // a tuple that has yet to move.
+  uint32_t free_space_pointer = GetFreeSpacePointer() + tuple_bytes + GetFragmentedBytes();
+  for (const auto &[tuple_offset, slot_num] : tuples) {
+    uint32_t tuple_size = UnsetDeletedFlag(GetTupleSize(slot_num));
+    free_space_pointer -= tuple_size;
+    memmove(GetData() + free_space_pointer, GetData() + tuple_offset, tuple_size);
+    SetTupleOffsetAtSlot(slot_num, free_space_pointer);
+  }
+  SetFreeSpacePointer(free_space_pointer);
+  SetFragmentedBytes(0);
+}
+
+bool TablePage::ClaimSpace(uint32_t tuple_size, uint32_t *slot_num, bool reuse_slot) {
+  bool is_reused = reuse_slot && GetFreeSlotHead() != INVALID_SLOT;
+  uint32_t needed = is_reused ? tuple_size : tuple_size + SIZE_TUPLE;
+  if (GetFreeSpaceRemaining() < needed) {
     return false;
   }
+  if (GetContiguousFreeSpace() < needed) {
+    Compact();
+  }
 
-  // Try to find a free slot to reuse.
-  uint32_t i;
-  for (i = 0; i < GetTupleCount(); i++) {
-    // If the slot is empty, i.e. its tuple has size 0,
-    if (GetTupleSize(i) == 0) {
-      // Then we break out of the loop at index i.
-      break;
-    }
+  if (is_reused) {
+    // Pop the first empty slot off the chain.
+    *slot_num = GetFreeSlotHead();
+    SetFreeSlotHead(GetTupleOffsetAtSlot(*slot_num));
+  } else {
+    *slot_num = GetTupleCount();
+    SetTupleCount(*slot_num + 1);
   }
+  SetFreeSpacePointer(GetFreeSpacePointer() - tuple_size);
+  SetTupleOffsetAtSlot(*slot_num, GetFreeSpacePointer());
+  return true;
+}
 
-  // If there was no free slot left, and we cannot claim it from the free space, then we give up.
-  if (i == GetTupleCount() && GetFreeSpaceRemaining() < tuple.size_ + SIZE_TUPLE) {
+bool TablePage::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn, LockManager *lock_manager,
+                            LogManager *log_manager) {
+  BUSTUB_ASSERT(tuple.size_ > 0, "Cannot have empty tuples.");
+  // Reuse an empty slot if there is one. If there is not enough space, then return false.
+  uint32_t i;
+  if (!ClaimSpace(tuple.size_, &i, true)) {
     return false;
   }
 
-  // Otherwise we claim available free space..
-  SetFreeSpacePointer(GetFreeSpacePointer() - tuple.size_);
-  memcpy(GetData() + GetFreeSpacePointer(), tuple.data_, tuple.size_);
-
   // Set the tuple.
-  SetTupleOffsetAtSlot(i, GetFreeSpacePointer());
+  memcpy(GetData() + GetFreeSpacePointer(), tuple.data_, tuple.size_);
   SetTupleSize(i, tuple.size_);
-
   rid->Set(GetTablePageId(), i);
-  if (i == GetTupleCount()) {
-    SetTupleCount(GetTupleCount() + 1);
-  }
 
   // Write the log record.
   if (enable_logging) {
@@ -84,6 +116,20 @@ bool TablePage::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn, Lock
   return true;
 }
 
+bool TablePage::AppendTuple(const Tuple &tuple, RID *rid) {
+  BUSTUB_ASSERT(tuple.size_ > 0, "Cannot have empty tuples.");
+  BUSTUB_ASSERT(!enable_logging, "Appended tuples are not logged.");
+  uint32_t slot_num;
+  if (!ClaimSpace(tuple.size_, &slot_num, false)) {
+    return false;
+  }
+
+  memcpy(GetData() + GetFreeSpacePointer(), tuple.data_, tuple.size_);
+  SetTupleSize(slot_num, tuple.size_);
+  rid->Set(GetTablePageId(), slot_num);
+  return true;
+}
+
 bool TablePage::MarkDelete(const RID &rid, Transaction *txn, LockManager *lock_manager, LogManager *log_manager) {
   uint32_t slot_num = rid.GetSlotNum();
   // If the slot number is invalid, abort the transaction.
@@ -149,6 +195,10 @@ bool TablePage::UpdateTuple(const Tuple &new_tuple, Tuple *old_tuple, const RID
   if (GetFreeSpaceRemaining() + tuple_size < new_tuple.size_) {
     return false;
   }
+  // A larger tuple takes contiguous space, reclaim the holes if there is not enough of it.
+  if (new_tuple.size_ > tuple_size && GetContiguousFreeSpace() < new_tuple.size_ - tuple_size) {
+    Compact();
+  }
 
   // Copy out the old value.
   uint32_t tuple_offset = GetTupleOffsetAtSlot(slot_num);
@@ -196,6 +246,51 @@ bool TablePage::UpdateTuple(const Tuple &new_tuple, Tuple *old_tuple, const RID
   return true;
 }
 
+bool TablePage::UpdateColumn(const Value &new_value, Value *old_value, const RID &rid, uint32_t column_offset,
+                             Transaction *txn, LockManager *lock_manager, LogManager *log_manager) {
+  uint32_t slot_num = rid.GetSlotNum();
+  // If the slot number is invalid, abort the transaction.
+  if (slot_num >= GetTupleCount()) {
+    if (enable_logging) {
+      txn->SetState(TransactionState::ABORTED);
+    }
+    return false;
+  }
+  uint32_t tuple_size = GetTupleSize(slot_num);
+  // If the tuple is deleted, abort the transaction.
+  if (IsDeleted(tuple_size)) {
+    if (enable_logging) {
+      txn->SetState(TransactionState::ABORTED);
+    }
+    return false;
+  }
+  BUSTUB_ASSERT(column_offset + Type::GetTypeSize(new_value.GetTypeId()) <= tuple_size, "The column is not inlined.");
+
+  // Copy out the old value.
+  char *column = GetData() + GetTupleOffsetAtSlot(slot_num) + column_offset;
+  *old_value = Value::DeserializeFrom(column, new_value.GetTypeId());
+
+  if (enable_logging) {
+    // Acquire an exclusive lock, upgrading from shared if necessary.
+    if (txn->IsSharedLocked(rid)) {
+      if (!lock_manager->LockUpgrade(txn, rid)) {
+        return false;
+      }
+    } else if (!txn->IsExclusiveLocked(rid) && !lock_manager->LockExclusive(txn, rid)) {
+      return false;
+    }
+    LogRecord log_record(txn->GetTransactionId(), txn->GetPrevLSN(), LogRecordType::UPDATECOLUMN, rid, column_offset,
+                         *old_value, new_value);
+    lsn_t lsn = log_manager->AppendLogRecord(&log_record);
+    SetLSN(lsn);
+    txn->SetPrevLSN(lsn);
+  }
+
+  // Perform the update.
+  new_value.SerializeTo(column);
+  return true;
+}
+
 void TablePage::ApplyDelete(const RID &rid, Transaction *txn, LogManager *log_manager) {
   uint32_t slot_num = rid.GetSlotNum();
   BUSTUB_ASSERT(slot_num < GetTupleCount(), "Cannot have more slots than tuples.");
@@ -228,19 +323,16 @@ void TablePage::ApplyDelete(const RID &rid, Transaction *txn, LogManager *log_ma
   uint32_t free_space_pointer = GetFreeSpacePointer();
   BUSTUB_ASSERT(tuple_offset >= free_space_pointer, "Free space appears before tuples.");
 
-  memmove(GetData() + free_space_pointer + tuple_size, GetData() + free_space_pointer,
-          tuple_offset - free_space_pointer);
-  SetFreeSpacePointer(free_space_pointer + tuple_size);
-  SetTupleSize(slot_num, 0);
-  SetTupleOffsetAtSlot(slot_num, 0);
-
-  // Update all tuple offsets.
-  for (uint32_t i = 0; i < GetTupleCount(); ++i) {
-    uint32_t tuple_offset_i = GetTupleOffsetAtSlot(i);
-    if (GetTupleSize(i) != 0 && tuple_offset_i < tuple_offset) {
-      SetTupleOffsetAtSlot(i, tuple_offset_i + tuple_size);
-    }
+  // The space of the lowest tuple joins the free space right away, any other tuple leaves a hole for Compact.
+  if (tuple_offset == free_space_pointer) {
+    SetFreeSpacePointer(free_space_pointer + tuple_size);
+  } else {
+    SetFragmentedBytes(GetFragmentedBytes() + tuple_size);
   }
+  // Push the slot onto the chain of empty slots.
+  SetTupleSize(slot_num, 0);
+  SetTupleOffsetAtSlot(slot_num, GetFreeSlotHead());
+  SetFreeSlotHead(slot_num);
 }
 
 void TablePage::RollbackDelete(const RID &rid, Transaction *txn, LogManager *log_manager) {
@@ -304,6 +396,36 @@ bool TablePage::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockMan
   return true;
 }
 
+bool TablePage::GetTupleView(const RID &rid, TupleView *view, Transaction *txn, LockManager *lock_manager) {
+  uint32_t slot_num = rid.GetSlotNum();
+  if (slot_num >= GetTupleCount()) {
+    return false;
+  }
+  uint32_t tuple_size = GetTupleSize(slot_num);
+  if (IsDeleted(tuple_size)) {
+    return false;
+  }
+
+  // Acquire at least a shared lock, as GetTuple does.
+  if (enable_logging) {
+    if (!txn->IsSharedLocked(rid) && !txn->IsExclusiveLocked(rid) && !lock_manager->LockShared(txn, rid)) {
+      return false;
+    }
+  }
+
+  *view = TupleView(rid, GetData() + GetTupleOffsetAtSlot(slot_num), tuple_size);
+  return true;
+}
+
+bool TablePage::GetRawTupleView(const RID &rid, TupleView *view) {
+  uint32_t slot_num = rid.GetSlotNum();
+  if (slot_num >= GetTupleCount() || GetTupleSize(slot_num) == 0) {
+    return false;
+  }
+  *view = TupleView(rid, GetData() + GetTupleOffsetAtSlot(slot_num), UnsetDeletedFlag(GetTupleSize(slot_num)));
+  return true;
+}
+
 bool TablePage::GetFirstTupleRid(RID *first_rid) {
   // Find and return the first valid tuple.
   for (uint32_t i = 0; i < GetTupleCount(); ++i) {
@@ -0,0 +1,142 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map.cpp
+//
+// Identification: src/storage/table/free_space_map.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/free_space_map.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace bustub {
+
+FreeSpaceMap::FreeSpaceMap(BufferPoolManager *buffer_pool_manager)
+    : buffer_pool_manager_(buffer_pool_manager), tree_(2 * num_leaves_, 0) {
+  page_id_t page_id;
+  Page *page = buffer_pool_manager_->NewPage(&page_id);
+  BUSTUB_ASSERT(page != nullptr, "Couldn't create a page for the free-space map.");
+  auto map_page = reinterpret_cast<FreeSpaceMapPage *>(page->GetData());
+  map_page->Init();
+  buffer_pool_manager_->UnpinPage(page_id, true);
+  map_page_ids_.push_back(page_id);
+}
+
+FreeSpaceMap::FreeSpaceMap(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id)
+    : buffer_pool_manager_(buffer_pool_manager), tree_(2 * num_leaves_, 0) {
+  for (page_id_t page_id = first_page_id; page_id != INVALID_PAGE_ID;) {
+    map_page_ids_.push_back(page_id);
+    auto map_page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+    for (uint32_t i = 0; i < map_page->GetNumEntries(); i++) {
+      AddLeaf(map_page->GetTablePageId(i), map_page->GetCategory(i));
+    }
+    page_id_t next_page_id = map_page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+}
+
+uint8_t FreeSpaceMap::ToCategory(uint32_t free_space) {
+  return static_cast<uint8_t>(std::min<uint32_t>(free_space / CATEGORY_SIZE, UINT8_MAX));
+}
+
+void FreeSpaceMap::AddLeaf(page_id_t table_page_id, uint8_t category) {
+  size_t idx = table_page_ids_.size();
+  if (idx == num_leaves_) {
+    // double the tree, the old leaves keep their order at the start of the new leaves
+    std::vector<uint8_t> tree(4 * num_leaves_, 0);
+    std::copy(tree_.begin() + num_leaves_, tree_.end(), tree.begin() + 2 * num_leaves_);
+    num_leaves_ *= 2;
+    for (size_t node = num_leaves_ - 1; node > 0; node--) {
+      tree[node] = std::max(tree[2 * node], tree[2 * node + 1]);
+    }
+    tree_ = std::move(tree);
+  }
+  table_page_ids_.push_back(table_page_id);
+  positions_[table_page_id] = idx;
+  for (size_t node = num_leaves_ + idx; node > 0; node /= 2) {
+    tree_[node] = std::max(tree_[node], category);
+  }
+}
+
+void FreeSpaceMap::SetCategory(size_t idx, uint8_t category) {
+  size_t node = num_leaves_ + idx;
+  if (tree_[node] == category) {
+    return;
+  }
+  tree_[node] = category;
+  for (node /= 2; node > 0; node /= 2) {
+    tree_[node] = std::max(tree_[2 * node], tree_[2 * node + 1]);
+  }
+
+  page_id_t map_page_id = map_page_ids_[idx / FreeSpaceMapPage::CAPACITY];
+  auto map_page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->FetchPage(map_page_id)->GetData());
+  map_page->SetCategory(idx % FreeSpaceMapPage::CAPACITY, category);
+  buffer_pool_manager_->UnpinPage(map_page_id, true);
+}
+
+void FreeSpaceMap::AddPage(page_id_t table_page_id, uint32_t free_space) {
+  std::scoped_lock lock(latch_);
+  uint8_t category = ToCategory(free_space);
+  page_id_t map_page_id = map_page_ids_.back();
+  auto map_page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->FetchPage(map_page_id)->GetData());
+  if (!map_page->Append(table_page_id, category)) {
+    // the last map page is full, chain a new one
+    page_id_t new_page_id;
+    Page *page = buffer_pool_manager_->NewPage(&new_page_id);
+    BUSTUB_ASSERT(page != nullptr, "Couldn't create a page for the free-space map.");
+    auto new_page = reinterpret_cast<FreeSpaceMapPage *>(page->GetData());
+    new_page->Init();
+    new_page->Append(table_page_id, category);
+    buffer_pool_manager_->UnpinPage(new_page_id, true);
+    map_page->SetNextPageId(new_page_id);
+    map_page_ids_.push_back(new_page_id);
+  }
+  buffer_pool_manager_->UnpinPage(map_page_id, true);
+  AddLeaf(table_page_id, category);
+}
+
+void FreeSpaceMap::UpdatePage(page_id_t table_page_id, uint32_t free_space) {
+  std::scoped_lock lock(latch_);
+  auto position = positions_.find(table_page_id);
+  BUSTUB_ASSERT(position != positions_.end(), "The page is not in the free-space map.");
+  SetCategory(position->second, ToCategory(free_space));
+}
+
+page_id_t FreeSpaceMap::FindPage(uint32_t space) {
+  // the smallest category that guarantees the space
+  uint32_t needed = (space + CATEGORY_SIZE - 1) / CATEGORY_SIZE;
+  std::scoped_lock lock(latch_);
+  if (tree_[1] < needed) {
+    return INVALID_PAGE_ID;
+  }
+  // descend to the leftmost leaf with room
+  size_t node = 1;
+  while (node < num_leaves_) {
+    node = tree_[2 * node] >= needed ? 2 * node : 2 * node + 1;
+  }
+  return table_page_ids_[node - num_leaves_];
+}
+
+page_id_t FreeSpaceMap::GetLastPageId() {
+  std::scoped_lock lock(latch_);
+  return table_page_ids_.empty() ? INVALID_PAGE_ID : table_page_ids_.back();
+}
+
+size_t FreeSpaceMap::GetNumPages() {
+  std::scoped_lock lock(latch_);
+  return table_page_ids_.size();
+}
+
+std::vector<page_id_t> FreeSpaceMap::GetPageIds() {
+  std::scoped_lock lock(latch_);
+  return table_page_ids_;
+}
+
+}  // namespace bustub
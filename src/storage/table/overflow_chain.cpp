@@ -0,0 +1,135 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// overflow_chain.cpp
+//
+// Identification: src/storage/table/overflow_chain.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/macros.h"
+#include "storage/page/overflow_page.h"
+#include "storage/table/overflow_chain.h"
+
+namespace bustub {
+
+VarlenReader::VarlenReader(const char *varlen, BufferPoolManager *overflow_pool) : overflow_pool_(overflow_pool) {
+  uint32_t len = *reinterpret_cast<const uint32_t *>(varlen);
+  if (len == BUSTUB_VALUE_NULL) {
+    is_null_ = true;
+  } else if ((len & OVERFLOW_FLAG) != 0) {
+    BUSTUB_ASSERT(overflow_pool_ != nullptr, "Reading a value stored out of line needs its buffer pool.");
+    length_ = len & ~OVERFLOW_FLAG;
+    first_page_id_ = *reinterpret_cast<const page_id_t *>(varlen + sizeof(uint32_t));
+    page_id_ = first_page_id_;
+  } else {
+    length_ = len;
+    inline_data_ = varlen + sizeof(uint32_t);
+  }
+}
+
+uint32_t VarlenReader::Read(char *buffer, uint32_t size) {
+  size = std::min(size, length_ - position_);
+  if (inline_data_ != nullptr) {
+    memcpy(buffer, inline_data_ + position_, size);
+    position_ += size;
+    return size;
+  }
+
+  uint32_t num_read = 0;
+  while (num_read < size) {
+    BUSTUB_ASSERT(page_id_ != INVALID_PAGE_ID, "The overflow chain is shorter than its value.");
+    Page *page = overflow_pool_->FetchPage(page_id_);
+    BUSTUB_ASSERT(page != nullptr, "Couldn't fetch an overflow page.");
+    page->RLatch();
+    auto overflow_page = reinterpret_cast<const OverflowPage *>(page->GetData());
+    uint32_t piece = std::min(size - num_read, overflow_page->GetDataSize() - page_offset_);
+    memcpy(buffer + num_read, overflow_page->GetData() + page_offset_, piece);
+    num_read += piece;
+    page_offset_ += piece;
+    page_id_t page_id = page_id_;
+    if (page_offset_ == overflow_page->GetDataSize()) {
+      // this page is used up, the next read starts on the next one
+      page_id_ = overflow_page->GetNextPageId();
+      page_offset_ = 0;
+    }
+    page->RUnlatch();
+    overflow_pool_->UnpinPage(page_id, false);
+  }
+  position_ += num_read;
+  return num_read;
+}
+
+int VarlenReader::Compare(VarlenReader *lhs, VarlenReader *rhs) {
+  BUSTUB_ASSERT(!lhs->IsNull() && !rhs->IsNull(), "Null values do not compare.");
+  // the terminating '\0' is not compared
+  uint32_t lhs_length = lhs->GetLength() - 1;
+  uint32_t rhs_length = rhs->GetLength() - 1;
+  uint32_t common_length = std::min(lhs_length, rhs_length);
+  char lhs_chunk[1024];
+  char rhs_chunk[sizeof(lhs_chunk)];
+  for (uint32_t num_compared = 0; num_compared < common_length;) {
+    uint32_t size = std::min(static_cast<uint32_t>(sizeof(lhs_chunk)), common_length - num_compared);
+    lhs->Read(lhs_chunk, size);
+    rhs->Read(rhs_chunk, size);
+    int cmp = memcmp(lhs_chunk, rhs_chunk, size);
+    if (cmp != 0) {
+      return cmp;
+    }
+    num_compared += size;
+  }
+  return lhs_length < rhs_length ? -1 : (lhs_length > rhs_length ? 1 : 0);
+}
+
+page_id_t OverflowChain::Write(BufferPoolManager *buffer_pool_manager, VarlenReader *reader) {
+  page_id_t first_page_id = INVALID_PAGE_ID;
+  // The previous page stays pinned until the next one is linked to it.
+  OverflowPage *prev_page = nullptr;
+  page_id_t prev_page_id = INVALID_PAGE_ID;
+  uint32_t num_written = 0;
+  do {
+    page_id_t page_id;
+    Page *page = buffer_pool_manager->NewPage(&page_id);
+    if (page == nullptr) {
+      if (prev_page != nullptr) {
+        buffer_pool_manager->UnpinPage(prev_page_id, true);
+        Free(buffer_pool_manager, first_page_id);
+      }
+      return INVALID_PAGE_ID;
+    }
+    // Nobody knows about the chain before it is written, so its pages need no latches.
+    auto overflow_page = reinterpret_cast<OverflowPage *>(page->GetData());
+    overflow_page->Init();
+    overflow_page->SetDataSize(reader->Read(overflow_page->GetData(), OverflowPage::CAPACITY));
+    num_written += overflow_page->GetDataSize();
+    if (prev_page == nullptr) {
+      first_page_id = page_id;
+    } else {
+      prev_page->SetNextPageId(page_id);
+      buffer_pool_manager->UnpinPage(prev_page_id, true);
+    }
+    prev_page = overflow_page;
+    prev_page_id = page_id;
+  } while (num_written < reader->GetLength());
+  buffer_pool_manager->UnpinPage(prev_page_id, true);
+  return first_page_id;
+}
+
+void OverflowChain::Free(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id) {
+  for (page_id_t page_id = first_page_id; page_id != INVALID_PAGE_ID;) {
+    Page *page = buffer_pool_manager->FetchPage(page_id);
+    BUSTUB_ASSERT(page != nullptr, "Couldn't fetch an overflow page.");
+    page_id_t next_page_id = reinterpret_cast<const OverflowPage *>(page->GetData())->GetNextPageId();
+    buffer_pool_manager->UnpinPage(page_id, false);
+    buffer_pool_manager->DeletePage(page_id);
+    page_id = next_page_id;
+  }
+}
+
+}  // namespace bustub
@@ -0,0 +1,47 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// pax_scan_iterator.cpp
+//
+// Identification: src/storage/table/pax_scan_iterator.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/pax_scan_iterator.h"
+
+namespace bustub {
+
+PaxScanIterator::PaxScanIterator(PaxTableHeap *table_heap)
+    : table_heap_(table_heap), next_page_id_(table_heap->GetFirstPageId()) {}
+
+bool PaxScanIterator::NextPage() {
+  BufferPoolManager *buffer_pool_manager = table_heap_->GetBufferPoolManager();
+  while (next_page_id_ != INVALID_PAGE_ID) {
+    ReleasePage();
+    page_ = static_cast<PaxPage *>(buffer_pool_manager->FetchPage(next_page_id_));
+    if (page_ == nullptr) {
+      next_page_id_ = INVALID_PAGE_ID;
+      return false;
+    }
+    page_->RLatch();
+    next_page_id_ = page_->GetNextPageId();
+    if (page_->GetNumLiveRows() > 0) {
+      return true;
+    }
+  }
+  ReleasePage();
+  return false;
+}
+
+void PaxScanIterator::ReleasePage() {
+  if (page_ != nullptr) {
+    page_->RUnlatch();
+    table_heap_->GetBufferPoolManager()->UnpinPage(page_->GetPaxPageId(), false);
+    page_ = nullptr;
+  }
+}
+
+}  // namespace bustub
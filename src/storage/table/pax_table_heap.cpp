@@ -0,0 +1,127 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// pax_table_heap.cpp
+//
+// Identification: src/storage/table/pax_table_heap.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/pax_table_heap.h"
+
+#include "common/macros.h"
+
+namespace bustub {
+
+PaxTableHeap::PaxTableHeap(BufferPoolManager *buffer_pool_manager, const Schema &schema,
+                           [[maybe_unused]] Transaction *txn)
+    : buffer_pool_manager_(buffer_pool_manager), layout_(schema) {
+  BUSTUB_ASSERT(layout_.GetCapacity() > 0, "A row of the schema does not fit into a PAX page.");
+  auto first_page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->NewPage(&first_page_id_));
+  BUSTUB_ASSERT(first_page != nullptr, "Couldn't create a page for the table heap.");
+  first_page->WLatch();
+  first_page->Init(first_page_id_);
+  first_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(first_page_id_, true);
+  last_page_id_ = first_page_id_;
+}
+
+bool PaxTableHeap::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) {
+  std::scoped_lock lock(append_latch_);
+  auto last_page = static_cast<PaxPage *>(buffer_pool_manager_->FetchPage(last_page_id_));
+  if (last_page == nullptr) {
+    txn->SetState(TransactionState::ABORTED);
+    return false;
+  }
+  last_page->WLatch();
+  bool is_inserted = AppendTuple(&last_page, tuple, rid);
+  last_page_id_ = last_page->GetPaxPageId();
+  last_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(last_page_id_, true);
+  return is_inserted;
+}
+
+bool PaxTableHeap::BulkInsert(const std::vector<Tuple> &tuples, std::vector<RID> *rids, Transaction *txn) {
+  std::scoped_lock lock(append_latch_);
+  auto last_page = static_cast<PaxPage *>(buffer_pool_manager_->FetchPage(last_page_id_));
+  if (last_page == nullptr) {
+    txn->SetState(TransactionState::ABORTED);
+    return false;
+  }
+  last_page->WLatch();
+  bool all_inserted = true;
+  rids->reserve(rids->size() + tuples.size());
+  for (const auto &tuple : tuples) {
+    RID rid;
+    if (!AppendTuple(&last_page, tuple, &rid)) {
+      all_inserted = false;
+      break;
+    }
+    rids->push_back(rid);
+  }
+  last_page_id_ = last_page->GetPaxPageId();
+  last_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(last_page_id_, true);
+  return all_inserted;
+}
+
+bool PaxTableHeap::AppendTuple(PaxPage **last_page, const Tuple &tuple, RID *rid) {
+  if ((*last_page)->InsertTuple(layout_, tuple, rid)) {
+    return true;
+  }
+  // a tuple that does not fit into an empty page never will
+  if ((*last_page)->GetNumRows() == 0) {
+    return false;
+  }
+  PaxPage *new_page = AppendPage(*last_page);
+  if (new_page == nullptr) {
+    return false;
+  }
+  *last_page = new_page;
+  return new_page->InsertTuple(layout_, tuple, rid);
+}
+
+PaxPage *PaxTableHeap::AppendPage(PaxPage *last_page) {
+  page_id_t page_id;
+  auto new_page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->NewPage(&page_id));
+  if (new_page == nullptr) {
+    return nullptr;
+  }
+  new_page->WLatch();
+  new_page->Init(page_id);
+  last_page->SetNextPageId(page_id);
+  last_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(last_page->GetPaxPageId(), true);
+  return new_page;
+}
+
+bool PaxTableHeap::ApplyDelete(const RID &rid, Transaction *txn) {
+  auto page = static_cast<PaxPage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  if (page == nullptr) {
+    txn->SetState(TransactionState::ABORTED);
+    return false;
+  }
+  page->WLatch();
+  bool is_deleted = page->ApplyDelete(rid);
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(rid.GetPageId(), is_deleted);
+  return is_deleted;
+}
+
+bool PaxTableHeap::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn) {
+  auto page = static_cast<PaxPage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  if (page == nullptr) {
+    txn->SetState(TransactionState::ABORTED);
+    return false;
+  }
+  page->RLatch();
+  bool res = page->GetTuple(layout_, rid, tuple);
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(rid.GetPageId(), false);
+  return res;
+}
+
+}  // namespace bustub
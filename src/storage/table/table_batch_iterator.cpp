@@ -0,0 +1,68 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_batch_iterator.cpp
+//
+// Identification: src/storage/table/table_batch_iterator.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/table_batch_iterator.h"
+
+#include <utility>
+
+#include "storage/table/table_heap.h"
+
+namespace bustub {
+
+TableBatchIterator::TableBatchIterator(TableHeap *table_heap, Transaction *txn)
+    : table_heap_(table_heap),
+      txn_(txn),
+      next_page_id_(table_heap->GetFirstPageId()) {}
+
+TableBatchIterator::TableBatchIterator(TableHeap *table_heap, std::vector<page_id_t> page_ids, Transaction *txn)
+    : table_heap_(table_heap),
+      txn_(txn),
+      use_page_ids_(true),
+      page_ids_(std::move(page_ids)),
+      next_page_id_(page_ids_.empty() ? INVALID_PAGE_ID : page_ids_[0]) {}
+
+bool TableBatchIterator::NextBatch(std::vector<TupleView> *batch) {
+  batch->clear();
+  while (next_page_id_ != INVALID_PAGE_ID) {
+    // drop the previous page before latching the next one, so the scan never holds two latches
+    guard_.Release();
+    guard_ = table_heap_->ReadPage(next_page_id_);
+    TablePage *page = guard_.GetPage();
+    // If the page could not be fetched, then abort the transaction, so the caller does not take it for the end.
+    if (page == nullptr) {
+      next_page_id_ = INVALID_PAGE_ID;
+      txn_->SetState(TransactionState::ABORTED);
+      return false;
+    }
+    num_pages_read_++;
+    if (use_page_ids_) {
+      next_page_id_ = ++page_idx_ < page_ids_.size() ? page_ids_[page_idx_] : INVALID_PAGE_ID;
+    } else {
+      next_page_id_ = page->GetNextPageId();
+    }
+
+    RID rid;
+    for (bool has_next = page->GetFirstTupleRid(&rid); has_next; has_next = page->GetNextTupleRid(rid, &rid)) {
+      TupleView view;
+      if (table_heap_->GetTupleView(guard_, rid, &view, txn_)) {
+        batch->push_back(std::move(view));
+      }
+    }
+    if (!batch->empty()) {
+      return true;
+    }
+  }
+  guard_.Release();
+  return false;
+}
+
+}  // namespace bustub
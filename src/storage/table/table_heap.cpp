@@ -10,7 +10,11 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <numeric>
+#include <utility>
 
 #include "common/logger.h"
 #include "storage/table/table_heap.h"
@@ -18,11 +22,28 @@
 namespace bustub {
 
 TableHeap::TableHeap(BufferPoolManager *buffer_pool_manager, LockManager *lock_manager, LogManager *log_manager,
-                     page_id_t first_page_id)
+                     page_id_t first_page_id, page_id_t free_space_map_page_id)
     : buffer_pool_manager_(buffer_pool_manager),
       lock_manager_(lock_manager),
       log_manager_(log_manager),
-      first_page_id_(first_page_id) {}
+      first_page_id_(first_page_id) {
+  if (free_space_map_page_id != INVALID_PAGE_ID) {
+    free_space_map_ = std::make_unique<FreeSpaceMap>(buffer_pool_manager_, free_space_map_page_id);
+    return;
+  }
+  // No map was kept for this table, rebuild it from the page chain.
+  free_space_map_ = std::make_unique<FreeSpaceMap>(buffer_pool_manager_);
+  for (page_id_t page_id = first_page_id_; page_id != INVALID_PAGE_ID;) {
+    auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    BUSTUB_ASSERT(page != nullptr, "Couldn't fetch a page of the table heap.");
+    page->RLatch();
+    free_space_map_->AddPage(page_id, page->GetFreeSpaceRemaining());
+    page_id_t next_page_id = page->GetNextPageId();
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+}
 
 TableHeap::TableHeap(BufferPoolManager *buffer_pool_manager, LockManager *lock_manager, LogManager *log_manager,
                      Transaction *txn)
@@ -32,64 +53,197 @@ TableHeap::TableHeap(BufferPoolManager *buffer_pool_manager, LockManager *lock_m
   BUSTUB_ASSERT(first_page != nullptr, "Couldn't create a page for the table heap.");
   first_page->WLatch();
   first_page->Init(first_page_id_, PAGE_SIZE, INVALID_LSN, log_manager_, txn);
+  uint32_t free_space = first_page->GetFreeSpaceRemaining();
   first_page->WUnlatch();
   buffer_pool_manager_->UnpinPage(first_page_id_, true);
+
+  free_space_map_ = std::make_unique<FreeSpaceMap>(buffer_pool_manager_);
+  free_space_map_->AddPage(first_page_id_, free_space);
 }
 
 bool TableHeap::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) {
-  if (tuple.size_ + 32 > PAGE_SIZE) {  // larger than one page size
+  // Move the large values out of line first, so the tuple is checked and stored the way it ends up in the page.
+  Tuple out_of_line;
+  bool is_moved = NeedsOverflow(tuple);
+  if (is_moved && !MoveOutOfLine(tuple, &out_of_line)) {
     txn->SetState(TransactionState::ABORTED);
     return false;
   }
-
-  auto cur_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(first_page_id_));
-  if (cur_page == nullptr) {
+  const Tuple &stored = is_moved ? out_of_line : tuple;
+  // Aborts the insert, without leaving the overflow chains of the tuple behind.
+  auto abort_insert = [&]() {
+    if (is_moved) {
+      FreeOverflow(stored);
+    }
     txn->SetState(TransactionState::ABORTED);
     return false;
+  };
+
+  if (stored.size_ > TablePage::MaxTupleSize()) {  // larger than one page size
+    return abort_insert();
   }
 
-  cur_page->WLatch();
-  // Insert into the first page with enough space. If no such page exists, create a new page and insert into that.
-  // INVARIANT: cur_page is WLatched if you leave the loop normally.
-  while (!cur_page->InsertTuple(tuple, rid, txn, lock_manager_, log_manager_)) {
-    auto next_page_id = cur_page->GetNextPageId();
-    // If the next page is a valid page,
-    if (next_page_id != INVALID_PAGE_ID) {
-      // Unlatch and unpin the current page.
-      cur_page->WUnlatch();
-      buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), false);
-      // And repeat the process with the next page.
-      cur_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(next_page_id));
-      cur_page->WLatch();
-    } else {
-      // Otherwise we have run out of valid pages. We need to create a new page.
-      auto new_page = static_cast<TablePage *>(buffer_pool_manager_->NewPage(&next_page_id));
-      // If we could not create a new page,
-      if (new_page == nullptr) {
-        // Then life sucks and we abort the transaction.
-        cur_page->WUnlatch();
-        buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), false);
-        txn->SetState(TransactionState::ABORTED);
-        return false;
+  // Ask the free-space map for a page with room, and append a page when there is none. The map is only a hint, so
+  // if the page filled up in the meantime, record its actual free space and ask again.
+  uint32_t space = TablePage::SpaceForTuple(stored.size_);
+  while (true) {
+    page_id_t page_id = free_space_map_->FindPage(space);
+    if (page_id == INVALID_PAGE_ID) {
+      page_id = AppendPage(space, txn);
+      // If we could not create a new page, then life sucks and we abort the transaction.
+      if (page_id == INVALID_PAGE_ID) {
+        return abort_insert();
       }
-      // Otherwise we were able to create a new page. We initialize it now.
-      new_page->WLatch();
-      cur_page->SetNextPageId(next_page_id);
-      new_page->Init(next_page_id, PAGE_SIZE, cur_page->GetTablePageId(), log_manager_, txn);
-      cur_page->WUnlatch();
-      buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), true);
-      cur_page = new_page;
-    }
-  }
-  // This line has caused most of us to double-take and "whoa double unlatch".
-  // We are not, in fact, double unlatching. See the invariant above.
-  cur_page->WUnlatch();
-  buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), true);
+    }
+    auto cur_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    if (cur_page == nullptr) {
+      return abort_insert();
+    }
+
+    cur_page->WLatch();
+    bool is_inserted = cur_page->InsertTuple(stored, rid, txn, lock_manager_, log_manager_);
+    if (is_inserted && zone_map_ != nullptr) {
+      zone_map_->Insert(page_id, stored);
+    }
+    uint32_t free_space = cur_page->GetFreeSpaceRemaining();
+    cur_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, is_inserted);
+    free_space_map_->UpdatePage(page_id, free_space);
+    if (is_inserted) {
+      break;
+    }
+  }
   // Update the transaction's write set.
   txn->GetWriteSet()->emplace_back(*rid, WType::INSERT, Tuple{}, this);
   return true;
 }
 
+page_id_t TableHeap::AppendPage(uint32_t space, Transaction *txn) {
+  std::scoped_lock lock(append_latch_);
+  // Another insert may have appended a page while we waited.
+  page_id_t page_id = free_space_map_->FindPage(space);
+  if (page_id != INVALID_PAGE_ID) {
+    return page_id;
+  }
+
+  page_id_t last_page_id = free_space_map_->GetLastPageId();
+  auto last_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(last_page_id));
+  if (last_page == nullptr) {
+    return INVALID_PAGE_ID;
+  }
+  last_page->WLatch();
+  TablePage *new_page = LinkNewPage(last_page, txn);
+  last_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(last_page_id, new_page != nullptr);
+  // If we could not create a new page, then life sucks and the insert aborts.
+  if (new_page == nullptr) {
+    return INVALID_PAGE_ID;
+  }
+  page_id = new_page->GetTablePageId();
+  uint32_t free_space = new_page->GetFreeSpaceRemaining();
+  new_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, true);
+  free_space_map_->AddPage(page_id, free_space);
+  return page_id;
+}
+
+TablePage *TableHeap::LinkNewPage(TablePage *last_page, Transaction *txn) {
+  page_id_t page_id;
+  auto new_page = static_cast<TablePage *>(buffer_pool_manager_->NewPage(&page_id));
+  if (new_page == nullptr) {
+    return nullptr;
+  }
+  new_page->WLatch();
+  last_page->SetNextPageId(page_id);
+  new_page->Init(page_id, PAGE_SIZE, last_page->GetTablePageId(), log_manager_, txn);
+  if (zone_map_ != nullptr) {
+    zone_map_->AddPage(page_id);
+  }
+  return new_page;
+}
+
+bool TableHeap::BulkInsert(const std::vector<Tuple> &tuples, std::vector<RID> *rids, Transaction *txn) {
+  // Move the large values out of line first, so the tuples are checked and stored the way they end up in the pages.
+  std::vector<Tuple> out_of_line;
+  if (std::any_of(tuples.begin(), tuples.end(), [this](const Tuple &tuple) { return NeedsOverflow(tuple); })) {
+    out_of_line.reserve(tuples.size());
+    for (const auto &tuple : tuples) {
+      if (!NeedsOverflow(tuple)) {
+        out_of_line.push_back(tuple);
+        continue;
+      }
+      Tuple stored;
+      if (!MoveOutOfLine(tuple, &stored)) {
+        for (const auto &moved : out_of_line) {
+          FreeOverflow(moved);
+        }
+        txn->SetState(TransactionState::ABORTED);
+        return false;
+      }
+      out_of_line.push_back(std::move(stored));
+    }
+  }
+  const std::vector<Tuple> &stored_tuples = out_of_line.empty() ? tuples : out_of_line;
+  // Aborts the insert, without leaving the overflow chains of the tuples from the first one not inserted behind.
+  auto abort_insert = [&](size_t first_not_inserted) {
+    for (size_t i = first_not_inserted; i < out_of_line.size(); i++) {
+      FreeOverflow(out_of_line[i]);
+    }
+    txn->SetState(TransactionState::ABORTED);
+    return false;
+  };
+
+  for (const auto &tuple : stored_tuples) {
+    if (tuple.size_ > TablePage::MaxTupleSize()) {  // larger than one page size
+      return abort_insert(0);
+    }
+  }
+
+  // Holding the append latch keeps the tail of the table where it is until we are done.
+  std::scoped_lock lock(append_latch_);
+  auto tail_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(free_space_map_->GetLastPageId()));
+  if (tail_page == nullptr) {
+    return abort_insert(0);
+  }
+  tail_page->WLatch();
+
+  // Releases the tail page, recording how much room it has left.
+  auto release_tail = [&](TablePage *page) {
+    page_id_t page_id = page->GetTablePageId();
+    uint32_t free_space = page->GetFreeSpaceRemaining();
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    free_space_map_->UpdatePage(page_id, free_space);
+  };
+
+  rids->reserve(rids->size() + stored_tuples.size());
+  for (size_t i = 0; i < stored_tuples.size(); i++) {
+    const Tuple &tuple = stored_tuples[i];
+    RID rid;
+    // Logged inserts go through InsertTuple, which also locks the new tuple.
+    while (enable_logging ? !tail_page->InsertTuple(tuple, &rid, txn, lock_manager_, log_manager_)
+                          : !tail_page->AppendTuple(tuple, &rid)) {
+      // The tail page is full, move on to a new one.
+      TablePage *new_page = LinkNewPage(tail_page, txn);
+      if (new_page == nullptr) {
+        release_tail(tail_page);
+        return abort_insert(i);
+      }
+      release_tail(tail_page);
+      free_space_map_->AddPage(new_page->GetTablePageId(), new_page->GetFreeSpaceRemaining());
+      tail_page = new_page;
+    }
+    if (zone_map_ != nullptr) {
+      zone_map_->Insert(rid.GetPageId(), tuple);
+    }
+    rids->push_back(rid);
+    // Update the transaction's write set.
+    txn->GetWriteSet()->emplace_back(rid, WType::INSERT, Tuple{}, this);
+  }
+  release_tail(tail_page);
+  return true;
+}
+
 bool TableHeap::MarkDelete(const RID &rid, Transaction *txn) {
   // TODO(Amadou): remove empty page
   // Find the page which contains the tuple.
@@ -110,19 +264,39 @@ bool TableHeap::MarkDelete(const RID &rid, Transaction *txn) {
 }
 
 bool TableHeap::UpdateTuple(const Tuple &tuple, const RID &rid, Transaction *txn) {
+  // Move the large values out of line first, so the new tuple is stored the way it ends up in the page.
+  Tuple out_of_line;
+  bool is_moved = NeedsOverflow(tuple);
+  if (is_moved && !MoveOutOfLine(tuple, &out_of_line)) {
+    txn->SetState(TransactionState::ABORTED);
+    return false;
+  }
+  const Tuple &stored = is_moved ? out_of_line : tuple;
   // Find the page which contains the tuple.
   auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
   // If the page could not be found, then abort the transaction.
   if (page == nullptr) {
+    if (is_moved) {
+      FreeOverflow(stored);
+    }
     txn->SetState(TransactionState::ABORTED);
     return false;
   }
   // Update the tuple; but first save the old value for rollbacks.
   Tuple old_tuple;
   page->WLatch();
-  bool is_updated = page->UpdateTuple(tuple, &old_tuple, rid, txn, lock_manager_, log_manager_);
+  bool is_updated = page->UpdateTuple(stored, &old_tuple, rid, txn, lock_manager_, log_manager_);
+  if (is_updated && zone_map_ != nullptr) {
+    zone_map_->Update(rid.GetPageId(), stored);
+  }
+  uint32_t free_space = page->GetFreeSpaceRemaining();
   page->WUnlatch();
   buffer_pool_manager_->UnpinPage(page->GetTablePageId(), is_updated);
+  if (is_updated) {
+    free_space_map_->UpdatePage(rid.GetPageId(), free_space);
+  } else if (is_moved) {
+    FreeOverflow(stored);
+  }
   // Update the transaction's write set.
   if (is_updated && txn->GetState() != TransactionState::ABORTED) {
     txn->GetWriteSet()->emplace_back(rid, WType::UPDATE, old_tuple, this);
@@ -130,16 +304,95 @@ bool TableHeap::UpdateTuple(const Tuple &tuple, const RID &rid, Transaction *txn
   return is_updated;
 }
 
+void TableHeap::ApplyUpdate(const Tuple &old_tuple) {
+  if (overflow_schema_ != nullptr) {
+    FreeOverflow(old_tuple);
+  }
+}
+
+void TableHeap::RollbackUpdate(const Tuple &old_tuple, const RID &rid, Transaction *txn) {
+  // Find the page which contains the tuple.
+  auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  BUSTUB_ASSERT(page != nullptr, "Couldn't find a page containing that RID.");
+  // Put the old tuple back as is, so it keeps its chains; the zone map already covers it.
+  Tuple new_tuple;
+  page->WLatch();
+  bool is_updated = page->UpdateTuple(old_tuple, &new_tuple, rid, txn, lock_manager_, log_manager_);
+  uint32_t free_space = page->GetFreeSpaceRemaining();
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(rid.GetPageId(), is_updated);
+  if (is_updated) {
+    free_space_map_->UpdatePage(rid.GetPageId(), free_space);
+    if (overflow_schema_ != nullptr) {
+      FreeOverflow(new_tuple);
+    }
+  }
+}
+
+bool TableHeap::UpdateColumn(const Schema &schema, const RID &rid, uint32_t column_idx, const Value &value,
+                             Transaction *txn) {
+  const Column &column = schema.GetColumn(column_idx);
+  // Only fixed-width columns can be patched in place, and only with a value of their own type.
+  if (!column.IsInlined() || column.GetType() != value.GetTypeId()) {
+    return false;
+  }
+  // Find the page which contains the tuple.
+  auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  // If the page could not be found, then abort the transaction.
+  if (page == nullptr) {
+    txn->SetState(TransactionState::ABORTED);
+    return false;
+  }
+  // Patch the column; but first save the old value for rollbacks.
+  Value old_value;
+  page->WLatch();
+  bool is_updated =
+      page->UpdateColumn(value, &old_value, rid, column.GetOffset(), txn, lock_manager_, log_manager_);
+  if (is_updated && zone_map_ != nullptr) {
+    zone_map_->UpdateColumn(rid.GetPageId(), column_idx, value);
+  }
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(rid.GetPageId(), is_updated);
+  // Update the transaction's write set.
+  if (is_updated && txn->GetState() != TransactionState::ABORTED) {
+    txn->GetWriteSet()->emplace_back(rid, column.GetOffset(), old_value, this);
+  }
+  return is_updated;
+}
+
+void TableHeap::RollbackUpdateColumn(const RID &rid, uint32_t column_offset, const Value &old_value,
+                                     Transaction *txn) {
+  // Find the page which contains the tuple.
+  auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  BUSTUB_ASSERT(page != nullptr, "Couldn't find a page containing that RID.");
+  // Restore the column; the zone map already covers the old value.
+  Value new_value;
+  page->WLatch();
+  page->UpdateColumn(old_value, &new_value, rid, column_offset, txn, lock_manager_, log_manager_);
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(rid.GetPageId(), true);
+}
+
 void TableHeap::ApplyDelete(const RID &rid, Transaction *txn) {
   // Find the page which contains the tuple.
   auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
   BUSTUB_ASSERT(page != nullptr, "Couldn't find a page containing that RID.");
-  // Delete the tuple from the page.
+  // Delete the tuple from the page, and the values it stores out of line.
   page->WLatch();
+  TupleView view;
+  if (overflow_schema_ != nullptr && page->GetRawTupleView(rid, &view)) {
+    FreeOverflow(view.AsTuple());
+  }
   page->ApplyDelete(rid, txn, log_manager_);
+  if (zone_map_ != nullptr) {
+    zone_map_->Delete(rid.GetPageId());
+  }
   lock_manager_->Unlock(txn, rid);
+  // ApplyDelete leaves a hole, which GetFreeSpaceRemaining counts and the page compacts once an insert needs it.
+  uint32_t free_space = page->GetFreeSpaceRemaining();
   page->WUnlatch();
   buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
+  free_space_map_->UpdatePage(rid.GetPageId(), free_space);
 }
 
 void TableHeap::RollbackDelete(const RID &rid, Transaction *txn) {
@@ -153,6 +406,121 @@ void TableHeap::RollbackDelete(const RID &rid, Transaction *txn) {
   buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
 }
 
+void TableHeap::CreateZoneMap(const Schema &schema) {
+  auto zone_map = std::make_unique<ZoneMap>(schema);
+  for (page_id_t page_id = first_page_id_; page_id != INVALID_PAGE_ID;) {
+    auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    BUSTUB_ASSERT(page != nullptr, "Couldn't fetch a page of the table heap.");
+    page->RLatch();
+    zone_map->AddPage(page_id);
+    // tuples marked deleted count as well, their delete may still be rolled back
+    RID rid;
+    for (bool has_next = page->GetFirstTupleRid(&rid); has_next; has_next = page->GetNextTupleRid(rid, &rid)) {
+      TupleView view;
+      if (page->GetRawTupleView(rid, &view)) {
+        zone_map->Insert(page_id, view.AsTuple());
+      }
+    }
+    page_id_t next_page_id = page->GetNextPageId();
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+  zone_map_ = std::move(zone_map);
+}
+
+void TableHeap::EnableOverflow(const Schema &schema) { overflow_schema_ = std::make_unique<Schema>(schema); }
+
+bool TableHeap::NeedsOverflow(const Tuple &tuple) const {
+  if (overflow_schema_ == nullptr) {
+    return false;
+  }
+  if (tuple.size_ > OVERFLOW_TUPLE_THRESHOLD) {
+    return true;
+  }
+  const auto &varlen_columns = overflow_schema_->GetUnlinedColumns();
+  return std::any_of(varlen_columns.begin(), varlen_columns.end(), [&](uint32_t column_idx) {
+    return IsOverflowValue(tuple.GetDataPtr(overflow_schema_.get(), column_idx));
+  });
+}
+
+bool TableHeap::MoveOutOfLine(const Tuple &tuple, Tuple *stored) {
+  const Schema *schema = overflow_schema_.get();
+  const auto &varlen_columns = schema->GetUnlinedColumns();
+  std::vector<VarlenReader> readers;
+  readers.reserve(varlen_columns.size());
+  for (uint32_t column_idx : varlen_columns) {
+    readers.push_back(tuple.GetVarlenReader(schema, column_idx));
+  }
+
+  // Values that are out of line already stay out of line, in chains of their own. Then the largest values move out
+  // until the tuple is small enough; an out-of-line value leaves a pointer instead of its bytes behind.
+  std::vector<bool> is_out_of_line(readers.size());
+  uint32_t size = schema->GetLength();
+  for (size_t i = 0; i < readers.size(); i++) {
+    is_out_of_line[i] = readers[i].IsOverflow();
+    size += is_out_of_line[i] ? OVERFLOW_POINTER_SIZE : sizeof(uint32_t) + readers[i].GetLength();
+  }
+  std::vector<size_t> by_length(readers.size());
+  std::iota(by_length.begin(), by_length.end(), 0);
+  std::sort(by_length.begin(), by_length.end(),
+            [&readers](size_t a, size_t b) { return readers[a].GetLength() > readers[b].GetLength(); });
+  for (size_t i : by_length) {
+    if (size <= OVERFLOW_TUPLE_THRESHOLD || readers[i].GetLength() < OVERFLOW_VALUE_THRESHOLD) {
+      break;
+    }
+    if (!is_out_of_line[i]) {
+      is_out_of_line[i] = true;
+      size -= sizeof(uint32_t) + readers[i].GetLength() - OVERFLOW_POINTER_SIZE;
+    }
+  }
+
+  // Serialize the tuple the way Tuple(values, schema) does, with pointers in place of the out-of-line values.
+  Tuple result;
+  result.size_ = size;
+  result.data_ = new char[size];
+  result.allocated_ = true;
+  memcpy(result.data_, tuple.data_, schema->GetLength());
+  std::vector<page_id_t> chains;
+  uint32_t offset = schema->GetLength();
+  for (size_t i = 0; i < readers.size(); i++) {
+    char *data = result.data_ + offset;
+    *reinterpret_cast<uint32_t *>(result.data_ + schema->GetColumn(varlen_columns[i]).GetOffset()) = offset;
+    if (is_out_of_line[i]) {
+      page_id_t first_page_id = OverflowChain::Write(buffer_pool_manager_, &readers[i]);
+      if (first_page_id == INVALID_PAGE_ID) {
+        for (page_id_t chain : chains) {
+          OverflowChain::Free(buffer_pool_manager_, chain);
+        }
+        return false;
+      }
+      chains.push_back(first_page_id);
+      *reinterpret_cast<uint32_t *>(data) = readers[i].GetLength() | OVERFLOW_FLAG;
+      *reinterpret_cast<page_id_t *>(data + sizeof(uint32_t)) = first_page_id;
+      offset += OVERFLOW_POINTER_SIZE;
+    } else if (readers[i].IsNull()) {
+      *reinterpret_cast<uint32_t *>(data) = BUSTUB_VALUE_NULL;
+      offset += sizeof(uint32_t);
+    } else {
+      *reinterpret_cast<uint32_t *>(data) = readers[i].GetLength();
+      readers[i].Read(data + sizeof(uint32_t), readers[i].GetLength());
+      offset += sizeof(uint32_t) + readers[i].GetLength();
+    }
+  }
+  result.overflow_pool_ = buffer_pool_manager_;
+  *stored = std::move(result);
+  return true;
+}
+
+void TableHeap::FreeOverflow(const Tuple &stored) {
+  for (uint32_t column_idx : overflow_schema_->GetUnlinedColumns()) {
+    const char *varlen = stored.GetDataPtr(overflow_schema_.get(), column_idx);
+    if (IsOverflowValue(varlen)) {
+      OverflowChain::Free(buffer_pool_manager_, *reinterpret_cast<const page_id_t *>(varlen + sizeof(uint32_t)));
+    }
+  }
+}
+
 bool TableHeap::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn) {
   // Find the page which contains the tuple.
   auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
@@ -164,11 +532,27 @@ bool TableHeap::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn) {
   // Read the tuple from the page.
   page->RLatch();
   bool res = page->GetTuple(rid, tuple, txn, lock_manager_);
+  tuple->overflow_pool_ = buffer_pool_manager_;
   page->RUnlatch();
   buffer_pool_manager_->UnpinPage(rid.GetPageId(), false);
   return res;
 }
 
+std::vector<std::vector<page_id_t>> TableHeap::SplitPages(const std::vector<page_id_t> &page_ids,
+                                                          size_t num_ranges) {
+  std::vector<std::vector<page_id_t>> ranges;
+  num_ranges = std::min(num_ranges, page_ids.size());
+  ranges.reserve(num_ranges);
+  // The first page_ids.size() % num_ranges ranges get one page more than the rest.
+  auto begin = page_ids.begin();
+  for (size_t i = 0; i < num_ranges; i++) {
+    auto end = begin + page_ids.size() / num_ranges + (i < page_ids.size() % num_ranges ? 1 : 0);
+    ranges.emplace_back(begin, end);
+    begin = end;
+  }
+  return ranges;
+}
+
 TableIterator TableHeap::Begin(Transaction *txn) {
   // Start an iterator from the first page.
   auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(first_page_id_));
@@ -56,7 +56,9 @@ TableIterator &TableIterator::operator++() {
   tuple_->rid_ = next_tuple_rid;
 
   if (*this != table_heap_->End()) {
-    table_heap_->GetTuple(tuple_->rid_, tuple_, txn_);
+    // the next tuple is on the page that is already latched, read it from there instead of fetching it again
+    cur_page->GetTuple(tuple_->rid_, tuple_, txn_, table_heap_->lock_manager_);
+    tuple_->overflow_pool_ = buffer_pool_manager;
   }
   // release until copy the tuple
   cur_page->RUnlatch();
@@ -12,16 +12,19 @@
 
 #include <cassert>
 #include <cstdlib>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include "common/macros.h"
+#include "storage/table/overflow_chain.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 // TODO(Amadou): It does not look like nulls are supported. Add a null bitmap?
-Tuple::Tuple(std::vector<Value> values, const Schema *schema) : allocated_(true) {
+Tuple::Tuple(std::vector<Value> values, const Schema *schema, AbstractPool *pool) : allocated_(pool == nullptr) {
   assert(values.size() == schema->GetColumnCount());
 
   // 1. Calculate the size of the tuple.
@@ -32,7 +35,7 @@ Tuple::Tuple(std::vector<Value> values, const Schema *schema) : allocated_(true)
 
   // 2. Allocate memory.
   size_ = tuple_size;
-  data_ = new char[size_];
+  data_ = pool == nullptr ? new char[size_] : static_cast<char *>(pool->Allocate(size_));
   std::memset(data_, 0, size_);
 
   // 3. Serialize each attribute based on the input value.
@@ -53,49 +56,121 @@ Tuple::Tuple(std::vector<Value> values, const Schema *schema) : allocated_(true)
   }
 }
 
-Tuple::Tuple(const Tuple &other) : allocated_(other.allocated_), rid_(other.rid_), size_(other.size_) {
+Tuple::Tuple(const Tuple &other)
+    : allocated_(other.data_ != nullptr), rid_(other.rid_), size_(other.size_), overflow_pool_(other.overflow_pool_) {
+  // Deep copy, also of a tuple that does not own its data, so the copy outlives the page or pool it points into.
   if (allocated_) {
-    delete[] data_;
-  }
-  if (allocated_) {
-    // Deep copy.
     data_ = new char[size_];
     memcpy(data_, other.data_, size_);
-  } else {
-    // Shallow copy.
-    data_ = other.data_;
   }
 }
 
 Tuple &Tuple::operator=(const Tuple &other) {
+  if (this == &other) {
+    return *this;
+  }
   if (allocated_) {
     delete[] data_;
   }
-  allocated_ = other.allocated_;
+  allocated_ = other.data_ != nullptr;
   rid_ = other.rid_;
   size_ = other.size_;
+  overflow_pool_ = other.overflow_pool_;
+  data_ = nullptr;
 
+  // Deep copy, also of a tuple that does not own its data.
   if (allocated_) {
-    // Deep copy.
     data_ = new char[size_];
     memcpy(data_, other.data_, size_);
-  } else {
-    // Shallow copy.
-    data_ = other.data_;
   }
 
   return *this;
 }
 
+Tuple::Tuple(Tuple &&other) noexcept
+    : allocated_(other.allocated_),
+      rid_(other.rid_),
+      size_(other.size_),
+      data_(other.data_),
+      overflow_pool_(other.overflow_pool_) {
+  other.allocated_ = false;
+  other.size_ = 0;
+  other.data_ = nullptr;
+}
+
+Tuple &Tuple::operator=(Tuple &&other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  if (allocated_) {
+    delete[] data_;
+  }
+  allocated_ = other.allocated_;
+  rid_ = other.rid_;
+  size_ = other.size_;
+  data_ = other.data_;
+  overflow_pool_ = other.overflow_pool_;
+  other.allocated_ = false;
+  other.size_ = 0;
+  other.data_ = nullptr;
+  return *this;
+}
+
+Tuple Tuple::KeyFromTuple(const Schema &schema, const Schema &key_schema,
+                          const std::vector<uint32_t> &key_attrs) const {
+  std::vector<Value> values;
+  values.reserve(key_attrs.size());
+  for (auto idx : key_attrs) {
+    values.emplace_back(this->GetValue(&schema, idx));
+  }
+  return Tuple(values, &key_schema);
+}
+
 Value Tuple::GetValue(const Schema *schema, const uint32_t column_idx) const {
   assert(schema);
   assert(data_);
   const TypeId column_type = schema->GetColumn(column_idx).GetType();
   const char *data_ptr = GetDataPtr(schema, column_idx);
+  if (!schema->GetColumn(column_idx).IsInlined() && IsOverflowValue(data_ptr)) {
+    // Fetch the value from its overflow chain, now that it is read.
+    VarlenReader reader(data_ptr, overflow_pool_);
+    std::unique_ptr<char[]> data(new char[reader.GetLength()]);
+    reader.Read(data.get(), reader.GetLength());
+    return Value(column_type, data.get(), reader.GetLength(), true);
+  }
   // the third parameter "is_inlined" is unused
   return Value::DeserializeFrom(data_ptr, column_type);
 }
 
+Value Tuple::GetValueView(const Schema *schema, const uint32_t column_idx) const {
+  const TypeId column_type = schema->GetColumn(column_idx).GetType();
+  const char *data_ptr = GetDataPtr(schema, column_idx);
+  if (schema->GetColumn(column_idx).IsInlined()) {
+    return Value::DeserializeFrom(data_ptr, column_type);
+  }
+  if (IsOverflowValue(data_ptr)) {
+    return GetValue(schema, column_idx);
+  }
+  uint32_t len = *reinterpret_cast<const uint32_t *>(data_ptr);
+  if (len == BUSTUB_VALUE_NULL) {
+    return Value(column_type, nullptr, len, false);
+  }
+  return Value(column_type, data_ptr + sizeof(uint32_t), len, false);
+}
+
+VarlenReader Tuple::GetVarlenReader(const Schema *schema, const uint32_t column_idx) const {
+  BUSTUB_ASSERT(!schema->GetColumn(column_idx).IsInlined(), "Only varied-sized columns can be streamed.");
+  return VarlenReader(GetDataPtr(schema, column_idx), overflow_pool_);
+}
+
+bool Tuple::IsNull(const Schema *schema, const uint32_t column_idx) const {
+  if (!schema->GetColumn(column_idx).IsInlined()) {
+    return *reinterpret_cast<const uint32_t *>(GetDataPtr(schema, column_idx)) == BUSTUB_VALUE_NULL;
+  }
+  Value value = GetValue(schema, column_idx);
+  return value.IsNull();
+}
+
 const char *Tuple::GetDataPtr(const Schema *schema, const uint32_t column_idx) const {
   assert(schema);
   assert(data_);
@@ -0,0 +1,102 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// zone_map.cpp
+//
+// Identification: src/storage/table/zone_map.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/zone_map.h"
+
+#include "common/macros.h"
+
+namespace bustub {
+
+ZoneMap::ZoneMap(const Schema &schema) : schema_(schema) {}
+
+void ZoneMap::AddPage(page_id_t page_id) {
+  std::scoped_lock lock(latch_);
+  page_ids_.push_back(page_id);
+  summaries_[page_id].columns_.resize(schema_.GetColumnCount());
+}
+
+void ZoneMap::Insert(page_id_t page_id, const Tuple &tuple) {
+  std::scoped_lock lock(latch_);
+  auto summary = summaries_.find(page_id);
+  BUSTUB_ASSERT(summary != summaries_.end(), "The page is not in the zone map.");
+  summary->second.num_tuples_++;
+  Widen(&summary->second, tuple);
+}
+
+void ZoneMap::Update(page_id_t page_id, const Tuple &tuple) {
+  std::scoped_lock lock(latch_);
+  auto summary = summaries_.find(page_id);
+  BUSTUB_ASSERT(summary != summaries_.end(), "The page is not in the zone map.");
+  Widen(&summary->second, tuple);
+}
+
+void ZoneMap::Delete(page_id_t page_id) {
+  std::scoped_lock lock(latch_);
+  auto summary = summaries_.find(page_id);
+  BUSTUB_ASSERT(summary != summaries_.end(), "The page is not in the zone map.");
+  BUSTUB_ASSERT(summary->second.num_tuples_ > 0, "Deleting from an empty page.");
+  if (--summary->second.num_tuples_ == 0) {
+    summary->second.columns_.assign(schema_.GetColumnCount(), ColumnSummary());
+  }
+}
+
+void ZoneMap::UpdateColumn(page_id_t page_id, uint32_t column_idx, const Value &value) {
+  std::scoped_lock lock(latch_);
+  auto summary = summaries_.find(page_id);
+  BUSTUB_ASSERT(summary != summaries_.end(), "The page is not in the zone map.");
+  WidenColumn(&summary->second.columns_[column_idx], value);
+}
+
+void ZoneMap::Widen(PageSummary *summary, const Tuple &tuple) const {
+  for (uint32_t i = 0; i < schema_.GetColumnCount(); i++) {
+    if (IsSummarized(i)) {
+      WidenColumn(&summary->columns_[i], tuple.GetValue(&schema_, i));
+    }
+  }
+}
+
+void ZoneMap::WidenColumn(ColumnSummary *column, const Value &value) {
+  if (value.IsNull()) {
+    column->null_count_++;
+  } else if (!column->has_values_) {
+    column->has_values_ = true;
+    column->min_ = value;
+    column->max_ = value;
+  } else if (value.CompareLessThan(column->min_) == CmpBool::CmpTrue) {
+    column->min_ = value;
+  } else if (value.CompareGreaterThan(column->max_) == CmpBool::CmpTrue) {
+    column->max_ = value;
+  }
+}
+
+bool ZoneMap::GetSummary(page_id_t page_id, uint32_t column_idx, ColumnSummary *summary) {
+  std::scoped_lock lock(latch_);
+  auto page_summary = summaries_.find(page_id);
+  if (page_summary == summaries_.end()) {
+    return false;
+  }
+  *summary = page_summary->second.columns_[column_idx];
+  return true;
+}
+
+uint32_t ZoneMap::GetNumTuples(page_id_t page_id) {
+  std::scoped_lock lock(latch_);
+  auto page_summary = summaries_.find(page_id);
+  return page_summary == summaries_.end() ? 0 : page_summary->second.num_tuples_;
+}
+
+std::vector<page_id_t> ZoneMap::GetPageIds() {
+  std::scoped_lock lock(latch_);
+  return page_ids_;
+}
+
+}  // namespace bustub
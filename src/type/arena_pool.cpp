@@ -0,0 +1,52 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// arena_pool.cpp
+//
+// Identification: src/type/arena_pool.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "type/arena_pool.h"
+
+namespace bustub {
+
+ArenaPool::ArenaPool(size_t chunk_size) : chunk_size_(chunk_size) {
+  BUSTUB_ASSERT(chunk_size_ % ALIGNMENT == 0, "The chunk size must be a multiple of the alignment.");
+}
+
+void *ArenaPool::Allocate(size_t size) {
+  num_allocations_++;
+  size = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+  if (size > chunk_size_ / 2) {
+    // A large allocation would waste most of a regular chunk, give it a chunk of its own.
+    large_chunks_.emplace_back(new char[size]);
+    num_chunk_allocations_++;
+    return large_chunks_.back().get();
+  }
+  if (chunks_.empty() || offset_ + size > chunk_size_) {
+    // Move on to the next chunk, reusing one kept from before the last reset if there is one.
+    if (!chunks_.empty()) {
+      current_chunk_++;
+    }
+    if (current_chunk_ == chunks_.size()) {
+      chunks_.emplace_back(new char[chunk_size_]);
+      num_chunk_allocations_++;
+    }
+    offset_ = 0;
+  }
+  void *ptr = chunks_[current_chunk_].get() + offset_;
+  offset_ += size;
+  return ptr;
+}
+
+void ArenaPool::Reset() {
+  large_chunks_.clear();
+  current_chunk_ = 0;
+  offset_ = 0;
+}
+
+}  // namespace bustub
@@ -27,25 +27,58 @@ Value::Value(const Value &other) {
     case TypeId::VARCHAR:
       if (size_.len_ == BUSTUB_VALUE_NULL) {
         value_.varlen_ = nullptr;
-      } else {
-        if (manage_data_) {
-          value_.varlen_ = new char[size_.len_];
-          memcpy(value_.varlen_, other.value_.varlen_, size_.len_);
-        } else {
-          value_ = other.value_;
-        }
+      } else if (manage_data_ && !IsInlinedVarchar()) {
+        value_.varlen_ = new char[size_.len_];
+        memcpy(value_.varlen_, other.value_.varlen_, size_.len_);
       }
       break;
     default:
-      value_ = other.value_;
+      break;
+  }
+}
+
+Value::Value(Value &&other) noexcept {
+  type_id_ = other.type_id_;
+  size_ = other.size_;
+  manage_data_ = other.manage_data_;
+  value_ = other.value_;
+  if (type_id_ == TypeId::VARCHAR) {
+    // the data now belongs to this value
+    other.value_.varlen_ = nullptr;
+    other.size_.len_ = BUSTUB_VALUE_NULL;
+    other.manage_data_ = false;
   }
 }
 
-Value &Value::operator=(Value other) {
+Value &Value::operator=(const Value &other) {
+  Value copy(other);
+  Swap(*this, copy);
+  return *this;
+}
+
+Value &Value::operator=(Value &&other) noexcept {
   Swap(*this, other);
   return *this;
 }
 
+Value Value::View() const {
+  if (type_id_ != TypeId::VARCHAR || !manage_data_) {
+    return *this;
+  }
+  return Value(type_id_, GetVarlen(), size_.len_, false);
+}
+
+void Value::SetOwnedVarlen(const char *data, uint32_t len) {
+  manage_data_ = true;
+  size_.len_ = len;
+  if (IsInlinedVarchar()) {
+    memcpy(value_.inline_, data, len);
+  } else {
+    value_.varlen_ = new char[len];
+    memcpy(value_.varlen_, data, len);
+  }
+}
+
 // BOOLEAN and TINYINT
 Value::Value(TypeId type, int8_t i) : Value(type) {
   switch (type) {
@@ -218,13 +251,9 @@ Value::Value(TypeId type, const char *data, uint32_t len, bool manage_data) : Va
         value_.varlen_ = nullptr;
         size_.len_ = BUSTUB_VALUE_NULL;
       } else {
-        manage_data_ = manage_data;
-        if (manage_data_) {
+        if (manage_data) {
           assert(len < BUSTUB_VARCHAR_MAX_LEN);
-          value_.varlen_ = new char[len];
-          assert(value_.varlen_ != nullptr);
-          size_.len_ = len;
-          memcpy(value_.varlen_, data, len);
+          SetOwnedVarlen(data, len);
         } else {
           // FUCK YOU GCC I do what I want.
           value_.const_varlen_ = data;
@@ -240,13 +269,8 @@ Value::Value(TypeId type, const char *data, uint32_t len, bool manage_data) : Va
 Value::Value(TypeId type, const std::string &data) : Value(type) {
   switch (type) {
     case TypeId::VARCHAR: {
-      manage_data_ = true;
       // TODO(TAs): How to represent a null string here?
-      uint32_t len = static_cast<uint32_t>(data.length()) + 1;
-      value_.varlen_ = new char[len];
-      assert(value_.varlen_ != nullptr);
-      size_.len_ = len;
-      memcpy(value_.varlen_, data.c_str(), len);
+      SetOwnedVarlen(data.c_str(), static_cast<uint32_t>(data.length()) + 1);
       break;
     }
     default:
@@ -258,7 +282,7 @@ Value::Value(TypeId type, const std::string &data) : Value(type) {
 Value::~Value() {
   switch (type_id_) {
     case TypeId::VARCHAR:
-      if (manage_data_) {
+      if (manage_data_ && !IsInlinedVarchar()) {
         delete[] value_.varlen_;
       }
       break;
@@ -292,6 +316,8 @@ bool Value::CheckComparable(const Value &o) const {
       // Anything can be cast to a string!
       return true;
       break;
+    case TypeId::TIMESTAMP:
+      return (o.GetTypeId() == TypeId::TIMESTAMP || o.GetTypeId() == TypeId::VARCHAR);
     default:
       break;
   }  // END OF SWITCH
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <cstdio>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -17,6 +18,8 @@
 #include "buffer/buffer_pool_manager.h"
 #include "catalog/simple_catalog.h"
 #include "gtest/gtest.h"
+#include "storage/index/covering_value.h"
+#include "storage/index/generic_key.h"
 #include "type/value_factory.h"
 
 namespace bustub {
@@ -48,4 +51,50 @@ TEST(CatalogTest, CreateTableTest) {
   delete disk_manager;
 }
 
+// NOLINTNEXTLINE
+TEST(CatalogTest, CreateIndexTest) {
+  auto disk_manager = new DiskManager("catalog_test.db");
+  auto bpm = new BufferPoolManager(32, disk_manager);
+  auto catalog = new SimpleCatalog(bpm, nullptr, nullptr);
+  Transaction txn(0);
+
+  Schema schema({Column("A", TypeId::INTEGER), Column("B", TypeId::BIGINT), Column("C", TypeId::BIGINT),
+                 Column("D", TypeId::BIGINT), Column("E", TypeId::VARCHAR, 8)});
+  auto *table_metadata = catalog->CreateTable(&txn, "potato", schema);
+  RID rid;
+  Tuple tuple({ValueFactory::GetIntegerValue(1), ValueFactory::GetBigIntValue(2), ValueFactory::GetBigIntValue(3),
+               ValueFactory::GetBigIntValue(4), ValueFactory::GetVarcharValue("potato")},
+              &schema);
+  ASSERT_TRUE(table_metadata->table_->InsertTuple(tuple, &rid, &txn));
+
+  // a key size that is not the size of the key type, a key or included columns that do not fit, and a varchar
+  // included column are all rejected
+  EXPECT_EQ(nullptr, (catalog->CreateIndex<GenericKey<8>, RID, GenericComparator<8>>(&txn, "idx", "potato", schema,
+                                                                                      {0}, 4)));
+  EXPECT_EQ(nullptr, (catalog->CreateIndex<GenericKey<4>, RID, GenericComparator<4>>(&txn, "idx", "potato", schema,
+                                                                                      {1}, 4)));
+  EXPECT_EQ(nullptr, (catalog->CreateIndex<GenericKey<8>, CoveringValue<16>, GenericComparator<8>>(
+                         &txn, "idx", "potato", schema, {0}, 8, {1, 2, 3})));
+  EXPECT_EQ(nullptr, (catalog->CreateIndex<GenericKey<8>, CoveringValue<16>, GenericComparator<8>>(
+                         &txn, "idx", "potato", schema, {0}, 8, {4})));
+  EXPECT_TRUE(catalog->GetTableIndexes("potato").empty());
+
+  // a covering index whose included columns fit, under the name the rejected ones did not take
+  IndexInfo *index_info = catalog->CreateIndex<GenericKey<8>, CoveringValue<16>, GenericComparator<8>>(
+      &txn, "idx", "potato", schema, {0}, 8, {1, 2});
+  ASSERT_NE(nullptr, index_info);
+  EXPECT_EQ(std::vector<IndexInfo *>{index_info}, catalog->GetTableIndexes("potato"));
+
+  // lookups append to the result, like the ones of an index without included columns
+  Schema key_schema({Column("A", TypeId::INTEGER)});
+  std::vector<RID> result{RID(42, 42)};
+  index_info->index_->ScanKey(Tuple({ValueFactory::GetIntegerValue(1)}, &key_schema), &result, &txn);
+  EXPECT_EQ((std::vector<RID>{RID(42, 42), rid}), result);
+
+  delete catalog;
+  delete bpm;
+  delete disk_manager;
+  remove("catalog_test.db");
+}
+
 }  // namespace bustub
@@ -10,11 +10,17 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <iostream>
+#include <iterator>
 #include <thread>  // NOLINT
+#include <utility>
 #include <vector>
 
 #include "common/logger.h"
 #include "container/hash/linear_probe_hash_table.h"
+#include "storage/index/generic_key.h"
 #include "gtest/gtest.h"
 #include "murmur3/MurmurHash3.h"
 
@@ -104,4 +110,411 @@ TEST(HashTableTest, SampleTest) {
   delete bpm;
 }
 
+// NOLINTNEXTLINE
+TEST(HashTableTest, BulkLoadTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+
+  // a single block, far too small for the pairs
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 1, HashFunction<int>());
+
+  std::vector<std::pair<int, int>> entries;
+  for (int i = 0; i < 10000; i++) {
+    entries.emplace_back(i / 2, i);
+  }
+  EXPECT_EQ(10000, ht.BulkLoad(nullptr, entries));
+
+  for (int i = 0; i < 5000; i++) {
+    std::vector<int> res;
+    EXPECT_TRUE(ht.GetValue(nullptr, i, &res));
+    ASSERT_EQ(2, res.size()) << "Failed to load " << i << std::endl;
+    EXPECT_EQ(2 * i, std::min(res[0], res[1]));
+    EXPECT_EQ(2 * i + 1, std::max(res[0], res[1]));
+  }
+
+  // regular operations still work on the loaded table
+  EXPECT_FALSE(ht.Insert(nullptr, 0, 0));
+  EXPECT_TRUE(ht.Remove(nullptr, 0, 0));
+  EXPECT_TRUE(ht.Insert(nullptr, 0, 0));
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, ResizeTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 1, HashFunction<int>());
+
+  // enough pairs to fill the first block several times over
+  const int num_keys = 5000;
+  bool seen_resizing = false;
+  for (int i = 0; i < num_keys; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i)) << "Failed to insert " << i << std::endl;
+    if (ht.IsResizing()) {
+      seen_resizing = true;
+      // pairs that are not migrated yet are still found
+      for (int j = 0; j <= i; j += 7) {
+        std::vector<int> res;
+        ht.GetValue(nullptr, j, &res);
+        ASSERT_EQ(1, res.size()) << "Lost " << j << " while resizing" << std::endl;
+      }
+      EXPECT_FALSE(ht.Insert(nullptr, 0, 0));
+    }
+  }
+  EXPECT_TRUE(seen_resizing);
+
+  for (int i = 0; i < num_keys; i++) {
+    std::vector<int> res;
+    EXPECT_TRUE(ht.GetValue(nullptr, i, &res));
+    ASSERT_EQ(1, res.size()) << "Failed to keep " << i << std::endl;
+    EXPECT_EQ(i, res[0]);
+  }
+
+  // an explicit resize migrates everything before returning
+  ht.Resize(4 * num_keys);
+  EXPECT_FALSE(ht.IsResizing());
+  for (int i = 0; i < num_keys; i++) {
+    EXPECT_TRUE(ht.Remove(nullptr, i, i));
+    std::vector<int> res;
+    EXPECT_FALSE(ht.GetValue(nullptr, i, &res));
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, CapacityTest) {
+  // wide pairs, so the table reaches the most blocks its header page can address after a few thousand inserts
+  Schema key_schema({Column("a", TypeId::BIGINT)});
+  GenericComparator<64> comparator(&key_schema);
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+  LinearProbeHashTable<GenericKey<64>, RID, GenericComparator<64>> ht("blah", bpm, comparator, 1,
+                                                                      HashFunction<GenericKey<64>>());
+  auto key = [](int64_t i) {
+    GenericKey<64> key;
+    key.SetFromInteger(i);
+    return key;
+  };
+
+  // the table grows up to its largest size, fills up completely, and then refuses pairs
+  const size_t num_slots =
+      HashTableHeaderPage::MaxNumBlocks() * (4 * PAGE_SIZE / (4 * sizeof(std::pair<GenericKey<64>, RID>) + 1));
+  int64_t num_inserted = 0;
+  while (ht.Insert(nullptr, key(num_inserted), RID(num_inserted))) {
+    num_inserted++;
+  }
+  EXPECT_EQ(num_slots, num_inserted);
+  EXPECT_FALSE(ht.Insert(nullptr, key(num_inserted), RID(num_inserted)));
+  EXPECT_FALSE(ht.IsResizing());
+
+  // a single tombstone is reused, instead of rebuilding the whole table at the same size
+  EXPECT_TRUE(ht.Remove(nullptr, key(0), RID(0)));
+  EXPECT_TRUE(ht.Insert(nullptr, key(num_inserted), RID(num_inserted)));
+  EXPECT_FALSE(ht.IsResizing());
+  EXPECT_EQ(num_slots, ht.GetSize());
+
+  // once tombstones take up a good part of the table, it is rebuilt to drop them, without losing a pair
+  for (int64_t i = 1; i < num_inserted / 2; i++) {
+    EXPECT_TRUE(ht.Remove(nullptr, key(i), RID(i)));
+  }
+  for (int64_t i = 1; i < num_inserted / 4; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, key(i), RID(i)));
+  }
+  ht.Resize(0);
+  EXPECT_FALSE(ht.IsResizing());
+  for (int64_t i = 0; i <= num_inserted; i++) {
+    std::vector<RID> res;
+    bool expected = (i >= 1 && i < num_inserted / 4) || i >= num_inserted / 2;
+    EXPECT_EQ(expected, ht.GetValue(nullptr, key(i), &res)) << i;
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, ConcurrentInsertTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 1, HashFunction<int>());
+
+  const int num_threads = 4;
+  const int keys_per_thread = 5000;
+  std::vector<std::thread> threads;
+  std::vector<std::chrono::nanoseconds> max_latency(num_threads, std::chrono::nanoseconds(0));
+  for (int tid = 0; tid < num_threads; tid++) {
+    threads.emplace_back([&ht, &max_latency, tid] {
+      for (int i = tid * keys_per_thread; i < (tid + 1) * keys_per_thread; i++) {
+        auto start = std::chrono::steady_clock::now();
+        ht.Insert(nullptr, i, i);
+        max_latency[tid] = std::max(max_latency[tid], std::chrono::steady_clock::now() - start);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto worst = *std::max_element(max_latency.begin(), max_latency.end());
+  LOG_INFO("Max insert latency: %ld us", std::chrono::duration_cast<std::chrono::microseconds>(worst).count());
+
+  for (int i = 0; i < num_threads * keys_per_thread; i++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    ASSERT_EQ(1, res.size()) << "Failed to keep " << i << std::endl;
+    EXPECT_EQ(i, res[0]);
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, CompactionTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+
+  // a single block that the working set never fills up
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 1, HashFunction<int>());
+
+  const int working_set = 200;
+  for (int i = 0; i < working_set; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i));
+  }
+  // every round removes the oldest keys and inserts as many new ones
+  for (int round = 0; round < 50; round++) {
+    for (int i = 0; i < 50; i++) {
+      int oldest = round * 50 + i;
+      EXPECT_TRUE(ht.Remove(nullptr, oldest, oldest));
+      EXPECT_TRUE(ht.Insert(nullptr, oldest + working_set, oldest + working_set));
+    }
+    for (int i = (round + 1) * 50; i < (round + 1) * 50 + working_set; i++) {
+      std::vector<int> res;
+      ht.GetValue(nullptr, i, &res);
+      ASSERT_EQ(1, res.size()) << "Failed to keep " << i << " in round " << round << std::endl;
+    }
+  }
+  EXPECT_FALSE(ht.IsResizing());
+  EXPECT_GT(ht.GetNumCompactions(), 0);
+  EXPECT_GT(ht.GetNumTombstonesCleared(), 0);
+  EXPECT_LT(ht.GetTombstoneRatio(), 0.5);
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, SizeTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 1, HashFunction<int>());
+  const size_t block_array_size = 4 * PAGE_SIZE / (4 * sizeof(std::pair<int, int>) + 1);
+
+  // the size is right while resizes run, and the first resize starts long before the block is full
+  const int num_keys = 2000;
+  int first_resize = num_keys;
+  for (int i = 0; i < num_keys; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i));
+    if (ht.IsResizing() && first_resize == num_keys) {
+      first_resize = i;
+    }
+    EXPECT_FALSE(ht.Insert(nullptr, i, i));
+    EXPECT_EQ(i + 1, ht.GetSize());
+  }
+  EXPECT_LT(first_resize, block_array_size);
+
+  for (int i = 0; i < num_keys; i += 2) {
+    EXPECT_TRUE(ht.Remove(nullptr, i, i));
+    EXPECT_FALSE(ht.Remove(nullptr, i, i));
+  }
+  EXPECT_EQ(num_keys / 2, ht.GetSize());
+  EXPECT_GT(ht.GetTombstoneRatio(), 0);
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, TwoFrameBufferPoolTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  // point operations only pin the block they probe, and migrating pins an old and a new block
+  auto *bpm = new BufferPoolManager(2, disk_manager);
+
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 1, HashFunction<int>());
+
+  // grows through several resizes
+  const int num_keys = 3000;
+  for (int i = 0; i < num_keys; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i)) << "Failed to insert " << i << std::endl;
+  }
+  for (int i = 0; i < num_keys; i += 3) {
+    EXPECT_TRUE(ht.Remove(nullptr, i, i));
+  }
+  for (int i = 0; i < num_keys; i++) {
+    std::vector<int> res;
+    EXPECT_EQ(i % 3 != 0, ht.GetValue(nullptr, i, &res));
+  }
+  EXPECT_EQ(num_keys - (num_keys + 2) / 3, ht.GetSize());
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, DISABLED_BatchLookupBenchmark) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(1000, disk_manager);
+
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 64, HashFunction<int>());
+
+  // every even key has two values, odd keys are missing
+  const int num_keys = 20000;
+  for (int i = 0; i < num_keys; i += 2) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i));
+    EXPECT_TRUE(ht.Insert(nullptr, i, -i - 1));
+  }
+  // lookups migrate too, finish any resize before timing
+  std::vector<int> res;
+  while (ht.IsResizing()) {
+    ht.GetValue(nullptr, 0, &res);
+  }
+
+  std::vector<int> keys(num_keys);
+  for (int i = 0; i < num_keys; i++) {
+    keys[i] = (i * 7919) % num_keys;
+  }
+  for (size_t batch_size : {1, 16, 256}) {
+    std::vector<std::vector<int>> all_results;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t first = 0; first < keys.size(); first += batch_size) {
+      std::vector<int> batch(keys.begin() + first, keys.begin() + std::min(first + batch_size, keys.size()));
+      std::vector<std::vector<int>> results;
+      ht.GetValues(nullptr, batch, &results);
+      ASSERT_EQ(batch.size(), results.size());
+      std::move(results.begin(), results.end(), std::back_inserter(all_results));
+    }
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "batch size " << batch_size << ": " << us << " us for " << num_keys << " lookups" << std::endl;
+
+    for (size_t i = 0; i < keys.size(); i++) {
+      std::vector<int> expected;
+      ht.GetValue(nullptr, keys[i], &expected);
+      std::sort(expected.begin(), expected.end());
+      std::sort(all_results[i].begin(), all_results[i].end());
+      ASSERT_EQ(expected, all_results[i]) << "key " << keys[i] << std::endl;
+      ASSERT_EQ(keys[i] % 2 == 0 ? 2 : 0, all_results[i].size());
+    }
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, BloomFilterTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 1, HashFunction<int>(), true);
+
+  // the filter is rebuilt by every resize on the way, and must never hide a pair
+  const int num_keys = 5000;
+  for (int i = 0; i < num_keys; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i));
+    EXPECT_FALSE(ht.Insert(nullptr, i, i));
+  }
+  for (int i = 0; i < num_keys; i += 2) {
+    EXPECT_TRUE(ht.Remove(nullptr, i, i));
+  }
+  for (int i = 0; i < num_keys; i++) {
+    std::vector<int> res;
+    EXPECT_EQ(i % 2 == 1, ht.GetValue(nullptr, i, &res)) << "key " << i << std::endl;
+  }
+
+  // keys that were never inserted are almost all answered by the filter
+  size_t negatives = ht.GetNumFilterNegatives();
+  for (int i = num_keys; i < 2 * num_keys; i++) {
+    std::vector<int> res;
+    EXPECT_FALSE(ht.GetValue(nullptr, i, &res));
+    EXPECT_FALSE(ht.Remove(nullptr, i, i));
+  }
+  double false_positive_rate = 1 - static_cast<double>(ht.GetNumFilterNegatives() - negatives) / (2 * num_keys);
+  EXPECT_LT(false_positive_rate, 0.05);
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, DISABLED_BloomFilterBenchmark) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(1000, disk_manager);
+
+  LinearProbeHashTable<int, int, IntComparator> plain("blah", bpm, IntComparator(), 64, HashFunction<int>());
+  LinearProbeHashTable<int, int, IntComparator> filtered("blah", bpm, IntComparator(), 64, HashFunction<int>(), true);
+
+  // a table near its maximum load, where probe chains are long
+  const int num_keys = 20000;
+  for (int i = 0; i < num_keys; i++) {
+    plain.Insert(nullptr, i, i);
+    filtered.Insert(nullptr, i, i);
+  }
+  std::vector<int> res;
+  while (plain.IsResizing() || filtered.IsResizing()) {
+    plain.GetValue(nullptr, 0, &res);
+    filtered.GetValue(nullptr, 0, &res);
+  }
+
+  auto lookup_us = [](auto *ht, int first, int last) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = first; i < last; i++) {
+      std::vector<int> res;
+      ht->GetValue(nullptr, i, &res);
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+  };
+  const int num_lookups = 100000;
+  size_t negatives = filtered.GetNumFilterNegatives();
+  auto plain_miss_us = lookup_us(&plain, num_keys, num_keys + num_lookups);
+  auto filtered_miss_us = lookup_us(&filtered, num_keys, num_keys + num_lookups);
+  double false_positive_rate =
+      1 - static_cast<double>(filtered.GetNumFilterNegatives() - negatives) / static_cast<double>(num_lookups);
+  std::cout << "misses: " << plain_miss_us << " us without filter, " << filtered_miss_us << " us with filter, "
+            << "false positive rate " << false_positive_rate << std::endl;
+  std::cout << "hits: " << lookup_us(&plain, 0, num_keys) << " us without filter, "
+            << lookup_us(&filtered, 0, num_keys) << " us with filter" << std::endl;
+  EXPECT_LT(false_positive_rate, 0.05);
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
 }  // namespace bustub
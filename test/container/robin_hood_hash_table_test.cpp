@@ -0,0 +1,164 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// robin_hood_hash_table_test.cpp
+//
+// Identification: test/container/robin_hood_hash_table_test.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>  // NOLINT
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include "common/logger.h"
+#include "container/hash/linear_probe_hash_table.h"
+#include "container/hash/robin_hood_hash_table.h"
+#include "gtest/gtest.h"
+#include "murmur3/MurmurHash3.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(RobinHoodHashTableTest, SampleTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+
+  RobinHoodHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 1, HashFunction<int>());
+
+  // insert a few values
+  for (int i = 0; i < 5; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i));
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    EXPECT_EQ(1, res.size()) << "Failed to insert " << i << std::endl;
+    EXPECT_EQ(i, res[0]);
+  }
+
+  // insert one more value for each key
+  for (int i = 0; i < 5; i++) {
+    if (i == 0) {
+      // duplicate values for the same key are not allowed
+      EXPECT_FALSE(ht.Insert(nullptr, i, 2 * i));
+    } else {
+      EXPECT_TRUE(ht.Insert(nullptr, i, 2 * i));
+    }
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    EXPECT_EQ(i == 0 ? 1 : 2, res.size());
+  }
+  EXPECT_EQ(9, ht.GetSize());
+
+  // look for a key that does not exist
+  std::vector<int> res;
+  EXPECT_FALSE(ht.GetValue(nullptr, 20, &res));
+  EXPECT_EQ(0, res.size());
+
+  // delete all values
+  for (int i = 0; i < 5; i++) {
+    EXPECT_TRUE(ht.Remove(nullptr, i, i));
+    if (i != 0) {
+      EXPECT_TRUE(ht.Remove(nullptr, i, 2 * i));
+    }
+    EXPECT_FALSE(ht.Remove(nullptr, i, i));
+  }
+  EXPECT_EQ(0, ht.GetSize());
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(RobinHoodHashTableTest, GrowAndShiftTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+
+  RobinHoodHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 1, HashFunction<int>());
+
+  // enough pairs to double the table several times, every key with two values
+  const int num_keys = 5000;
+  for (int i = 0; i < num_keys; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i)) << "Failed to insert " << i << std::endl;
+    EXPECT_TRUE(ht.Insert(nullptr, i, -i - 1));
+  }
+  auto histogram = ht.GetProbeLengthHistogram();
+  EXPECT_EQ(2 * num_keys, std::accumulate(histogram.begin(), histogram.end(), size_t{0}));
+  EXPECT_EQ(2 * num_keys, ht.GetSize());
+
+  // removing one value of every other key shifts the chains back
+  for (int i = 0; i < num_keys; i += 2) {
+    EXPECT_TRUE(ht.Remove(nullptr, i, i));
+  }
+  for (int i = 0; i < num_keys; i++) {
+    std::vector<int> res;
+    EXPECT_TRUE(ht.GetValue(nullptr, i, &res));
+    ASSERT_EQ(i % 2 == 0 ? 1 : 2, res.size()) << "Failed to keep " << i << std::endl;
+  }
+  histogram = ht.GetProbeLengthHistogram();
+  EXPECT_EQ(3 * num_keys / 2, std::accumulate(histogram.begin(), histogram.end(), size_t{0}));
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(RobinHoodHashTableTest, DISABLED_ChurnBenchmark) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+
+  RobinHoodHashTable<int, int, IntComparator> robin_hood("blah", bpm, IntComparator(), 8, HashFunction<int>());
+  LinearProbeHashTable<int, int, IntComparator> linear_probe("blah", bpm, IntComparator(), 8, HashFunction<int>());
+
+  // a steady working set of live keys: every round inserts a batch of new keys and removes the oldest batch
+  const int working_set = 2000;
+  const int batch = 500;
+  const int num_rounds = 20;
+  for (int i = 0; i < working_set; i++) {
+    robin_hood.Insert(nullptr, i, i);
+    linear_probe.Insert(nullptr, i, i);
+  }
+
+  auto lookup_us = [](auto *ht, int first, int last) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = first; i < last; i++) {
+      std::vector<int> res;
+      ht->GetValue(nullptr, i, &res);
+      EXPECT_EQ(1, res.size());
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+  };
+  for (int round = 0; round < num_rounds; round++) {
+    int oldest = round * batch;
+    int newest = working_set + round * batch;
+    for (int i = 0; i < batch; i++) {
+      EXPECT_TRUE(robin_hood.Insert(nullptr, newest + i, newest + i));
+      EXPECT_TRUE(robin_hood.Remove(nullptr, oldest + i, oldest + i));
+      EXPECT_TRUE(linear_probe.Insert(nullptr, newest + i, newest + i));
+      EXPECT_TRUE(linear_probe.Remove(nullptr, oldest + i, oldest + i));
+    }
+    if (round % 5 == 4) {
+      int first = oldest + batch;
+      int last = newest + batch;
+      auto histogram = robin_hood.GetProbeLengthHistogram();
+      std::cout << "round " << round + 1 << ": robin hood lookups " << lookup_us(&robin_hood, first, last)
+                << " us (longest probe " << histogram.size() << "), linear probe lookups "
+                << lookup_us(&linear_probe, first, last) << " us" << std::endl;
+    }
+  }
+  EXPECT_EQ(working_set, robin_hood.GetSize());
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+}  // namespace bustub
@@ -10,7 +10,10 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <chrono>  // NOLINT
 #include <cstdio>
+#include <iostream>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -24,13 +27,19 @@
 #include "execution/executor_factory.h"
 #include "execution/executors/aggregation_executor.h"
 #include "execution/executors/hash_join_executor.h"
+#include "execution/executors/index_scan_executor.h"
 #include "execution/executors/insert_executor.h"
+#include "execution/executors/seq_scan_executor.h"
 #include "execution/expressions/aggregate_value_expression.h"
 #include "execution/expressions/column_value_expression.h"
 #include "execution/expressions/comparison_expression.h"
 #include "execution/expressions/constant_value_expression.h"
+#include "execution/plans/index_scan_plan.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "gtest/gtest.h"
+#include "storage/index/covering_value.h"
+#include "storage/index/generic_key.h"
+#include "storage/table/table_batch_iterator.h"
 #include "type/value_factory.h"
 
 namespace bustub {
@@ -253,6 +262,476 @@ TEST_F(ExecutorTest, SimpleSelectInsertTest) {
   ASSERT_EQ(num_tuples, 500);
 }
 
+// NOLINTNEXTLINE
+TEST_F(ExecutorTest, IndexOnlyScanTest) {
+  // CREATE INDEX test_1_colA ON test_1 (colA) INCLUDE (colB)
+  auto *catalog = GetExecutorContext()->GetCatalog();
+  TableMetadata *table_info = catalog->GetTable("test_1");
+  Schema &schema = table_info->schema_;
+  IndexInfo *index_info = catalog->CreateIndex<GenericKey<8>, CoveringValue<16>, GenericComparator<8>>(
+      GetExecutorContext()->GetTransaction(), "test_1_colA", "test_1", schema, {0}, 8, {1});
+  ASSERT_TRUE(index_info->index_->IsCovering());
+  const Schema *covering_schema = index_info->index_->GetMetadata()->GetCoveringSchema();
+
+  // SELECT colA, colB FROM test_1 WHERE colA = ?, once from the index alone and once through the table heap
+  auto *index_colA = MakeColumnValueExpression(*covering_schema, 0, "colA");
+  auto *index_colB = MakeColumnValueExpression(*covering_schema, 0, "colB");
+  auto *index_out_schema = MakeOutputSchema({{"colA", index_colA}, {"colB", index_colB}});
+  auto *heap_colA = MakeColumnValueExpression(schema, 0, "colA");
+  auto *heap_colB = MakeColumnValueExpression(schema, 0, "colB");
+  auto *heap_out_schema = MakeOutputSchema({{"colA", heap_colA}, {"colB", heap_colB}});
+  for (int32_t key = 0; key < static_cast<int32_t>(TEST1_SIZE); key += 37) {
+    IndexScanPlanNode index_plan{index_out_schema, nullptr, index_info->index_oid_,
+                                 {ValueFactory::GetIntegerValue(key)}, true};
+    auto index_executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &index_plan);
+    index_executor->Init();
+    IndexScanPlanNode heap_plan{heap_out_schema, nullptr, index_info->index_oid_,
+                                {ValueFactory::GetIntegerValue(key)}, false};
+    auto heap_executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &heap_plan);
+    heap_executor->Init();
+
+    Tuple index_tuple;
+    Tuple heap_tuple;
+    ASSERT_TRUE(index_executor->Next(&index_tuple));
+    ASSERT_TRUE(heap_executor->Next(&heap_tuple));
+    ASSERT_EQ(index_tuple.GetValue(index_out_schema, 0).GetAs<int32_t>(), key);
+    ASSERT_EQ(index_tuple.GetValue(index_out_schema, 1).GetAs<int32_t>(),
+              heap_tuple.GetValue(heap_out_schema, 1).GetAs<int32_t>());
+    ASSERT_FALSE(index_executor->Next(&index_tuple));
+    ASSERT_FALSE(heap_executor->Next(&heap_tuple));
+  }
+
+  // the predicate of an index-only scan is evaluated on the included columns
+  auto *const_minus1 = MakeConstantValueExpression(ValueFactory::GetIntegerValue(-1));
+  auto *predicate = MakeComparisonExpression(index_colB, const_minus1, ComparisonType::Equal);
+  IndexScanPlanNode filtered_plan{index_out_schema, predicate, index_info->index_oid_,
+                                  {ValueFactory::GetIntegerValue(0)}, true};
+  auto filtered_executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &filtered_plan);
+  filtered_executor->Init();
+  Tuple tuple;
+  ASSERT_FALSE(filtered_executor->Next(&tuple));
+}
+
+// NOLINTNEXTLINE
+TEST_F(ExecutorTest, InsertMaintainsIndexTest) {
+  // CREATE INDEX empty_table2_colA ON empty_table2 (colA) INCLUDE (colB)
+  auto *catalog = GetExecutorContext()->GetCatalog();
+  TableMetadata *table_info = catalog->GetTable("empty_table2");
+  IndexInfo *index_info = catalog->CreateIndex<GenericKey<8>, CoveringValue<16>, GenericComparator<8>>(
+      GetExecutorContext()->GetTransaction(), "empty_table2_colA", "empty_table2", table_info->schema_, {0}, 8, {1});
+
+  // INSERT INTO empty_table2 VALUES (100, 10), (101, 11)
+  std::vector<Value> val1{ValueFactory::GetIntegerValue(100), ValueFactory::GetIntegerValue(10)};
+  std::vector<Value> val2{ValueFactory::GetIntegerValue(101), ValueFactory::GetIntegerValue(11)};
+  std::vector<std::vector<Value>> raw_vals{val1, val2};
+  InsertPlanNode insert_plan{std::move(raw_vals), table_info->oid_};
+  auto insert_executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &insert_plan);
+  insert_executor->Init();
+  ASSERT_TRUE(insert_executor->Next(nullptr));
+
+  // SELECT colB FROM empty_table2 WHERE colA = 101, answered by the index alone
+  const Schema *covering_schema = index_info->index_->GetMetadata()->GetCoveringSchema();
+  auto *colB = MakeColumnValueExpression(*covering_schema, 0, "colB");
+  auto *out_schema = MakeOutputSchema({{"colB", colB}});
+  IndexScanPlanNode plan{out_schema, nullptr, index_info->index_oid_, {ValueFactory::GetIntegerValue(101)}, true};
+  auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &plan);
+  executor->Init();
+  Tuple tuple;
+  ASSERT_TRUE(executor->Next(&tuple));
+  ASSERT_EQ(tuple.GetValue(out_schema, 0).GetAs<int32_t>(), 11);
+  ASSERT_FALSE(executor->Next(&tuple));
+}
+
+// NOLINTNEXTLINE
+TEST_F(ExecutorTest, PaxSeqScanTest) {
+  // CREATE TABLE pax_1 (LIKE test_1) WITH (format = pax)
+  auto *catalog = GetExecutorContext()->GetCatalog();
+  Schema &schema = catalog->GetTable("test_1")->schema_;
+  TableMetadata *pax_info = catalog->CreateTable(GetExecutorContext()->GetTransaction(), "pax_1", schema,
+                                                  TableFormat::PAX);
+  ASSERT_EQ(pax_info->format_, TableFormat::PAX);
+
+  // INSERT INTO pax_1 SELECT * FROM test_1
+  auto *colA = MakeColumnValueExpression(schema, 0, "colA");
+  auto *colB = MakeColumnValueExpression(schema, 0, "colB");
+  auto *out_schema = MakeOutputSchema({{"colA", colA}, {"colB", colB}});
+  SeqScanPlanNode all_plan{out_schema, nullptr, catalog->GetTable("test_1")->oid_};
+  InsertPlanNode insert_plan{&all_plan, pax_info->oid_};
+  auto insert_executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &insert_plan);
+  insert_executor->Init();
+  ASSERT_TRUE(insert_executor->Next(nullptr));
+
+  // SELECT colA, colB FROM pax_1 WHERE colB < 5, the same tuples as from test_1
+  auto *const5 = MakeConstantValueExpression(ValueFactory::GetIntegerValue(5));
+  auto *predicate = MakeComparisonExpression(colB, const5, ComparisonType::LessThan);
+  SeqScanPlanNode row_plan{out_schema, predicate, catalog->GetTable("test_1")->oid_};
+  SeqScanPlanNode pax_plan{out_schema, predicate, pax_info->oid_};
+  auto row_executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &row_plan);
+  auto pax_executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &pax_plan);
+  row_executor->Init();
+  pax_executor->Init();
+  Tuple row_tuple;
+  Tuple pax_tuple;
+  uint32_t num_tuples = 0;
+  while (row_executor->Next(&row_tuple)) {
+    ASSERT_TRUE(pax_executor->Next(&pax_tuple));
+    ASSERT_EQ(row_tuple.GetLength(), pax_tuple.GetLength());
+    for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+      ASSERT_TRUE(row_tuple.GetValue(&schema, i).CompareEquals(pax_tuple.GetValue(&schema, i)) == CmpBool::CmpTrue);
+    }
+    ASSERT_TRUE(pax_tuple.GetValue(&schema, 1).GetAs<int32_t>() < 5);
+    num_tuples++;
+  }
+  ASSERT_FALSE(pax_executor->Next(&pax_tuple));
+  ASSERT_GT(num_tuples, 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ExecutorTest, ZoneMapSeqScanTest) {
+  // SELECT colA, colB FROM test_1 WHERE colA < 100, colA is serial so only the first pages can match
+  TableMetadata *table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  Schema &schema = table_info->schema_;
+  auto *colA = MakeColumnValueExpression(schema, 0, "colA");
+  auto *colB = MakeColumnValueExpression(schema, 0, "colB");
+  auto *out_schema = MakeOutputSchema({{"colA", colA}, {"colB", colB}});
+  size_t num_pages = table_info->table_->GetNumPages();
+  ASSERT_LT(2, num_pages);
+
+  auto scan = [&](const AbstractExpression *predicate, uint32_t *num_tuples) {
+    SeqScanPlanNode plan{out_schema, predicate, table_info->oid_};
+    SeqScanExecutor executor(GetExecutorContext(), &plan);
+    executor.Init();
+    Tuple tuple;
+    *num_tuples = 0;
+    while (executor.Next(&tuple)) {
+      (*num_tuples)++;
+    }
+    return executor.GetStats();
+  };
+
+  uint32_t num_tuples;
+  auto *const100 = MakeConstantValueExpression(ValueFactory::GetIntegerValue(100));
+  ScanStats stats = scan(MakeComparisonExpression(colA, const100, ComparisonType::LessThan), &num_tuples);
+  ASSERT_EQ(100, num_tuples);
+  ASSERT_LT(0, stats.pages_skipped_);
+  ASSERT_EQ(num_pages, stats.pages_read_ + stats.pages_skipped_);
+
+  // the constant may come first as well: WHERE 900 <= colA
+  auto *const900 = MakeConstantValueExpression(ValueFactory::GetIntegerValue(900));
+  stats = scan(MakeComparisonExpression(const900, colA, ComparisonType::LessThanOrEqual), &num_tuples);
+  ASSERT_EQ(TEST1_SIZE - 900, num_tuples);
+  ASSERT_LT(0, stats.pages_skipped_);
+
+  // a value outside all ranges skips every page
+  auto *const5000 = MakeConstantValueExpression(ValueFactory::GetIntegerValue(5000));
+  stats = scan(MakeComparisonExpression(colA, const5000, ComparisonType::Equal), &num_tuples);
+  ASSERT_EQ(0, num_tuples);
+  ASSERT_EQ(0, stats.pages_read_);
+  ASSERT_EQ(num_pages, stats.pages_skipped_);
+
+  // a predicate the zone map cannot check reads every page
+  stats = scan(MakeComparisonExpression(colA, colB, ComparisonType::LessThan), &num_tuples);
+  ASSERT_EQ(0, stats.pages_skipped_);
+  ASSERT_EQ(num_pages, stats.pages_read_);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ExecutorTest, ParallelSeqScanTest) {
+  // SELECT colA, colB FROM test_1 WHERE colA < 500, on four workers
+  TableMetadata *table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  Schema &schema = table_info->schema_;
+  auto *colA = MakeColumnValueExpression(schema, 0, "colA");
+  auto *colB = MakeColumnValueExpression(schema, 0, "colB");
+  auto *const500 = MakeConstantValueExpression(ValueFactory::GetIntegerValue(500));
+  auto *predicate = MakeComparisonExpression(colA, const500, ComparisonType::LessThan);
+  auto *out_schema = MakeOutputSchema({{"colA", colA}, {"colB", colB}});
+  size_t num_pages = table_info->table_->GetNumPages();
+
+  // the page directory splits into ranges that cover every page once, in chain order
+  std::vector<page_id_t> page_ids = table_info->table_->GetPageIds();
+  ASSERT_EQ(num_pages, page_ids.size());
+  ASSERT_EQ(table_info->table_->GetFirstPageId(), page_ids.front());
+  std::vector<page_id_t> joined;
+  for (const auto &range : TableHeap::SplitPages(page_ids, 4)) {
+    ASSERT_FALSE(range.empty());
+    joined.insert(joined.end(), range.begin(), range.end());
+  }
+  ASSERT_EQ(page_ids, joined);
+
+  // every matching tuple comes out exactly once, in whatever order the workers produce them
+  SeqScanPlanNode plan{out_schema, predicate, table_info->oid_, 4};
+  SeqScanExecutor executor(GetExecutorContext(), &plan);
+  executor.Init();
+  std::unordered_set<int32_t> seen;
+  Tuple tuple;
+  while (executor.Next(&tuple)) {
+    int32_t a = tuple.GetValue(&schema, schema.GetColIdx("colA")).GetAs<int32_t>();
+    ASSERT_LT(a, 500);
+    ASSERT_TRUE(seen.insert(a).second);
+  }
+  ASSERT_EQ(500, seen.size());
+  ScanStats stats = executor.GetStats();
+  ASSERT_EQ(num_pages, stats.pages_read_ + stats.pages_skipped_);
+  ASSERT_LT(0, stats.pages_skipped_);
+
+  // the scan can be started again, and abandoned while workers are still producing
+  executor.Init();
+  ASSERT_TRUE(executor.Next(&tuple));
+  SeqScanPlanNode all_plan{out_schema, nullptr, table_info->oid_, 8};
+  SeqScanExecutor all_executor(GetExecutorContext(), &all_plan);
+  all_executor.Init();
+  ASSERT_TRUE(all_executor.Next(&tuple));
+}
+
+// NOLINTNEXTLINE
+TEST(SeqScanBenchmark, DISABLED_ParallelScanBenchmark) {
+  // SELECT c0 FROM t WHERE c1 < 500, over a table of four INTEGER columns, on 1 to 16 workers
+  auto disk_manager = std::make_unique<DiskManager>("executor_benchmark.db");
+  auto bpm = std::make_unique<BufferPoolManager>(4096, disk_manager.get());
+  SimpleCatalog catalog(bpm.get(), nullptr, nullptr);
+  Transaction txn(0);
+  ExecutorContext exec_ctx(&txn, &catalog, bpm.get());
+  std::vector<Column> columns;
+  for (uint32_t i = 0; i < 4; i++) {
+    columns.emplace_back("c" + std::to_string(i), TypeId::INTEGER);
+  }
+  TableMetadata *table_info = catalog.CreateTable(&txn, "t", Schema(columns));
+  const int num_tuples = 400000;
+  std::vector<Tuple> tuples;
+  for (int i = 0; i < num_tuples; i++) {
+    std::vector<Value> values;
+    for (uint32_t j = 0; j < 4; j++) {
+      values.push_back(ValueFactory::GetIntegerValue((i * (j + 7)) % 1000));
+    }
+    tuples.emplace_back(values, &table_info->schema_);
+  }
+  std::vector<RID> rids;
+  ASSERT_TRUE(table_info->table_->BulkInsert(tuples, &rids, &txn));
+
+  ColumnValueExpression c0(0, 0, TypeId::INTEGER);
+  ColumnValueExpression c1(0, 1, TypeId::INTEGER);
+  ConstantValueExpression const500(ValueFactory::GetIntegerValue(500));
+  ComparisonExpression predicate(&c1, &const500, ComparisonType::LessThan);
+  Schema out_schema({Column("c0", TypeId::INTEGER, &c0)});
+  size_t expected = 0;
+  for (uint32_t num_workers : {1, 2, 4, 8, 16}) {
+    SeqScanPlanNode plan{&out_schema, &predicate, table_info->oid_, num_workers};
+    SeqScanExecutor executor(&exec_ctx, &plan);
+    auto start = std::chrono::steady_clock::now();
+    executor.Init();
+    size_t count = 0;
+    Tuple tuple;
+    while (executor.Next(&tuple)) {
+      count++;
+    }
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << num_workers << " workers: " << us << " us, "
+              << int64_t{num_tuples} * 1000000 / std::max<int64_t>(us, 1) << " tuples/sec" << std::endl;
+    expected = expected == 0 ? count : expected;
+    EXPECT_EQ(expected, count);
+  }
+
+  disk_manager->ShutDown();
+  remove("executor_benchmark.db");
+}
+
+// NOLINTNEXTLINE
+TEST(SeqScanBenchmark, DISABLED_ArenaBenchmark) {
+  // SELECT * FROM t WHERE c1 < 500, materializing the matches of every page with and without an arena
+  auto disk_manager = std::make_unique<DiskManager>("executor_benchmark.db");
+  auto bpm = std::make_unique<BufferPoolManager>(4096, disk_manager.get());
+  SimpleCatalog catalog(bpm.get(), nullptr, nullptr);
+  Transaction txn(0);
+  ExecutorContext exec_ctx(&txn, &catalog, bpm.get());
+  std::vector<Column> columns;
+  for (uint32_t i = 0; i < 4; i++) {
+    columns.emplace_back("c" + std::to_string(i), TypeId::INTEGER);
+  }
+  TableMetadata *table_info = catalog.CreateTable(&txn, "t", Schema(columns));
+  const int num_tuples = 400000;
+  std::vector<Tuple> tuples;
+  for (int i = 0; i < num_tuples; i++) {
+    std::vector<Value> values;
+    for (uint32_t j = 0; j < 4; j++) {
+      values.push_back(ValueFactory::GetIntegerValue((i * (j + 7)) % 1000));
+    }
+    tuples.emplace_back(values, &table_info->schema_);
+  }
+  std::vector<RID> rids;
+  ASSERT_TRUE(table_info->table_->BulkInsert(tuples, &rids, &txn));
+
+  ColumnValueExpression c1(0, 1, TypeId::INTEGER);
+  ConstantValueExpression const500(ValueFactory::GetIntegerValue(500));
+  ComparisonExpression predicate(&c1, &const500, ComparisonType::LessThan);
+  const Schema *schema = &table_info->schema_;
+  auto report = [](const char *name, size_t count, size_t allocations, std::chrono::steady_clock::time_point start) {
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << us << " us, " << count << " matches, " << allocations << " heap allocations"
+              << std::endl;
+  };
+
+  // heap: every match takes memory of its own
+  auto start = std::chrono::steady_clock::now();
+  size_t heap_count = 0;
+  std::vector<TupleView> views;
+  std::vector<Tuple> matches;
+  {
+    TableBatchIterator iter(table_info->table_.get(), &txn);
+    while (iter.NextBatch(&views)) {
+      matches.clear();
+      for (const auto &view : views) {
+        if (predicate.Evaluate(&view.AsTuple(), schema).GetAs<bool>()) {
+          matches.push_back(view.ToTuple());
+        }
+      }
+      iter.ReleasePage();
+      heap_count += matches.size();
+    }
+  }
+  report("heap", heap_count, heap_count, start);
+
+  // arena: the matches of a page are carved out of chunks that are reused for the next page
+  ArenaPool arena;
+  start = std::chrono::steady_clock::now();
+  size_t arena_count = 0;
+  {
+    TableBatchIterator iter(table_info->table_.get(), &txn);
+    while (iter.NextBatch(&views)) {
+      matches.clear();
+      arena.Reset();
+      for (const auto &view : views) {
+        if (predicate.Evaluate(&view.AsTuple(), schema).GetAs<bool>()) {
+          matches.push_back(view.ToTuple(&arena));
+        }
+      }
+      iter.ReleasePage();
+      arena_count += matches.size();
+    }
+  }
+  report("arena", arena_count, arena.GetNumChunkAllocations(), start);
+  EXPECT_EQ(heap_count, arena_count);
+  EXPECT_EQ(arena_count, arena.GetNumAllocations());
+
+  // the whole query, with the arena the scan takes from the executor context
+  Schema out_schema({Column("c1", TypeId::INTEGER, &c1)});
+  SeqScanPlanNode plan{&out_schema, &predicate, table_info->oid_};
+  SeqScanExecutor executor(&exec_ctx, &plan);
+  start = std::chrono::steady_clock::now();
+  executor.Init();
+  size_t query_count = 0;
+  Tuple tuple;
+  while (executor.Next(&tuple)) {
+    query_count++;
+  }
+  report("query", query_count, exec_ctx.GetNumArenaChunkAllocations(), start);
+  EXPECT_EQ(arena_count, query_count);
+  EXPECT_EQ(query_count, exec_ctx.GetNumArenaAllocations());
+
+  disk_manager->ShutDown();
+  remove("executor_benchmark.db");
+}
+
+// NOLINTNEXTLINE
+TEST(SeqScanBenchmark, DISABLED_StringPredicateBenchmark) {
+  // WHERE s = 'constant', over a short and a long VARCHAR column, copying the operands or comparing views of them
+  auto disk_manager = std::make_unique<DiskManager>("executor_benchmark.db");
+  auto bpm = std::make_unique<BufferPoolManager>(4096, disk_manager.get());
+  SimpleCatalog catalog(bpm.get(), nullptr, nullptr);
+  Transaction txn(0);
+  Schema schema({Column("short", TypeId::VARCHAR, 16), Column("long", TypeId::VARCHAR, 64)});
+  TableMetadata *table_info = catalog.CreateTable(&txn, "t", schema);
+  const int num_tuples = 400000;
+  std::vector<Tuple> tuples;
+  for (int i = 0; i < num_tuples; i++) {
+    std::string key = std::to_string(i % 1000);
+    tuples.emplace_back(std::vector<Value>{ValueFactory::GetVarcharValue("k" + key),
+                                           ValueFactory::GetVarcharValue("a rather long string, number " + key)},
+                        &table_info->schema_);
+  }
+  std::vector<RID> rids;
+  ASSERT_TRUE(table_info->table_->BulkInsert(tuples, &rids, &txn));
+
+  auto run = [&](const char *name, uint32_t col_idx, const std::string &constant, bool copy) {
+    ColumnValueExpression column(0, col_idx, TypeId::VARCHAR);
+    ConstantValueExpression value(ValueFactory::GetVarcharValue(constant));
+    ComparisonExpression predicate(&column, &value, ComparisonType::Equal);
+    const Schema *schema = &table_info->schema_;
+    auto start = std::chrono::steady_clock::now();
+    size_t count = 0;
+    std::vector<TupleView> views;
+    TableBatchIterator iter(table_info->table_.get(), &txn);
+    while (iter.NextBatch(&views)) {
+      for (const auto &view : views) {
+        const Tuple *tuple = &view.AsTuple();
+        if (copy) {
+          // how predicates were evaluated before: both operands are copied out
+          Value lhs = column.Evaluate(tuple, schema);
+          Value rhs = value.Evaluate(tuple, schema);
+          count += ValueFactory::GetBooleanValue(lhs.CompareEquals(rhs)).GetAs<bool>() ? 1 : 0;
+        } else {
+          count += predicate.Evaluate(tuple, schema).GetAs<bool>() ? 1 : 0;
+        }
+      }
+    }
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << us << " us, " << int64_t{num_tuples} * 1000000 / std::max<int64_t>(us, 1)
+              << " tuples/sec" << std::endl;
+    return count;
+  };
+
+  const size_t expected = num_tuples / 1000;
+  EXPECT_EQ(expected, run("short, copied", 0, "k42", true));
+  EXPECT_EQ(expected, run("short, viewed", 0, "k42", false));
+  EXPECT_EQ(expected, run("long, copied", 1, "a rather long string, number 42", true));
+  EXPECT_EQ(expected, run("long, viewed", 1, "a rather long string, number 42", false));
+
+  disk_manager->ShutDown();
+  remove("executor_benchmark.db");
+}
+
+// NOLINTNEXTLINE
+TEST(ExpressionBenchmark, DISABLED_ComparisonKernelBenchmark) {
+  // WHERE c0 < c1, over INTEGER, BIGINT, DECIMAL and TIMESTAMP columns, through the Value methods and the kernels
+  const int num_tuples = 400000;
+  for (TypeId type_id : {TypeId::INTEGER, TypeId::BIGINT, TypeId::DECIMAL, TypeId::TIMESTAMP}) {
+    Schema schema({Column("c0", type_id), Column("c1", type_id)});
+    auto make_value = [type_id](int i) {
+      return type_id == TypeId::TIMESTAMP ? ValueFactory::GetTimestampValue(i)
+                                          : ValueFactory::GetIntegerValue(i).CastAs(type_id);
+    };
+    std::vector<Tuple> tuples;
+    tuples.reserve(num_tuples);
+    for (int i = 0; i < num_tuples; i++) {
+      tuples.emplace_back(std::vector<Value>{make_value(i % 1000), make_value(500)}, &schema);
+    }
+    ColumnValueExpression c0(0, 0, type_id);
+    ColumnValueExpression c1(0, 1, type_id);
+    ComparisonExpression predicate(&c0, &c1, ComparisonType::LessThan);
+    ASSERT_TRUE(predicate.HasKernel());
+
+    auto run = [&](const char *name, bool use_kernel) {
+      auto start = std::chrono::steady_clock::now();
+      size_t count = 0;
+      for (const auto &tuple : tuples) {
+        if (use_kernel) {
+          count += predicate.Evaluate(&tuple, &schema).GetAs<bool>() ? 1 : 0;
+        } else {
+          // how predicates were evaluated before: through the Type of the left value
+          Value lhs = c0.Evaluate(&tuple, &schema);
+          Value rhs = c1.Evaluate(&tuple, &schema);
+          count += ValueFactory::GetBooleanValue(lhs.CompareLessThan(rhs)).GetAs<bool>() ? 1 : 0;
+        }
+      }
+      auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+      std::cout << Type::TypeIdToString(type_id) << ", " << name << ": " << ns / num_tuples << " ns/row" << std::endl;
+      return count;
+    };
+    const size_t expected = num_tuples / 2;
+    EXPECT_EQ(expected, run("Value methods", false));
+    EXPECT_EQ(expected, run("kernel", true));
+  }
+}
+
 // NOLINTNEXTLINE
 TEST_F(ExecutorTest, SimpleHashJoinTest) {
   // INSERT INTO empty_table2 SELECT colA, colB FROM test_1 WHERE colA < 500
@@ -0,0 +1,192 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_concurrent_test.cpp
+//
+// Identification: test/storage/b_plus_tree_concurrent_test.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "gtest/gtest.h"
+#include "storage/index/b_plus_tree.h"
+
+namespace bustub {
+
+using Tree = BPlusTree<GenericKey<8>, RID, GenericComparator<8>>;
+
+// helper function to launch multiple threads
+template <typename... Args>
+void LaunchParallelTest(uint64_t num_threads, Args &&... args) {
+  std::vector<std::thread> thread_group;
+
+  // Launch a group of threads
+  for (uint64_t thread_itr = 0; thread_itr < num_threads; ++thread_itr) {
+    thread_group.push_back(std::thread(args..., thread_itr));
+  }
+
+  // Join the threads with the main thread
+  for (uint64_t thread_itr = 0; thread_itr < num_threads; ++thread_itr) {
+    thread_group[thread_itr].join();
+  }
+}
+
+// inserts the keys key_id with key_id % total_threads == thread_itr
+void InsertHelper(Tree *tree, int64_t num_keys, uint64_t total_threads, uint64_t thread_itr) {
+  GenericKey<8> index_key;
+  Transaction transaction(static_cast<txn_id_t>(thread_itr));
+  for (int64_t key = 0; key < num_keys; key++) {
+    if (static_cast<uint64_t>(key) % total_threads == thread_itr) {
+      index_key.SetFromInteger(key);
+      tree->Insert(index_key, RID(0, static_cast<uint32_t>(key)), &transaction);
+    }
+  }
+}
+
+// removes the keys key_id with key_id % total_threads == thread_itr
+void DeleteHelper(Tree *tree, int64_t num_keys, uint64_t total_threads, uint64_t thread_itr) {
+  GenericKey<8> index_key;
+  Transaction transaction(static_cast<txn_id_t>(thread_itr));
+  for (int64_t key = 0; key < num_keys; key++) {
+    if (static_cast<uint64_t>(key) % total_threads == thread_itr) {
+      index_key.SetFromInteger(key);
+      tree->Remove(index_key, &transaction);
+    }
+  }
+}
+
+// looks up every key, expecting all of them to be present
+void LookupHelper(Tree *tree, int64_t num_keys, uint64_t thread_itr) {
+  GenericKey<8> index_key;
+  for (int64_t i = 0; i < num_keys; i++) {
+    int64_t key = (i + static_cast<int64_t>(thread_itr) * 997) % num_keys;
+    std::vector<RID> rids;
+    index_key.SetFromInteger(key);
+    EXPECT_TRUE(tree->GetValue(index_key, &rids));
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeConcurrentTest, InsertTest) {
+  Schema key_schema({Column("a", TypeId::BIGINT)});
+  GenericComparator<8> comparator(&key_schema);
+
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+  Tree tree("foo_pk", bpm, comparator, 8, 8);
+
+  const int64_t num_keys = 5000;
+  LaunchParallelTest(4, InsertHelper, &tree, num_keys, 4);
+  tree.VerifyIntegrity();
+
+  int64_t expected = 0;
+  for (auto iter = tree.Begin(); !iter.IsEnd(); ++iter) {
+    EXPECT_EQ(expected, (*iter).first.ToString());
+    expected++;
+  }
+  EXPECT_EQ(num_keys, expected);
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeConcurrentTest, MixedTest) {
+  Schema key_schema({Column("a", TypeId::BIGINT)});
+  GenericComparator<8> comparator(&key_schema);
+
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+  Tree tree("foo_pk", bpm, comparator, 4, 4);
+
+  // the lower half of the keys stays, the upper half is inserted and deleted again while scans run
+  const int64_t num_keys = 2000;
+  LaunchParallelTest(1, InsertHelper, &tree, num_keys / 2, 1);
+
+  std::vector<std::thread> threads;
+  threads.emplace_back([&tree] {
+    GenericKey<8> index_key;
+    for (int64_t key = num_keys / 2; key < num_keys; key++) {
+      index_key.SetFromInteger(key);
+      tree.Insert(index_key, RID(0, static_cast<uint32_t>(key)));
+    }
+    for (int64_t key = num_keys / 2; key < num_keys; key++) {
+      index_key.SetFromInteger(key);
+      tree.Remove(index_key);
+    }
+  });
+  for (int t = 0; t < 2; t++) {
+    threads.emplace_back([&tree] {
+      for (int round = 0; round < 5; round++) {
+        // a scan sees every stable key exactly once and in order
+        int64_t expected = 0;
+        for (auto iter = tree.Begin(); !iter.IsEnd(); ++iter) {
+          int64_t key = (*iter).first.ToString();
+          if (key >= num_keys / 2) {
+            continue;
+          }
+          EXPECT_EQ(expected, key);
+          expected++;
+        }
+        EXPECT_EQ(num_keys / 2, expected);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  tree.VerifyIntegrity();
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeConcurrentTest, DISABLED_InsertLookupBenchmark) {
+  Schema key_schema({Column("a", TypeId::BIGINT)});
+  GenericComparator<8> comparator(&key_schema);
+
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(100, disk_manager);
+  Tree tree("foo_pk", bpm, comparator);
+
+  const int64_t num_keys = 20000;
+  for (uint64_t num_threads : {1, 4}) {
+    auto start = std::chrono::steady_clock::now();
+    LaunchParallelTest(num_threads, InsertHelper, &tree, num_keys, num_threads);
+    auto inserted = std::chrono::steady_clock::now();
+    LaunchParallelTest(num_threads, LookupHelper, &tree, num_keys);
+    auto looked_up = std::chrono::steady_clock::now();
+    LaunchParallelTest(num_threads, DeleteHelper, &tree, num_keys, num_threads);
+    auto deleted = std::chrono::steady_clock::now();
+    EXPECT_TRUE(tree.IsEmpty());
+
+    auto ms = [](auto from, auto to) {
+      return std::chrono::duration_cast<std::chrono::milliseconds>(to - from).count();
+    };
+    std::cout << num_threads << " thread(s): insert " << ms(start, inserted) << " ms, lookup x" << num_threads << " "
+              << ms(inserted, looked_up) << " ms, delete " << ms(looked_up, deleted) << " ms for " << num_keys
+              << " keys" << std::endl;
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+}  // namespace bustub
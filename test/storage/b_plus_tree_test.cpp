@@ -0,0 +1,335 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_test.cpp
+//
+// Identification: test/storage/b_plus_tree_test.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "gtest/gtest.h"
+#include "storage/index/b_plus_tree.h"
+#include "storage/index/b_plus_tree_index.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeTests, InsertTest) {
+  Schema key_schema({Column("a", TypeId::BIGINT)});
+  GenericComparator<8> comparator(&key_schema);
+
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+  // small pages so a few keys already split leaves and internal pages
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator, 3, 3);
+  EXPECT_TRUE(tree.IsEmpty());
+
+  std::vector<int64_t> keys;
+  for (int64_t key = 1; key <= 200; key++) {
+    keys.push_back(key);
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(15445));
+
+  GenericKey<8> index_key;
+  for (auto key : keys) {
+    index_key.SetFromInteger(key);
+    EXPECT_TRUE(tree.Insert(index_key, RID(static_cast<int32_t>(key >> 32), static_cast<uint32_t>(key))));
+  }
+  tree.VerifyIntegrity();
+
+  // duplicate keys are rejected
+  index_key.SetFromInteger(keys[0]);
+  EXPECT_FALSE(tree.Insert(index_key, RID(0, 0)));
+
+  for (auto key : keys) {
+    std::vector<RID> rids;
+    index_key.SetFromInteger(key);
+    EXPECT_TRUE(tree.GetValue(index_key, &rids));
+    ASSERT_EQ(1, rids.size());
+    EXPECT_EQ(key, rids[0].GetSlotNum());
+  }
+
+  std::vector<RID> rids;
+  index_key.SetFromInteger(1000);
+  EXPECT_FALSE(tree.GetValue(index_key, &rids));
+  EXPECT_EQ(0, rids.size());
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeTests, IteratorTest) {
+  Schema key_schema({Column("a", TypeId::BIGINT)});
+  GenericComparator<8> comparator(&key_schema);
+
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator, 4, 4);
+  EXPECT_TRUE(tree.Begin() == tree.End());
+
+  // even keys only
+  GenericKey<8> index_key;
+  for (int64_t key = 100; key > 0; key--) {
+    index_key.SetFromInteger(2 * key);
+    EXPECT_TRUE(tree.Insert(index_key, RID(0, static_cast<uint32_t>(2 * key))));
+  }
+
+  int64_t expected = 2;
+  for (auto iter = tree.Begin(); iter != tree.End(); ++iter) {
+    EXPECT_EQ(expected, (*iter).first.ToString());
+    EXPECT_EQ(expected, (*iter).second.GetSlotNum());
+    expected += 2;
+  }
+  EXPECT_EQ(202, expected);
+
+  // range scan starting between two keys
+  index_key.SetFromInteger(51);
+  expected = 52;
+  for (auto iter = tree.Begin(index_key); !iter.IsEnd(); ++iter) {
+    EXPECT_EQ(expected, (*iter).first.ToString());
+    expected += 2;
+  }
+  EXPECT_EQ(202, expected);
+
+  // starting past the last key
+  index_key.SetFromInteger(500);
+  EXPECT_TRUE(tree.Begin(index_key).IsEnd());
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeTests, DeleteTest) {
+  Schema key_schema({Column("a", TypeId::BIGINT)});
+  GenericComparator<8> comparator(&key_schema);
+
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator, 3, 3);
+
+  std::vector<int64_t> keys;
+  for (int64_t key = 1; key <= 300; key++) {
+    keys.push_back(key);
+  }
+  std::mt19937 rng(15445);
+  std::shuffle(keys.begin(), keys.end(), rng);
+
+  GenericKey<8> index_key;
+  for (auto key : keys) {
+    index_key.SetFromInteger(key);
+    tree.Insert(index_key, RID(0, static_cast<uint32_t>(key)));
+  }
+
+  // delete the odd keys in a different random order, coalescing and redistributing along the way
+  std::shuffle(keys.begin(), keys.end(), rng);
+  for (auto key : keys) {
+    if (key % 2 == 1) {
+      index_key.SetFromInteger(key);
+      tree.Remove(index_key);
+    }
+  }
+  tree.VerifyIntegrity();
+
+  // removing a missing key is a no-op
+  index_key.SetFromInteger(1);
+  tree.Remove(index_key);
+
+  for (int64_t key = 1; key <= 300; key++) {
+    std::vector<RID> rids;
+    index_key.SetFromInteger(key);
+    EXPECT_EQ(key % 2 == 0, tree.GetValue(index_key, &rids)) << "Wrong result for " << key;
+  }
+
+  // the tree shrinks back to nothing
+  for (auto key : keys) {
+    index_key.SetFromInteger(key);
+    tree.Remove(index_key);
+  }
+  EXPECT_TRUE(tree.IsEmpty());
+  EXPECT_TRUE(tree.Begin() == tree.End());
+
+  // and grows again
+  index_key.SetFromInteger(42);
+  EXPECT_TRUE(tree.Insert(index_key, RID(0, 42)));
+  tree.VerifyIntegrity();
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeTests, BulkLoadTest) {
+  Schema key_schema({Column("a", TypeId::BIGINT)});
+  GenericComparator<8> comparator(&key_schema);
+
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator, 4, 5);
+
+  // shuffled keys, a duplicate among them loads nothing
+  std::vector<std::pair<GenericKey<8>, RID>> entries;
+  GenericKey<8> index_key;
+  for (int64_t key = 0; key < 1000; key++) {
+    index_key.SetFromInteger(key);
+    entries.emplace_back(index_key, RID(0, static_cast<uint32_t>(key)));
+  }
+  entries.emplace_back(entries[10].first, RID(1, 10));
+  std::shuffle(entries.begin(), entries.end(), std::mt19937(15445));
+  EXPECT_FALSE(tree.BulkLoad(&entries));
+  EXPECT_TRUE(tree.IsEmpty());
+
+  entries.erase(
+      std::find_if(entries.begin(), entries.end(), [](const auto &entry) { return entry.second == RID(1, 10); }));
+  EXPECT_TRUE(tree.BulkLoad(&entries));
+  tree.VerifyIntegrity();
+
+  int64_t expected = 0;
+  for (auto iter = tree.Begin(); !iter.IsEnd(); ++iter) {
+    EXPECT_EQ(expected, (*iter).first.ToString());
+    expected++;
+  }
+  EXPECT_EQ(1000, expected);
+
+  // the packed tree keeps working with regular inserts and removes
+  for (int64_t key = 1000; key < 1100; key++) {
+    index_key.SetFromInteger(key);
+    EXPECT_TRUE(tree.Insert(index_key, RID(0, static_cast<uint32_t>(key))));
+  }
+  for (int64_t key = 0; key < 1100; key += 2) {
+    index_key.SetFromInteger(key);
+    tree.Remove(index_key);
+  }
+  tree.VerifyIntegrity();
+  for (int64_t key = 0; key < 1100; key++) {
+    std::vector<RID> rids;
+    index_key.SetFromInteger(key);
+    EXPECT_EQ(key % 2 == 1, tree.GetValue(index_key, &rids));
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeTests, IndexBulkLoadTest) {
+  Schema schema({Column("a", TypeId::BIGINT), Column("b", TypeId::INTEGER)});
+
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+  Transaction transaction(0);
+  TableHeap table(bpm, nullptr, nullptr, &transaction);
+
+  const int64_t num_rows = 10000;
+  for (int64_t i = 0; i < num_rows; i++) {
+    RID rid;
+    Tuple tuple({ValueFactory::GetBigIntValue(num_rows - i), ValueFactory::GetIntegerValue(static_cast<int32_t>(i))},
+                &schema);
+    ASSERT_TRUE(table.InsertTuple(tuple, &rid, &transaction));
+  }
+
+  auto build = [&](bool bulk) {
+    auto *metadata = new IndexMetadata("a_idx", "t", &schema, {0});
+    auto index = std::make_unique<BPlusTreeIndex<GenericKey<8>, RID, GenericComparator<8>>>(metadata, bpm);
+    auto start = std::chrono::steady_clock::now();
+    if (bulk) {
+      index->BulkLoad(&table, schema, &transaction);
+    } else {
+      for (auto iter = table.Begin(&transaction); iter != table.End(); ++iter) {
+        index->InsertEntry(iter->KeyFromTuple(schema, *metadata->GetKeySchema(), {0}), iter->GetRid(), &transaction);
+      }
+    }
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << (bulk ? "bulk load: " : "row at a time: ") << ms << " ms for " << num_rows << " rows" << std::endl;
+    return index;
+  };
+  auto row_index = build(false);
+  auto bulk_index = build(true);
+
+  Schema key_schema({Column("a", TypeId::BIGINT)});
+  for (int64_t key = 1; key <= num_rows; key += 7) {
+    Tuple key_tuple({ValueFactory::GetBigIntValue(key)}, &key_schema);
+    std::vector<RID> bulk_rids;
+    std::vector<RID> row_rids;
+    bulk_index->ScanKey(key_tuple, &bulk_rids, &transaction);
+    row_index->ScanKey(key_tuple, &row_rids, &transaction);
+    ASSERT_EQ(1, bulk_rids.size());
+    EXPECT_EQ(row_rids, bulk_rids);
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(BPlusTreeTests, IndexDuplicateKeyTest) {
+  Schema schema({Column("a", TypeId::BIGINT), Column("b", TypeId::INTEGER)});
+  Schema key_schema({Column("a", TypeId::BIGINT)});
+
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManager(50, disk_manager);
+  Transaction transaction(0);
+  TableHeap table(bpm, nullptr, nullptr, &transaction);
+  for (int32_t i = 0; i < 3; i++) {
+    RID rid;
+    Tuple tuple({ValueFactory::GetBigIntValue(i % 2), ValueFactory::GetIntegerValue(i)}, &schema);
+    ASSERT_TRUE(table.InsertTuple(tuple, &rid, &transaction));
+  }
+
+  // a second RID for a key is reported instead of dropped
+  auto *metadata = new IndexMetadata("a_idx", "t", &schema, {0});
+  BPlusTreeIndex<GenericKey<8>, RID, GenericComparator<8>> index(metadata, bpm);
+  Tuple key({ValueFactory::GetBigIntValue(1)}, &key_schema);
+  index.InsertEntry(key, RID(0, 1), &transaction);
+  Transaction other(1);
+  EXPECT_THROW(index.InsertEntry(key, RID(0, 2), &other), Exception);
+  EXPECT_EQ(TransactionState::ABORTED, other.GetState());
+
+  // only the entry of the given RID is deleted
+  index.DeleteEntry(key, RID(0, 2), &transaction);
+  std::vector<RID> rids;
+  index.ScanKey(key, &rids, &transaction);
+  EXPECT_EQ(std::vector<RID>{RID(0, 1)}, rids);
+  index.DeleteEntry(key, RID(0, 1), &transaction);
+  rids.clear();
+  index.ScanKey(key, &rids, &transaction);
+  EXPECT_TRUE(rids.empty());
+
+  // so is a bulk load of a column with a duplicate
+  auto *bulk_metadata = new IndexMetadata("a_idx", "t", &schema, {0});
+  BPlusTreeIndex<GenericKey<8>, RID, GenericComparator<8>> bulk_index(bulk_metadata, bpm);
+  Transaction loader(2);
+  EXPECT_THROW(bulk_index.BulkLoad(&table, schema, &loader), Exception);
+  EXPECT_EQ(TransactionState::ABORTED, loader.GetState());
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+}  // namespace bustub
@@ -0,0 +1,173 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// generic_key_test.cpp
+//
+// Identification: test/storage/generic_key_test.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "storage/index/generic_key.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+/** The Value based comparison GenericComparator used for every schema, on keys in the plain tuple layout. */
+template <size_t KeySize>
+int ValueCompare(Schema *key_schema, const GenericKey<KeySize> &lhs, const GenericKey<KeySize> &rhs) {
+  for (uint32_t i = 0; i < key_schema->GetColumnCount(); i++) {
+    Value lhs_value = lhs.ToValue(key_schema, i);
+    Value rhs_value = rhs.ToValue(key_schema, i);
+    if (lhs_value.CompareLessThan(rhs_value) == CmpBool::CmpTrue) {
+      return -1;
+    }
+    if (lhs_value.CompareGreaterThan(rhs_value) == CmpBool::CmpTrue) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+std::string RandomString(std::mt19937 *gen) {
+  // a tiny alphabet with an embedded '\0' gives plenty of equal strings and common prefixes
+  const char alphabet[] = {'a', 'b', '\0'};
+  std::string str;
+  for (size_t len = (*gen)() % 6; len > 0; len--) {
+    str.push_back(alphabet[(*gen)() % sizeof(alphabet)]);
+  }
+  return str;
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(GenericKeyTest, FixedWidthCompareTest) {
+  Schema key_schema({Column("a", TypeId::INTEGER), Column("b", TypeId::BIGINT), Column("c", TypeId::SMALLINT)});
+  GenericComparator<16> comparator(&key_schema);
+  EXPECT_EQ(KeyCompareMode::FIXED_WIDTH, comparator.GetMode());
+
+  std::mt19937 gen(42);
+  std::vector<GenericKey<16>> keys(200);
+  for (auto &key : keys) {
+    // small ranges so later columns decide often
+    std::vector<Value> values{ValueFactory::GetIntegerValue(static_cast<int32_t>(gen() % 5) - 2),
+                              ValueFactory::GetBigIntValue(static_cast<int64_t>(gen() % 5) - 2),
+                              ValueFactory::GetSmallIntValue(static_cast<int16_t>(gen() % 5) - 2)};
+    key.SetFromKey(Tuple(values, &key_schema), key_schema);
+  }
+
+  for (const auto &lhs : keys) {
+    for (const auto &rhs : keys) {
+      ASSERT_EQ(ValueCompare(&key_schema, lhs, rhs), comparator(lhs, rhs));
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(GenericKeyTest, KeySizeTest) {
+  // a comparator is only built for schemas whose keys fit into the key size
+  Schema int_schema({Column("a", TypeId::INTEGER)});
+  Schema bigint_schema({Column("a", TypeId::BIGINT)});
+  GenericComparator<4> comparator(&int_schema);
+  EXPECT_THROW(GenericComparator<4>{&bigint_schema}, Exception);
+
+  GenericKey<4> lhs;
+  GenericKey<4> rhs;
+  lhs.SetFromKey(Tuple({ValueFactory::GetIntegerValue(-1)}, &int_schema), int_schema);
+  rhs.SetFromKey(Tuple({ValueFactory::GetIntegerValue(1)}, &int_schema), int_schema);
+  EXPECT_EQ(-1, comparator(lhs, rhs));
+  EXPECT_EQ(0, comparator(lhs, lhs));
+
+  // a normalized varchar grows with its value, a key that does not fit is rejected instead of overflowing
+  Schema varchar_schema({Column("a", TypeId::VARCHAR, 8)});
+  GenericKey<8> key;
+  key.SetFromKey(Tuple({ValueFactory::GetVarcharValue("abcdef")}, &varchar_schema), varchar_schema);
+  EXPECT_THROW(
+      key.SetFromKey(Tuple({ValueFactory::GetVarcharValue("abcdefg")}, &varchar_schema), varchar_schema),
+      Exception);
+  EXPECT_THROW(key.SetFromKey(Tuple({ValueFactory::GetVarcharValue(std::string(100, 'x'))}, &varchar_schema),
+                              varchar_schema),
+               Exception);
+}
+
+// NOLINTNEXTLINE
+TEST(GenericKeyTest, NormalizedCompareTest) {
+  Schema key_schema({Column("a", TypeId::INTEGER), Column("b", TypeId::VARCHAR, 8), Column("c", TypeId::DECIMAL)});
+  GenericComparator<32> comparator(&key_schema);
+  EXPECT_EQ(KeyCompareMode::NORMALIZED, comparator.GetMode());
+
+  std::mt19937 gen(42);
+  std::vector<GenericKey<32>> raw_keys(200);
+  std::vector<GenericKey<32>> keys(raw_keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    std::vector<Value> values{ValueFactory::GetIntegerValue(static_cast<int32_t>(gen() % 3) - 1),
+                              ValueFactory::GetVarcharValue(RandomString(&gen)),
+                              ValueFactory::GetDecimalValue(static_cast<double>(gen() % 5) - 2.5)};
+    Tuple tuple(values, &key_schema);
+    raw_keys[i].SetFromKey(tuple);
+    keys[i].SetFromKey(tuple, key_schema);
+  }
+
+  // the normalized keys order exactly like the columns do
+  for (size_t i = 0; i < keys.size(); i++) {
+    for (size_t j = 0; j < keys.size(); j++) {
+      ASSERT_EQ(ValueCompare(&key_schema, raw_keys[i], raw_keys[j]), comparator(keys[i], keys[j]))
+          << "keys " << i << " and " << j << std::endl;
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(GenericKeyTest, DISABLED_ComparatorBenchmark) {
+  Schema int_schema({Column("a", TypeId::BIGINT)});
+  Schema mixed_schema({Column("a", TypeId::INTEGER), Column("b", TypeId::VARCHAR, 8)});
+  std::mt19937 gen(42);
+
+  const int num_keys = 100000;
+  for (Schema *key_schema : {&int_schema, &mixed_schema}) {
+    std::vector<GenericKey<32>> raw_keys(num_keys);
+    std::vector<GenericKey<32>> keys(num_keys);
+    for (int i = 0; i < num_keys; i++) {
+      std::vector<Value> values{ValueFactory::GetBigIntValue(static_cast<int64_t>(gen()))};
+      if (key_schema == &mixed_schema) {
+        values = {ValueFactory::GetIntegerValue(static_cast<int32_t>(gen() % 100)),
+                  ValueFactory::GetVarcharValue(std::to_string(gen()))};
+      }
+      Tuple tuple(values, key_schema);
+      raw_keys[i].SetFromKey(tuple);
+      keys[i].SetFromKey(tuple, *key_schema);
+    }
+
+    GenericComparator<32> comparator(key_schema);
+    auto start = std::chrono::steady_clock::now();
+    std::sort(raw_keys.begin(), raw_keys.end(), [key_schema](const GenericKey<32> &lhs, const GenericKey<32> &rhs) {
+      return ValueCompare(key_schema, lhs, rhs) < 0;
+    });
+    auto value_sorted = std::chrono::steady_clock::now();
+    std::sort(keys.begin(), keys.end(),
+              [&comparator](const GenericKey<32> &lhs, const GenericKey<32> &rhs) { return comparator(lhs, rhs) < 0; });
+    auto specialized_sorted = std::chrono::steady_clock::now();
+
+    auto ms = [](auto from, auto to) {
+      return std::chrono::duration_cast<std::chrono::milliseconds>(to - from).count();
+    };
+    std::cout << (key_schema == &int_schema ? "bigint" : "integer, varchar") << " keys: Value compare "
+              << ms(start, value_sorted) << " ms, specialized compare " << ms(value_sorted, specialized_sorted)
+              << " ms for sorting " << num_keys << " keys" << std::endl;
+  }
+}
+
+}  // namespace bustub
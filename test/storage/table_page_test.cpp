@@ -0,0 +1,123 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_page_test.cpp
+//
+// Identification: test/storage/table_page_test.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>  // NOLINT
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "storage/page/table_page.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+Tuple MakeTuple(const Schema &schema, int32_t a, const std::string &b) {
+  return Tuple({ValueFactory::GetIntegerValue(a), ValueFactory::GetVarcharValue(b)}, &schema);
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(TablePageTest, SlotReuseTest) {
+  Schema schema{{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 64}}};
+  TablePage page{};
+  page.Init(0, PAGE_SIZE, INVALID_PAGE_ID, nullptr, nullptr);
+  uint32_t empty_space = page.GetFreeSpaceRemaining();
+
+  // fill the page with tuples of different sizes
+  std::map<uint32_t, std::string> live;  // slot -> b
+  RID rid;
+  int32_t a = 0;
+  while (page.InsertTuple(MakeTuple(schema, a, std::string(a % 32, 'x')), &rid, nullptr, nullptr, nullptr)) {
+    EXPECT_EQ(static_cast<uint32_t>(a), rid.GetSlotNum());
+    live[rid.GetSlotNum()] = std::string(a % 32, 'x');
+    a++;
+  }
+  uint32_t num_slots = live.size();
+
+  // delete every other tuple, the freed space is counted right away
+  uint32_t free_space = page.GetFreeSpaceRemaining();
+  for (uint32_t slot = 0; slot < num_slots; slot += 2) {
+    Tuple tuple;
+    ASSERT_TRUE(page.GetTuple(RID(0, slot), &tuple, nullptr, nullptr));
+    page.ApplyDelete(RID(0, slot), nullptr, nullptr);
+    free_space += tuple.GetLength();
+    EXPECT_EQ(free_space, page.GetFreeSpaceRemaining());
+    live.erase(slot);
+  }
+
+  // refill it, the emptied slots are reused in reverse order and the holes are compacted away
+  uint32_t expected_slot = (num_slots - 1) / 2 * 2;
+  while (page.InsertTuple(MakeTuple(schema, a, std::string(a % 32, 'y')), &rid, nullptr, nullptr, nullptr)) {
+    EXPECT_EQ(expected_slot, rid.GetSlotNum());
+    live[rid.GetSlotNum()] = std::string(a % 32, 'y');
+    a++;
+    if (expected_slot == 0) {
+      break;
+    }
+    expected_slot -= 2;
+  }
+  for (const auto &[slot, value] : live) {
+    Tuple tuple;
+    ASSERT_TRUE(page.GetTuple(RID(0, slot), &tuple, nullptr, nullptr));
+    EXPECT_EQ(value, tuple.GetValue(&schema, 1).ToString());
+  }
+
+  // deleting everything gives back all of the space but the slots
+  for (const auto &entry : live) {
+    page.ApplyDelete(RID(0, entry.first), nullptr, nullptr);
+  }
+  EXPECT_EQ(empty_space - 8 * num_slots, page.GetFreeSpaceRemaining());
+  RID first;
+  EXPECT_FALSE(page.GetFirstTupleRid(&first));
+}
+
+// NOLINTNEXTLINE
+TEST(TablePageTest, DISABLED_ChurnBenchmark) {
+  Schema schema{{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 64}}};
+  TablePage page{};
+  page.Init(0, PAGE_SIZE, INVALID_PAGE_ID, nullptr, nullptr);
+
+  // a half full page of queue entries, then every round removes a random entry and enqueues a new one
+  std::vector<RID> rids;
+  RID rid;
+  int32_t a = 0;
+  while (page.GetFreeSpaceRemaining() > PAGE_SIZE / 2) {
+    ASSERT_TRUE(page.InsertTuple(MakeTuple(schema, a, std::string(16, 'x')), &rid, nullptr, nullptr, nullptr));
+    rids.push_back(rid);
+    a++;
+  }
+  std::mt19937 gen(0);
+  const int num_rounds = 200000;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_rounds; i++) {
+    size_t victim = gen() % rids.size();
+    page.ApplyDelete(rids[victim], nullptr, nullptr);
+    ASSERT_TRUE(page.InsertTuple(MakeTuple(schema, a, std::string(16, 'x')), &rids[victim], nullptr, nullptr, nullptr));
+    a++;
+  }
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+  std::cout << num_rounds << " delete/insert pairs on a page of " << rids.size() << " tuples: " << us << " us"
+            << std::endl;
+
+  for (const auto &live_rid : rids) {
+    Tuple tuple;
+    ASSERT_TRUE(page.GetTuple(live_rid, &tuple, nullptr, nullptr));
+  }
+}
+
+}  // namespace bustub
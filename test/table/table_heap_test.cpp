@@ -0,0 +1,723 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_heap_test.cpp
+//
+// Identification: test/table/table_heap_test.cpp
+//
+// Copyright (c) 2015-2019, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <iostream>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "concurrency/transaction.h"
+#include "concurrency/transaction_manager.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "gtest/gtest.h"
+#include "storage/table/overflow_chain.h"
+#include "storage/table/table_batch_iterator.h"
+#include "storage/table/table_heap.h"
+#include "storage/table/tuple.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, FreeSpaceMapTest) {
+  Schema schema{{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::BIGINT}}};
+  auto *transaction = new Transaction(0);
+  auto *disk_manager = new DiskManager("test.db");
+  auto *buffer_pool_manager = new BufferPoolManager(50, disk_manager);
+  auto *lock_manager = new LockManager(TwoPLMode::REGULAR, DeadlockMode::PREVENTION);
+  auto *table = new TableHeap(buffer_pool_manager, lock_manager, nullptr, transaction);
+
+  // fill a few pages
+  std::vector<RID> rids;
+  for (int i = 0; i < 2000; i++) {
+    Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetBigIntValue(i)}, &schema);
+    RID rid;
+    ASSERT_TRUE(table->InsertTuple(tuple, &rid, transaction));
+    rids.push_back(rid);
+  }
+  size_t num_pages = table->GetNumPages();
+  EXPECT_LT(1, num_pages);
+  // every page is filled before the next one is appended
+  std::set<page_id_t> page_ids;
+  for (size_t i = 1; i < rids.size(); i++) {
+    if (rids[i].GetPageId() != rids[i - 1].GetPageId()) {
+      EXPECT_TRUE(page_ids.insert(rids[i - 1].GetPageId()).second);
+    }
+  }
+  page_ids.insert(rids.back().GetPageId());
+  EXPECT_EQ(num_pages, page_ids.size());
+
+  // deleting from the first page frees its space for the next insert
+  for (int i = 3; i < 7; i++) {
+    ASSERT_TRUE(table->MarkDelete(rids[i], transaction));
+    table->ApplyDelete(rids[i], transaction);
+  }
+  Tuple tuple({ValueFactory::GetIntegerValue(-1), ValueFactory::GetBigIntValue(-1)}, &schema);
+  RID rid;
+  ASSERT_TRUE(table->InsertTuple(tuple, &rid, transaction));
+  // the most recently emptied slot is reused first
+  EXPECT_EQ(rids[6], rid);
+  EXPECT_EQ(num_pages, table->GetNumPages());
+
+  // the map can be reopened from its pages or rebuilt from the table pages
+  page_id_t first_page_id = table->GetFirstPageId();
+  page_id_t map_page_id = table->GetFreeSpaceMapPageId();
+  delete table;
+  table = new TableHeap(buffer_pool_manager, lock_manager, nullptr, first_page_id, map_page_id);
+  EXPECT_EQ(num_pages, table->GetNumPages());
+  delete table;
+  table = new TableHeap(buffer_pool_manager, lock_manager, nullptr, first_page_id);
+  EXPECT_EQ(num_pages, table->GetNumPages());
+  // the rebuilt map still knows about the space freed on the first page
+  ASSERT_TRUE(table->InsertTuple(tuple, &rid, transaction));
+  EXPECT_EQ(first_page_id, rid.GetPageId());
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete table;
+  delete lock_manager;
+  delete buffer_pool_manager;
+  delete disk_manager;
+  delete transaction;
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, BulkInsertTest) {
+  Schema schema{{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::BIGINT}}};
+  auto *transaction = new Transaction(0);
+  auto *disk_manager = new DiskManager("test.db");
+  auto *buffer_pool_manager = new BufferPoolManager(50, disk_manager);
+  auto *lock_manager = new LockManager(TwoPLMode::REGULAR, DeadlockMode::PREVENTION);
+  auto *table = new TableHeap(buffer_pool_manager, lock_manager, nullptr, transaction);
+
+  // a row inserted one at a time, followed by a bulk insert that fills the rest of its page and several more
+  Tuple first({ValueFactory::GetIntegerValue(-1), ValueFactory::GetBigIntValue(-1)}, &schema);
+  RID first_rid;
+  ASSERT_TRUE(table->InsertTuple(first, &first_rid, transaction));
+  std::vector<Tuple> tuples;
+  for (int i = 0; i < 2000; i++) {
+    tuples.emplace_back(std::vector<Value>{ValueFactory::GetIntegerValue(i), ValueFactory::GetBigIntValue(i)},
+                        &schema);
+  }
+  std::vector<RID> rids;
+  ASSERT_TRUE(table->BulkInsert(tuples, &rids, transaction));
+  ASSERT_EQ(tuples.size(), rids.size());
+  EXPECT_EQ(first_rid.GetPageId(), rids.front().GetPageId());
+  EXPECT_EQ(first_rid.GetSlotNum() + 1, rids.front().GetSlotNum());
+  EXPECT_EQ(tuples.size() + 1, transaction->GetWriteSet()->size());
+
+  for (size_t i = 0; i < rids.size(); i++) {
+    Tuple tuple;
+    ASSERT_TRUE(table->GetTuple(rids[i], &tuple, transaction));
+    EXPECT_EQ(static_cast<int32_t>(i), tuple.GetValue(&schema, 0).GetAs<int32_t>());
+  }
+  size_t num_tuples = 0;
+  for (auto iter = table->Begin(transaction); iter != table->End(); ++iter) {
+    num_tuples++;
+  }
+  EXPECT_EQ(tuples.size() + 1, num_tuples);
+
+  // the pages were packed, so a small insert goes to the last one
+  RID rid;
+  ASSERT_TRUE(table->InsertTuple(first, &rid, transaction));
+  EXPECT_EQ(rids.back().GetPageId(), rid.GetPageId());
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete table;
+  delete lock_manager;
+  delete buffer_pool_manager;
+  delete disk_manager;
+  delete transaction;
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, TupleViewTest) {
+  Schema schema{{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 16}}};
+  auto *transaction = new Transaction(0);
+  auto *disk_manager = new DiskManager("test.db");
+  auto *buffer_pool_manager = new BufferPoolManager(50, disk_manager);
+  auto *lock_manager = new LockManager(TwoPLMode::REGULAR, DeadlockMode::PREVENTION);
+  auto *table = new TableHeap(buffer_pool_manager, lock_manager, nullptr, transaction);
+
+  Tuple tuple({ValueFactory::GetIntegerValue(7), ValueFactory::GetVarcharValue("seven")}, &schema);
+  RID rid;
+  ASSERT_TRUE(table->InsertTuple(tuple, &rid, transaction));
+
+  {
+    // a view reads the tuple where it lies in the page
+    TablePageGuard guard = table->ReadPage(rid.GetPageId());
+    ASSERT_NE(nullptr, guard.GetPage());
+    TupleView view;
+    ASSERT_TRUE(table->GetTupleView(guard, rid, &view, transaction));
+    EXPECT_EQ(rid, view.GetRid());
+    EXPECT_EQ(tuple.GetLength(), view.GetLength());
+    EXPECT_EQ(7, view.GetValue(&schema, 0).GetAs<int32_t>());
+    EXPECT_EQ("seven", view.GetValue(&schema, 1).ToString());
+    EXPECT_FALSE(view.AsTuple().IsAllocated());
+
+    // a copy of the view outlives the guard
+    tuple = view.ToTuple();
+    EXPECT_TRUE(tuple.IsAllocated());
+    EXPECT_FALSE(table->GetTupleView(guard, RID(rid.GetPageId(), rid.GetSlotNum() + 1), &view, transaction));
+  }
+  EXPECT_EQ("seven", tuple.GetValue(&schema, 1).ToString());
+
+  // moving a tuple hands over its data
+  Tuple moved(std::move(tuple));
+  EXPECT_EQ(7, moved.GetValue(&schema, 0).GetAs<int32_t>());
+  EXPECT_EQ(nullptr, tuple.GetData());  // NOLINT
+  tuple = std::move(moved);
+  EXPECT_EQ(rid, tuple.GetRid());
+  EXPECT_EQ(nullptr, moved.GetData());  // NOLINT
+
+  // a scan that cannot fetch a page aborts its transaction, instead of ending as if the table was done
+  std::vector<page_id_t> pinned;
+  page_id_t page_id;
+  while (buffer_pool_manager->NewPage(&page_id) != nullptr) {
+    pinned.push_back(page_id);
+  }
+  {
+    TableBatchIterator iter(table, transaction);
+    std::vector<TupleView> batch;
+    EXPECT_FALSE(iter.NextBatch(&batch));
+    EXPECT_EQ(TransactionState::ABORTED, transaction->GetState());
+  }
+  for (page_id_t pinned_page_id : pinned) {
+    buffer_pool_manager->UnpinPage(pinned_page_id, false);
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete table;
+  delete lock_manager;
+  delete buffer_pool_manager;
+  delete disk_manager;
+  delete transaction;
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, ZoneMapTest) {
+  Schema schema{{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 16}}};
+  auto *transaction = new Transaction(0);
+  auto *disk_manager = new DiskManager("test.db");
+  auto *buffer_pool_manager = new BufferPoolManager(50, disk_manager);
+  auto *lock_manager = new LockManager(TwoPLMode::REGULAR, DeadlockMode::PREVENTION);
+  auto *table = new TableHeap(buffer_pool_manager, lock_manager, nullptr, transaction);
+
+  // a tuple inserted before the map is created is summarized from its page
+  RID first_rid;
+  ASSERT_TRUE(table->InsertTuple(
+      Tuple({ValueFactory::GetIntegerValue(-1), ValueFactory::GetVarcharValue("first")}, &schema), &first_rid,
+      transaction));
+  table->CreateZoneMap(schema);
+  ZoneMap *zone_map = table->GetZoneMap();
+  ASSERT_NE(nullptr, zone_map);
+  EXPECT_TRUE(zone_map->IsSummarized(0));
+  EXPECT_FALSE(zone_map->IsSummarized(1));
+
+  // ascending values give every page its own range
+  std::vector<Tuple> tuples;
+  for (int i = 0; i < 1000; i++) {
+    tuples.emplace_back(std::vector<Value>{ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue("x")},
+                        &schema);
+  }
+  std::vector<RID> rids;
+  ASSERT_TRUE(table->BulkInsert(tuples, &rids, transaction));
+  std::vector<page_id_t> page_ids = zone_map->GetPageIds();
+  ASSERT_EQ(table->GetNumPages(), page_ids.size());
+  ASSERT_LT(2, page_ids.size());
+  ColumnSummary summary;
+  ASSERT_TRUE(zone_map->GetSummary(page_ids[0], 0, &summary));
+  EXPECT_TRUE(summary.has_values_);
+  EXPECT_EQ(-1, summary.min_.GetAs<int32_t>());
+  ASSERT_TRUE(zone_map->GetSummary(page_ids[1], 0, &summary));
+  int32_t second_min = summary.min_.GetAs<int32_t>();
+  int32_t second_max = summary.max_.GetAs<int32_t>();
+  EXPECT_LT(0, second_min);
+  EXPECT_LT(second_min, second_max);
+
+  // an update widens the summary of its page
+  RID second_page_rid;
+  for (const auto &rid : rids) {
+    if (rid.GetPageId() == page_ids[1]) {
+      second_page_rid = rid;
+      break;
+    }
+  }
+  Tuple updated({ValueFactory::GetIntegerValue(5000), ValueFactory::GetVarcharValue("x")}, &schema);
+  ASSERT_TRUE(table->UpdateTuple(updated, second_page_rid, transaction));
+  ASSERT_TRUE(zone_map->GetSummary(page_ids[1], 0, &summary));
+  EXPECT_EQ(second_min, summary.min_.GetAs<int32_t>());
+  EXPECT_EQ(5000, summary.max_.GetAs<int32_t>());
+
+  // deleting every tuple of a page resets its summary
+  for (const auto &rid : rids) {
+    if (rid.GetPageId() == page_ids[1]) {
+      table->ApplyDelete(rid, transaction);
+    }
+  }
+  EXPECT_EQ(0, zone_map->GetNumTuples(page_ids[1]));
+  ASSERT_TRUE(zone_map->GetSummary(page_ids[1], 0, &summary));
+  EXPECT_FALSE(summary.has_values_);
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete table;
+  delete lock_manager;
+  delete buffer_pool_manager;
+  delete disk_manager;
+  delete transaction;
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, UpdateColumnTest) {
+  Schema schema{{Column{"id", TypeId::INTEGER}, Column{"name", TypeId::VARCHAR, 16}, Column{"hits", TypeId::BIGINT},
+                 Column{"flag", TypeId::BOOLEAN}}};
+  auto *disk_manager = new DiskManager("test.db");
+  auto *buffer_pool_manager = new BufferPoolManager(50, disk_manager);
+  auto *lock_manager = new LockManager(TwoPLMode::REGULAR, DeadlockMode::PREVENTION);
+  auto *txn_mgr = new TransactionManager(lock_manager, nullptr);
+  Transaction *txn = txn_mgr->Begin();
+  auto *table = new TableHeap(buffer_pool_manager, lock_manager, nullptr, txn);
+  table->CreateZoneMap(schema);
+
+  std::vector<RID> rids;
+  for (int i = 0; i < 100; i++) {
+    Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue("name " + std::to_string(i)),
+                 ValueFactory::GetBigIntValue(0), ValueFactory::GetBooleanValue(false)},
+                &schema);
+    RID rid;
+    ASSERT_TRUE(table->InsertTuple(tuple, &rid, txn));
+    rids.push_back(rid);
+  }
+  txn_mgr->Commit(txn);
+  delete txn;
+
+  // bump the counters and set the flags, the other columns stay as they were
+  txn = txn_mgr->Begin();
+  for (int round = 1; round <= 3; round++) {
+    for (int i = 0; i < 100; i++) {
+      ASSERT_TRUE(table->UpdateColumn(schema, rids[i], 2, ValueFactory::GetBigIntValue(int64_t{round} * i), txn));
+    }
+  }
+  ASSERT_TRUE(table->UpdateColumn(schema, rids[7], 3, ValueFactory::GetBooleanValue(true), txn));
+  // varlen columns and values of another type are refused
+  EXPECT_FALSE(table->UpdateColumn(schema, rids[7], 1, ValueFactory::GetVarcharValue("renamed"), txn));
+  EXPECT_FALSE(table->UpdateColumn(schema, rids[7], 2, ValueFactory::GetIntegerValue(7), txn));
+  for (int i = 0; i < 100; i++) {
+    Tuple tuple;
+    ASSERT_TRUE(table->GetTuple(rids[i], &tuple, txn));
+    EXPECT_EQ(i, tuple.GetValue(&schema, 0).GetAs<int32_t>());
+    EXPECT_EQ("name " + std::to_string(i), tuple.GetValue(&schema, 1).ToString());
+    EXPECT_EQ(3 * i, tuple.GetValue(&schema, 2).GetAs<int64_t>());
+    EXPECT_EQ(i == 7, tuple.GetValue(&schema, 3).GetAs<bool>());
+  }
+
+  // the zone map covers the new values
+  ColumnSummary summary;
+  ASSERT_TRUE(table->GetZoneMap()->GetSummary(rids[99].GetPageId(), 2, &summary));
+  EXPECT_EQ(3 * 99, summary.max_.GetAs<int64_t>());
+  txn_mgr->Commit(txn);
+  delete txn;
+
+  // an abort restores the old values, undoing the updates of a column in reverse order
+  txn = txn_mgr->Begin();
+  for (int i = 0; i < 100; i++) {
+    ASSERT_TRUE(table->UpdateColumn(schema, rids[i], 2, ValueFactory::GetBigIntValue(-1), txn));
+    ASSERT_TRUE(table->UpdateColumn(schema, rids[i], 2, ValueFactory::GetBigIntValue(-2), txn));
+  }
+  txn_mgr->Abort(txn);
+  delete txn;
+  txn = txn_mgr->Begin();
+  for (int i = 0; i < 100; i++) {
+    Tuple tuple;
+    ASSERT_TRUE(table->GetTuple(rids[i], &tuple, txn));
+    EXPECT_EQ(3 * i, tuple.GetValue(&schema, 2).GetAs<int64_t>());
+  }
+  txn_mgr->Commit(txn);
+  delete txn;
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete table;
+  delete txn_mgr;
+  delete lock_manager;
+  delete buffer_pool_manager;
+  delete disk_manager;
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, OverflowTest) {
+  Schema schema{
+      {Column{"a", TypeId::INTEGER}, Column{"doc", TypeId::VARCHAR, 16}, Column{"note", TypeId::VARCHAR, 16}}};
+  auto *transaction = new Transaction(0);
+  auto *disk_manager = new DiskManager("test.db");
+  auto *buffer_pool_manager = new BufferPoolManager(50, disk_manager);
+  auto *lock_manager = new LockManager(TwoPLMode::REGULAR, DeadlockMode::PREVENTION);
+  auto *table = new TableHeap(buffer_pool_manager, lock_manager, nullptr, transaction);
+  table->EnableOverflow(schema);
+
+  // documents of a few pages each, and one that stays in its tuple
+  auto make_doc = [](int i, size_t size) {
+    std::string doc(size, ' ');
+    for (size_t j = 0; j < size; j++) {
+      doc[j] = static_cast<char>('a' + (i + j) % 26);
+    }
+    return doc;
+  };
+  auto make_tuple = [&schema](int i, const std::string &doc) {
+    return Tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(doc),
+                  ValueFactory::GetVarcharValue("note " + std::to_string(i))},
+                 &schema);
+  };
+  std::vector<std::string> docs{make_doc(0, 3 * PAGE_SIZE), make_doc(1, PAGE_SIZE / 2), make_doc(2, 100)};
+  std::vector<RID> rids;
+  for (size_t i = 0; i < docs.size(); i++) {
+    RID rid;
+    ASSERT_TRUE(table->InsertTuple(make_tuple(i, docs[i]), &rid, transaction));
+    rids.push_back(rid);
+  }
+
+  // large documents leave a pointer in the tuple, and are fetched when they are read
+  for (size_t i = 0; i < docs.size(); i++) {
+    Tuple tuple;
+    ASSERT_TRUE(table->GetTuple(rids[i], &tuple, transaction));
+    EXPECT_EQ(i < 2, tuple.GetVarlenReader(&schema, 1).IsOverflow());
+    EXPECT_FALSE(tuple.GetVarlenReader(&schema, 2).IsOverflow());
+    EXPECT_LE(tuple.GetLength(), OVERFLOW_TUPLE_THRESHOLD);
+    EXPECT_EQ(docs[i], tuple.GetValue(&schema, 1).ToString());
+    EXPECT_EQ("note " + std::to_string(i), tuple.GetValue(&schema, 2).ToString());
+    EXPECT_FALSE(tuple.IsNull(&schema, 1));
+  }
+
+  // a large document can be streamed in pieces, the value's terminating NUL included
+  {
+    Tuple tuple;
+    ASSERT_TRUE(table->GetTuple(rids[0], &tuple, transaction));
+    VarlenReader reader = tuple.GetVarlenReader(&schema, 1);
+    ASSERT_EQ(docs[0].size() + 1, reader.GetLength());
+    std::string streamed;
+    char piece[1000];
+    for (uint32_t n = reader.Read(piece, sizeof(piece)); n > 0; n = reader.Read(piece, sizeof(piece))) {
+      streamed.append(piece, n);
+    }
+    EXPECT_EQ(docs[0] + '\0', streamed);
+  }
+
+  // comparisons stream documents stored out of line, and agree with comparing the fetched values
+  {
+    ColumnValueExpression doc_column(0, 1, TypeId::VARCHAR);
+    ColumnValueExpression note_column(0, 2, TypeId::VARCHAR);
+    std::vector<ConstantValueExpression> constants;
+    for (const auto &str : {docs[0], docs[0].substr(0, 5000), docs[0] + "a", docs[1], std::string()}) {
+      constants.emplace_back(ValueFactory::GetVarcharValue(str));
+    }
+    std::vector<const AbstractExpression *> operands{&doc_column, &note_column};
+    for (const auto &constant : constants) {
+      operands.push_back(&constant);
+    }
+    auto compare_values = [](const Value &lhs, const Value &rhs, ComparisonType comp_type) {
+      switch (comp_type) {
+        case ComparisonType::Equal:
+          return lhs.CompareEquals(rhs);
+        case ComparisonType::NotEqual:
+          return lhs.CompareNotEquals(rhs);
+        case ComparisonType::LessThan:
+          return lhs.CompareLessThan(rhs);
+        case ComparisonType::LessThanOrEqual:
+          return lhs.CompareLessThanEquals(rhs);
+        case ComparisonType::GreaterThan:
+          return lhs.CompareGreaterThan(rhs);
+        default:
+          return lhs.CompareGreaterThanEquals(rhs);
+      }
+    };
+    for (const auto &rid : rids) {
+      Tuple tuple;
+      ASSERT_TRUE(table->GetTuple(rid, &tuple, transaction));
+      for (const auto *lhs : operands) {
+        for (const auto *rhs : operands) {
+          Value lhs_value = lhs->Evaluate(&tuple, &schema);
+          Value rhs_value = rhs->Evaluate(&tuple, &schema);
+          for (auto comp_type : {ComparisonType::Equal, ComparisonType::NotEqual, ComparisonType::LessThan,
+                                 ComparisonType::LessThanOrEqual, ComparisonType::GreaterThan,
+                                 ComparisonType::GreaterThanOrEqual}) {
+            ComparisonExpression comparison(lhs, rhs, comp_type);
+            EXPECT_EQ(compare_values(lhs_value, rhs_value, comp_type) == CmpBool::CmpTrue,
+                      comparison.Evaluate(&tuple, &schema).GetAs<bool>());
+          }
+        }
+      }
+    }
+  }
+
+  // scans read the documents through views of the pages
+  {
+    TableBatchIterator iter(table, transaction);
+    std::vector<TupleView> batch;
+    size_t count = 0;
+    while (iter.NextBatch(&batch)) {
+      for (const auto &view : batch) {
+        int i = view.GetValue(&schema, 0).GetAs<int32_t>();
+        EXPECT_EQ(docs[i], view.GetValue(&schema, 1).ToString());
+        EXPECT_EQ(docs[i], view.ToTuple().GetValue(&schema, 1).ToString());
+        count++;
+      }
+    }
+    EXPECT_EQ(docs.size(), count);
+  }
+
+  // a copy of a tuple gets chains of its own, so it outlives the original
+  Tuple original;
+  ASSERT_TRUE(table->GetTuple(rids[0], &original, transaction));
+  RID copy_rid;
+  ASSERT_TRUE(table->InsertTuple(original, &copy_rid, transaction));
+  table->ApplyDelete(rids[0], transaction);
+  Tuple copy;
+  ASSERT_TRUE(table->GetTuple(copy_rid, &copy, transaction));
+  EXPECT_EQ(docs[0], copy.GetValue(&schema, 1).ToString());
+
+  // bulk inserts move large documents out of line as well
+  std::vector<Tuple> tuples;
+  for (int i = 0; i < 10; i++) {
+    tuples.push_back(make_tuple(i, make_doc(i, PAGE_SIZE)));
+  }
+  std::vector<RID> bulk_rids;
+  ASSERT_TRUE(table->BulkInsert(tuples, &bulk_rids, transaction));
+  for (int i = 0; i < 10; i++) {
+    Tuple tuple;
+    ASSERT_TRUE(table->GetTuple(bulk_rids[i], &tuple, transaction));
+    EXPECT_EQ(make_doc(i, PAGE_SIZE), tuple.GetValue(&schema, 1).ToString());
+  }
+
+  // an aborted update puts the old document back with its chains, a committed one keeps the new document
+  auto *txn_mgr = new TransactionManager(lock_manager, nullptr);
+  Transaction *txn = txn_mgr->Begin();
+  ASSERT_TRUE(table->UpdateTuple(make_tuple(1, make_doc(7, 2 * PAGE_SIZE)), rids[1], txn));
+  ASSERT_TRUE(table->UpdateTuple(make_tuple(1, make_doc(8, 3 * PAGE_SIZE)), rids[1], txn));
+  txn_mgr->Abort(txn);
+  delete txn;
+  {
+    Tuple tuple;
+    ASSERT_TRUE(table->GetTuple(rids[1], &tuple, transaction));
+    EXPECT_EQ(docs[1], tuple.GetValue(&schema, 1).ToString());
+  }
+  txn = txn_mgr->Begin();
+  ASSERT_TRUE(table->UpdateTuple(make_tuple(1, make_doc(9, 2 * PAGE_SIZE)), rids[1], txn));
+  txn_mgr->Commit(txn);
+  delete txn;
+  {
+    Tuple tuple;
+    ASSERT_TRUE(table->GetTuple(rids[1], &tuple, transaction));
+    EXPECT_EQ(make_doc(9, 2 * PAGE_SIZE), tuple.GetValue(&schema, 1).ToString());
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete table;
+  delete txn_mgr;
+  delete lock_manager;
+  delete buffer_pool_manager;
+  delete disk_manager;
+  delete transaction;
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, DISABLED_InsertBenchmark) {
+  Schema schema{{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::INTEGER}}};
+  auto *transaction = new Transaction(0);
+  auto *disk_manager = new DiskManager("test.db");
+  auto *buffer_pool_manager = new BufferPoolManager(64, disk_manager);
+  auto *lock_manager = new LockManager(TwoPLMode::REGULAR, DeadlockMode::PREVENTION);
+  auto *table = new TableHeap(buffer_pool_manager, lock_manager, nullptr, transaction);
+
+  // with the free-space map every batch of inserts should take about as long as the first one
+  const int num_tuples = 1000000;
+  const int batch = 100000;
+  Tuple tuple({ValueFactory::GetIntegerValue(0), ValueFactory::GetIntegerValue(0)}, &schema);
+  RID rid;
+  for (int i = 0; i < num_tuples; i += batch) {
+    auto start = std::chrono::steady_clock::now();
+    for (int j = 0; j < batch; j++) {
+      ASSERT_TRUE(table->InsertTuple(tuple, &rid, transaction));
+    }
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "rows " << i << " - " << i + batch << ": " << us << " us (" << table->GetNumPages() << " pages)"
+              << std::endl;
+  }
+
+  // the same rows again, appended in bulk
+  std::vector<Tuple> tuples(batch, tuple);
+  std::vector<RID> rids;
+  for (int i = 0; i < num_tuples; i += batch) {
+    auto start = std::chrono::steady_clock::now();
+    rids.clear();
+    ASSERT_TRUE(table->BulkInsert(tuples, &rids, transaction));
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "bulk rows " << i << " - " << i + batch << ": " << us << " us (" << table->GetNumPages()
+              << " pages)" << std::endl;
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete table;
+  delete lock_manager;
+  delete buffer_pool_manager;
+  delete disk_manager;
+  delete transaction;
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, DISABLED_ScanBenchmark) {
+  Schema schema{{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::INTEGER}}};
+  auto *transaction = new Transaction(0);
+  auto *disk_manager = new DiskManager("test.db");
+  auto *buffer_pool_manager = new BufferPoolManager(64, disk_manager);
+  auto *lock_manager = new LockManager(TwoPLMode::REGULAR, DeadlockMode::PREVENTION);
+  auto *table = new TableHeap(buffer_pool_manager, lock_manager, nullptr, transaction);
+
+  const int num_tuples = 200000;
+  std::vector<Tuple> tuples;
+  for (int i = 0; i < num_tuples; i++) {
+    tuples.emplace_back(std::vector<Value>{ValueFactory::GetIntegerValue(i), ValueFactory::GetIntegerValue(i % 10)},
+                        &schema);
+  }
+  std::vector<RID> rids;
+  ASSERT_TRUE(table->BulkInsert(tuples, &rids, transaction));
+  // leave holes, which both scans have to skip
+  for (int i = 0; i < num_tuples; i += 7) {
+    table->ApplyDelete(rids[i], transaction);
+  }
+  const int64_t num_live = num_tuples - (num_tuples + 6) / 7;
+
+  auto tuples_per_sec = [](int64_t count, std::chrono::steady_clock::time_point start) {
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    return count * 1000000 / std::max<int64_t>(us, 1);
+  };
+
+  // a tuple at a time: every tuple fetches and latches its page again
+  auto start = std::chrono::steady_clock::now();
+  int64_t count = 0;
+  int64_t sum = 0;
+  for (auto iter = table->Begin(transaction); iter != table->End(); ++iter) {
+    sum += iter->GetValue(&schema, 0).GetAs<int32_t>();
+    count++;
+  }
+  EXPECT_EQ(num_live, count);
+  std::cout << "TableIterator: " << tuples_per_sec(count, start) << " tuples/sec" << std::endl;
+
+  // a page at a time: every page is fetched and latched once, its tuples are read in place
+  start = std::chrono::steady_clock::now();
+  int64_t batch_count = 0;
+  int64_t batch_sum = 0;
+  TableBatchIterator batch_iter(table, transaction);
+  std::vector<TupleView> batch;
+  while (batch_iter.NextBatch(&batch)) {
+    for (const auto &view : batch) {
+      batch_sum += view.GetValue(&schema, 0).GetAs<int32_t>();
+    }
+    batch_count += batch.size();
+  }
+  EXPECT_EQ(count, batch_count);
+  EXPECT_EQ(sum, batch_sum);
+  std::cout << "TableBatchIterator: " << tuples_per_sec(batch_count, start) << " tuples/sec" << std::endl;
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete table;
+  delete lock_manager;
+  delete buffer_pool_manager;
+  delete disk_manager;
+  delete transaction;
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, DISABLED_UpdateBenchmark) {
+  // UPDATE t SET hits = hits + 1, as whole tuple updates and as in-place column updates
+  Schema schema{{Column{"id", TypeId::INTEGER}, Column{"name", TypeId::VARCHAR, 32}, Column{"hits", TypeId::BIGINT},
+                 Column{"score", TypeId::DECIMAL}}};
+  auto *transaction = new Transaction(0);
+  auto *disk_manager = new DiskManager("test.db");
+  auto *buffer_pool_manager = new BufferPoolManager(1024, disk_manager);
+  auto *lock_manager = new LockManager(TwoPLMode::REGULAR, DeadlockMode::PREVENTION);
+  auto *table = new TableHeap(buffer_pool_manager, lock_manager, nullptr, transaction);
+
+  const int num_tuples = 20000;
+  std::vector<Tuple> tuples;
+  for (int i = 0; i < num_tuples; i++) {
+    tuples.emplace_back(std::vector<Value>{ValueFactory::GetIntegerValue(i),
+                                           ValueFactory::GetVarcharValue("user " + std::to_string(i)),
+                                           ValueFactory::GetBigIntValue(0), ValueFactory::GetDecimalValue(i * 0.5)},
+                        &schema);
+  }
+  std::vector<RID> rids;
+  ASSERT_TRUE(table->BulkInsert(tuples, &rids, transaction));
+
+  auto report = [](const char *name, int64_t count, std::chrono::steady_clock::time_point start) {
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << us << " us, " << count * 1000000 / std::max<int64_t>(us, 1) << " updates/sec"
+              << std::endl;
+  };
+  const int num_rounds = 5;
+
+  // whole tuple: read the tuple, rebuild it from its values, and write all of it back
+  auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < num_rounds; round++) {
+    for (const auto &rid : rids) {
+      Tuple old_tuple;
+      ASSERT_TRUE(table->GetTuple(rid, &old_tuple, transaction));
+      std::vector<Value> values;
+      for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+        values.push_back(old_tuple.GetValue(&schema, i));
+      }
+      values[2] = ValueFactory::GetBigIntValue(values[2].GetAs<int64_t>() + 1);
+      ASSERT_TRUE(table->UpdateTuple(Tuple(values, &schema), rid, transaction));
+    }
+    transaction->GetWriteSet()->clear();
+  }
+  report("UpdateTuple", int64_t{num_tuples} * num_rounds, start);
+
+  // in place: read the counter, and patch its bytes
+  start = std::chrono::steady_clock::now();
+  for (int round = 0; round < num_rounds; round++) {
+    for (const auto &rid : rids) {
+      Tuple old_tuple;
+      ASSERT_TRUE(table->GetTuple(rid, &old_tuple, transaction));
+      Value hits = ValueFactory::GetBigIntValue(old_tuple.GetValue(&schema, 2).GetAs<int64_t>() + 1);
+      ASSERT_TRUE(table->UpdateColumn(schema, rid, 2, hits, transaction));
+    }
+    transaction->GetWriteSet()->clear();
+  }
+  report("UpdateColumn", int64_t{num_tuples} * num_rounds, start);
+
+  Tuple tuple;
+  ASSERT_TRUE(table->GetTuple(rids.back(), &tuple, transaction));
+  EXPECT_EQ(2 * num_rounds, tuple.GetValue(&schema, 2).GetAs<int64_t>());
+  EXPECT_EQ("user " + std::to_string(num_tuples - 1), tuple.GetValue(&schema, 1).ToString());
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete table;
+  delete lock_manager;
+  delete buffer_pool_manager;
+  delete disk_manager;
+  delete transaction;
+}
+
+}  // namespace bustub
@@ -10,13 +10,20 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "common/exception.h"
 #include "gtest/gtest.h"
+#include "storage/table/tuple.h"
+#include "type/arena_pool.h"
 #include "type/value.h"
+#include "type/value_factory.h"
+#include "type/value_kernels.h"
 
 namespace bustub {
 //===--------------------------------------------------------------------===//
@@ -95,4 +102,157 @@ TEST(TypeTests, TemplateTest) {
   BPlusTreePage<Value, Value> node;
   node.GetInfo(val1, val2);
 }
+
+// NOLINTNEXTLINE
+TEST(TypeTests, ArenaPoolTest) {
+  ArenaPool pool(1024);
+  // allocations are aligned and carved out of a chunk until it is full
+  std::vector<char *> ptrs;
+  for (int i = 0; i < 100; i++) {
+    auto *ptr = static_cast<char *>(pool.Allocate(24));
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(ptr) % ArenaPool::ALIGNMENT);
+    memset(ptr, i, 24);
+    ptrs.push_back(ptr);
+  }
+  EXPECT_EQ(100U, pool.GetNumAllocations());
+  size_t num_chunks = pool.GetNumChunkAllocations();
+  EXPECT_LT(1U, num_chunks);
+  EXPECT_GT(100U, num_chunks);
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(i, ptrs[i][0]);
+    EXPECT_EQ(i, ptrs[i][23]);
+  }
+
+  // large allocations get a chunk of their own
+  pool.Allocate(4096);
+  EXPECT_EQ(num_chunks + 1, pool.GetNumChunkAllocations());
+
+  // after a reset the regular chunks are reused, so the heap is not touched again
+  pool.Reset();
+  EXPECT_EQ(ptrs[0], pool.Allocate(24));
+  for (int i = 1; i < 100; i++) {
+    EXPECT_EQ(ptrs[i], pool.Allocate(24));
+  }
+  EXPECT_EQ(num_chunks + 1, pool.GetNumChunkAllocations());
+
+  // values can keep their bytes in the pool, without owning them
+  Value value = ValueFactory::GetVarcharValue(std::string("in the pool"), &pool);
+  Value copy = value;
+  EXPECT_EQ("in the pool", copy.ToString());
+  EXPECT_EQ(value.GetData(), copy.GetData());
+  Value clone = ValueFactory::Clone(ValueFactory::GetVarcharValue(std::string("cloned")), &pool);
+  EXPECT_EQ("cloned", clone.ToString());
+
+  // so can tuples; moving one keeps it in the pool, while a copy owns its data and outlives a reset
+  Schema schema({Column("a", TypeId::INTEGER), Column("b", TypeId::VARCHAR, 32)});
+  Tuple tuple({ValueFactory::GetIntegerValue(7), ValueFactory::GetVarcharValue(std::string("a tuple in the pool"))},
+              &schema, &pool);
+  EXPECT_FALSE(tuple.IsAllocated());
+  Tuple copy_tuple = tuple;
+  Tuple assigned_tuple;
+  assigned_tuple = tuple;
+  Tuple moved_tuple = std::move(tuple);
+  EXPECT_FALSE(moved_tuple.IsAllocated());
+  EXPECT_TRUE(copy_tuple.IsAllocated());
+  EXPECT_TRUE(assigned_tuple.IsAllocated());
+  EXPECT_NE(moved_tuple.GetData(), copy_tuple.GetData());
+  pool.Reset();
+  memset(pool.Allocate(moved_tuple.GetLength()), 0, moved_tuple.GetLength());
+  for (const Tuple *owned : {&copy_tuple, &assigned_tuple}) {
+    EXPECT_EQ(7, owned->GetValue(&schema, 0).GetAs<int32_t>());
+    EXPECT_EQ("a tuple in the pool", owned->GetValue(&schema, 1).ToString());
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(TypeTests, VarcharStorageTest) {
+  // short strings are kept inside the value, so copies do not share their bytes
+  Value small = ValueFactory::GetVarcharValue(std::string("fifteen bytes!!"));
+  ASSERT_EQ(Value::INLINE_VARCHAR_SIZE, small.GetLength());
+  Value small_copy = small;
+  EXPECT_NE(small.GetData(), small_copy.GetData());
+  EXPECT_EQ("fifteen bytes!!", small_copy.ToString());
+  EXPECT_EQ(CmpBool::CmpTrue, small.CompareEquals(small_copy));
+
+  // longer strings are copied to the heap
+  Value large = ValueFactory::GetVarcharValue(std::string("sixteen bytes!!!"));
+  Value large_copy = large;
+  EXPECT_NE(large.GetData(), large_copy.GetData());
+  EXPECT_EQ("sixteen bytes!!!", large_copy.ToString());
+
+  // moves hand the bytes over and leave a null value behind
+  const char *data = large.GetData();
+  Value moved = std::move(large);
+  EXPECT_EQ(data, moved.GetData());
+  EXPECT_TRUE(large.IsNull());  // NOLINT
+  large_copy = std::move(moved);
+  EXPECT_EQ(data, large_copy.GetData());
+  small_copy = large_copy;
+  EXPECT_EQ("sixteen bytes!!!", small_copy.ToString());
+  large_copy = small;
+  EXPECT_EQ("fifteen bytes!!", large_copy.ToString());
+
+  // views point to the bytes of the value they were taken from
+  Value view = small.View();
+  EXPECT_EQ(small.GetData(), view.GetData());
+  Value view_copy = view;
+  EXPECT_EQ(small.GetData(), view_copy.GetData());
+  EXPECT_EQ(CmpBool::CmpTrue, view_copy.CompareEquals(small));
+
+  // serializing and deserializing goes through the inline bytes as well
+  char storage[sizeof(uint32_t) + Value::INLINE_VARCHAR_SIZE];
+  small.SerializeTo(storage);
+  EXPECT_EQ("fifteen bytes!!", Value::DeserializeFrom(storage, TypeId::VARCHAR).ToString());
+}
+
+// NOLINTNEXTLINE
+TEST(TypeTests, ValueKernelsTest) {
+  // the kernels agree with the Value methods, nulls included
+  std::vector<std::vector<Value>> values_of_types{
+      {ValueFactory::GetIntegerValue(-7), ValueFactory::GetIntegerValue(3), ValueFactory::GetIntegerValue(3),
+       ValueFactory::GetNullValueByType(TypeId::INTEGER)},
+      {ValueFactory::GetBigIntValue(-7), ValueFactory::GetBigIntValue(int64_t{1} << 20),
+       ValueFactory::GetNullValueByType(TypeId::BIGINT)},
+      {ValueFactory::GetDecimalValue(-0.5), ValueFactory::GetDecimalValue(2.25),
+       ValueFactory::GetNullValueByType(TypeId::DECIMAL)},
+      {ValueFactory::GetTimestampValue(1), ValueFactory::GetTimestampValue(1000),
+       ValueFactory::GetTimestampValue(BUSTUB_TIMESTAMP_NULL)}};
+  for (const auto &values : values_of_types) {
+    TypeId type_id = values[0].GetTypeId();
+    auto less = ValueKernels::GetCompareKernel<std::less<>>(type_id);
+    auto equal = ValueKernels::GetCompareKernel<std::equal_to<>>(type_id);
+    auto greater_equal = ValueKernels::GetCompareKernel<std::greater_equal<>>(type_id);
+    ASSERT_NE(nullptr, less);
+    for (const auto &left : values) {
+      for (const auto &right : values) {
+        EXPECT_EQ(left.CompareLessThan(right), less(left, right));
+        EXPECT_EQ(left.CompareEquals(right), equal(left, right));
+        EXPECT_EQ(left.CompareGreaterThanEquals(right), greater_equal(left, right));
+        if (type_id == TypeId::TIMESTAMP) {
+          continue;
+        }
+        Value sum = ValueKernels::GetAddKernel(type_id)(left, right);
+        Value difference = ValueKernels::GetSubtractKernel(type_id)(left, right);
+        Value product = ValueKernels::GetMultiplyKernel(type_id)(left, right);
+        EXPECT_EQ(type_id, sum.GetTypeId());
+        EXPECT_EQ(left.Add(right).IsNull(), sum.IsNull());
+        EXPECT_EQ(left.Subtract(right).IsNull(), difference.IsNull());
+        EXPECT_EQ(left.Multiply(right).IsNull(), product.IsNull());
+        if (!sum.IsNull()) {
+          EXPECT_EQ(CmpBool::CmpTrue, left.Add(right).CompareEquals(sum));
+          EXPECT_EQ(CmpBool::CmpTrue, left.Subtract(right).CompareEquals(difference));
+          EXPECT_EQ(CmpBool::CmpTrue, left.Multiply(right).CompareEquals(product));
+        }
+      }
+    }
+  }
+
+  // overflows are refused, and other types get no kernels
+  Value max = ValueFactory::GetIntegerValue(BUSTUB_INT32_MAX);
+  EXPECT_THROW(ValueKernels::GetAddKernel(TypeId::INTEGER)(max, max), Exception);
+  EXPECT_THROW(ValueKernels::GetMultiplyKernel(TypeId::INTEGER)(max, max), Exception);
+  EXPECT_EQ(nullptr, ValueKernels::GetCompareKernel<std::less<>>(TypeId::VARCHAR));
+  EXPECT_EQ(nullptr, ValueKernels::GetCompareKernel<std::less<>>(TypeId::SMALLINT));
+  EXPECT_EQ(nullptr, ValueKernels::GetAddKernel(TypeId::TIMESTAMP));
+}
 }  // namespace bustub